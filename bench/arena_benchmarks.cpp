@@ -0,0 +1,75 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/compile_fixtures.hpp>
+#include <sc2/node_arena.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <new>
+#include <string>
+
+namespace {
+  std::size_t heap_allocation_count{};
+} // namespace
+
+void *operator new(std::size_t const size)
+{
+  ++heap_allocation_count;
+  if (void * const pointer{ std::malloc(size) }) return pointer;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void * const pointer) noexcept { std::free(pointer); }
+
+void operator delete(void * const pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+TEST_CASE("node arena benchmarks")
+{
+  for (std::size_t const statement_count: { 100, 1000 }) {
+    std::string const program_text{ generateBenchmarkProgramText(statement_count
+    ) };
+    std::size_t const heap_allocations_before{ heap_allocation_count };
+    static_cast<void>(compileProgram(program_text, false));
+    std::size_t const heap_allocations_without_arena{
+      heap_allocation_count - heap_allocations_before
+    };
+    std::size_t arena_allocations{};
+    std::size_t heap_allocations_with_arena{};
+    {
+      SC2::NodeArena            arena{};
+      SC2::NodeArenaScope const arena_scope{ arena };
+      std::size_t const         heap_allocations_before{
+        heap_allocation_count
+      };
+      static_cast<void>(compileProgram(program_text, false));
+      heap_allocations_with_arena
+        = heap_allocation_count - heap_allocations_before;
+      arena_allocations = arena.getAllocationCount();
+    }
+    REQUIRE(heap_allocations_with_arena < heap_allocations_without_arena);
+    std::cout << std::format(
+      "{} statements: {} heap allocations without an arena, {} with one "
+      "(plus {} node allocations from the arena)\n",
+      statement_count,
+      heap_allocations_without_arena,
+      heap_allocations_with_arena,
+      arena_allocations
+    );
+    BENCHMARK(std::format("heap nodes, {} statements", statement_count))
+    {
+      static_cast<void>(compileProgram(program_text, false));
+    };
+    BENCHMARK(std::format("arena nodes, {} statements", statement_count))
+    {
+      SC2::NodeArena            arena{};
+      SC2::NodeArenaScope const arena_scope{ arena };
+      static_cast<void>(compileProgram(program_text, false));
+    };
+  }
+}
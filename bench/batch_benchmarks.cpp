@@ -0,0 +1,39 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/batch.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/thread_pool.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Throughput of compiling many files in one process as the pool grows, which
+// should scale close to linearly up to the number of cores.
+TEST_CASE("batch benchmarks")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_batch_benchmarks" };
+  std::filesystem::create_directories(directory);
+  std::vector<std::string> source_paths{};
+  for (std::size_t file{}; file < 64; ++file) {
+    auto const source_path{ directory / std::format("program{}.c", file) };
+    std::ofstream out{ source_path };
+    out << generateBenchmarkProgramText(200);
+    source_paths.push_back(source_path.string());
+  }
+  REQUIRE(SC2::compileBatch(source_paths).empty());
+
+  for (std::size_t thread_count{ 1 };
+       thread_count <= SC2::getDefaultThreadCount();
+       thread_count *= 2) {
+    BENCHMARK(std::format("64 files, {} threads", thread_count))
+    {
+      return SC2::compileBatch(source_paths, thread_count).size();
+    };
+  }
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,48 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/compilation_cache.hpp>
+#include <sc2/compilation_context.hpp>
+
+#include <filesystem>
+#include <string>
+
+// A cache hit costs hashing the preprocessed text and reading one file, which
+// should be far cheaper than running the pipeline it replaces.
+TEST_CASE("compilation cache benchmarks")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_compilation_cache_benchmarks" };
+  std::filesystem::remove_all(directory);
+  std::string const     program_text{ generateBenchmarkProgramText(2000) };
+  SC2::CompilationCache cache{ directory };
+
+  BENCHMARK("compile 2000 statements")
+  {
+    SC2::CompilationContext context{};
+    SC2::AssemblyBuffer     assembly_buffer{};
+    context.compile(program_text)->emitCode(assembly_buffer);
+    return assembly_buffer.getSize();
+  };
+
+  {
+    SC2::CompilationContext context{};
+    SC2::AssemblyBuffer     assembly_buffer{};
+    context.compile(program_text)->emitCode(assembly_buffer);
+    cache.store(cache.getKey(program_text), assembly_buffer.getText());
+  }
+
+  BENCHMARK("hash 2000 statements")
+  {
+    return cache.getKey(program_text);
+  };
+
+  BENCHMARK("cache hit for 2000 statements")
+  {
+    return cache.lookUp(cache.getKey(program_text))->size();
+  };
+
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,40 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/compile_server.hpp>
+#include <sc2/test_fixtures.hpp>
+
+#include <filesystem>
+#include <thread>
+
+// Round trips to a resident server, which pay for a connection and a copy of
+// the source each way instead of starting a process.
+TEST_CASE("compile server benchmarks")
+{
+  auto const socket_path{ std::filesystem::temp_directory_path()
+                          / "sc2_compile_server_benchmarks.sock" };
+  SC2::CompileServer server{ socket_path };
+  std::jthread       server_thread{ [&server] { server.run(); } };
+
+  BENCHMARK("round trip for a tiny program")
+  {
+    auto const result{ SC2::requestCompilation(
+      socket_path,
+      "-S",
+      "program.c",
+      basic_program_text
+    ) };
+    return result.output.size();
+  };
+
+  auto const program_text{ generateBenchmarkProgramText(2000) };
+  BENCHMARK("round trip for 2000 statements")
+  {
+    auto const result{
+      SC2::requestCompilation(socket_path, "-S", "program.c", program_text)
+    };
+    return result.output.size();
+  };
+
+  server.stop();
+}
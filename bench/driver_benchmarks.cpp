@@ -0,0 +1,52 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+
+// End-to-end latency of turning a .c file into an executable, through
+// compiler_driver.bash and through sc2 acting as its own driver.
+TEST_CASE("driver benchmarks")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_driver_benchmarks" };
+  std::filesystem::create_directories(directory);
+  auto const source_path{ directory / "program.c" };
+  auto const executable_path{ directory / "program" };
+  std::string const script_command{ std::format(
+    "SC2={} bash {} {}",
+    SC2_EXECUTABLE,
+    SC2_DRIVER_SCRIPT,
+    source_path.string()
+  ) };
+  std::string const driver_command{
+    std::format("{} {}", SC2_EXECUTABLE, source_path.string())
+  };
+
+  for (std::size_t const statement_count: { 10, 1000 }) {
+    {
+      std::ofstream out{ source_path };
+      out << generateBenchmarkProgramText(statement_count);
+    }
+    REQUIRE(std::system(script_command.c_str()) == 0);
+    int const script_result{ std::system(executable_path.c_str()) };
+    REQUIRE(std::system(driver_command.c_str()) == 0);
+    REQUIRE(std::system(executable_path.c_str()) == script_result);
+
+    BENCHMARK(std::format("compiler_driver.bash, {} statements", statement_count
+    ))
+    {
+      return std::system(script_command.c_str());
+    };
+    BENCHMARK(std::format("built-in driver, {} statements", statement_count))
+    {
+      return std::system(driver_command.c_str());
+    };
+  }
+  std::filesystem::remove_all(directory);
+}
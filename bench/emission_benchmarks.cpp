@@ -0,0 +1,46 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/compile_fixtures.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <string>
+
+TEST_CASE("assembly emission benchmarks")
+{
+  for (std::size_t const statement_count: { 1000, 10000 }) {
+    std::string const program_text{ generateBenchmarkProgramText(statement_count
+    ) };
+    auto const        assembly{ compileProgram(program_text) };
+
+    SC2::AssemblyBuffer assembly_buffer{};
+    constexpr int       repetitions{ 20 };
+    auto const          start{ std::chrono::steady_clock::now() };
+    for (int repetition{}; repetition < repetitions; ++repetition) {
+      assembly_buffer.clear();
+      assembly->emitCode(assembly_buffer);
+    }
+    std::chrono::duration<double> const elapsed{
+      std::chrono::steady_clock::now() - start
+    };
+    double const megabytes{ static_cast<double>(assembly_buffer.getSize())
+                            * repetitions / (1024.0 * 1024.0) };
+    std::cout << std::format(
+      "{} statements: {} bytes of assembly, emitted at {:.1f} MB/s\n",
+      statement_count,
+      assembly_buffer.getSize(),
+      megabytes / elapsed.count()
+    );
+    BENCHMARK(std::format("emission, {} statements", statement_count))
+    {
+      assembly_buffer.clear();
+      assembly->emitCode(assembly_buffer);
+      return assembly_buffer.getSize();
+    };
+  }
+}
@@ -0,0 +1,62 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/ast.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/flat_ast.hpp>
+#include <sc2/lexer.hpp>
+#include <sc2/node_arena.hpp>
+#include <sc2/parser.hpp>
+#include <sc2/tacky_ast.hpp>
+
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+
+TEST_CASE("flat AST benchmarks")
+{
+  for (std::size_t const statement_count: { 100, 1000, 10000 }) {
+    std::string const program_text{ generateBenchmarkProgramText(statement_count
+    ) };
+    std::size_t tree_footprint{};
+    {
+      SC2::NodeArena            arena{};
+      SC2::NodeArenaScope const arena_scope{ arena };
+      SC2::Lexer                lexer{ program_text };
+      SC2::Parser               parser{ lexer };
+      std::ignore    = parser.parseProgram();
+      tree_footprint = arena.getAllocatedBytes();
+    }
+    SC2::Lexer                           lexer{ program_text };
+    SC2::Parser                          parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode> program{ parser.parseProgram() };
+    SC2::FlatAST                         flat_ast{ program->flatten() };
+    REQUIRE(flat_ast.getMemoryFootprint() < tree_footprint);
+    std::cout << std::format(
+      "{} statements: {} bytes of tree nodes, {} bytes of flat AST for {} "
+      "nodes\n",
+      statement_count,
+      tree_footprint,
+      flat_ast.getMemoryFootprint(),
+      flat_ast.getNodeCount()
+    );
+    BENCHMARK(std::format("tree lowering, {} statements", statement_count))
+    {
+      return program->emitTACKY();
+    };
+    BENCHMARK(std::format("flat lowering, {} statements", statement_count))
+    {
+      return flat_ast.emitTACKY();
+    };
+    BENCHMARK(std::format("tree printing, {} statements", statement_count))
+    {
+      return program->prettyPrint();
+    };
+    BENCHMARK(std::format("flat printing, {} statements", statement_count))
+    {
+      return flat_ast.prettyPrint();
+    };
+  }
+}
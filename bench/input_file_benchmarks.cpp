@@ -0,0 +1,73 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/process_fixtures.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <string>
+
+namespace {
+  // Runs sc2 --lex on the preprocessed file, or on its standard input fed
+  // the program text through a pipe, and returns the peak resident set size
+  // of the sc2 process in KiB, or nothing if it failed.
+  [[nodiscard]] std::optional<long> lexAndMeasurePeakResidentSetSize(
+    std::string const                    &path,
+    std::optional<std::string_view> const piped_program_text = std::nullopt
+  )
+  {
+    auto const measurement{ measureProcess(
+      SC2_EXECUTABLE_PATH,
+      { "--lex", piped_program_text ? "/dev/stdin" : path.c_str() },
+      piped_program_text
+    ) };
+    if (!measurement) return std::nullopt;
+    return measurement->usage.ru_maxrss;
+  }
+} // namespace
+
+// Reading preprocessed input from a mapped file and from a pipe: the time
+// sc2 --lex takes on each, and the peak memory each costs.
+TEST_CASE("input file benchmarks")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_input_file_benchmarks" };
+  std::filesystem::create_directories(directory);
+  std::string const path{ (directory / "program.i").string() };
+
+  for (std::size_t const statement_count: { 1000, 50000 }) {
+    std::string const program_text{ generateBenchmarkProgramText(statement_count
+    ) };
+    {
+      std::ofstream out{ path };
+      out << program_text;
+    }
+    auto const mapped_peak{ lexAndMeasurePeakResidentSetSize(path) };
+    auto const piped_peak{
+      lexAndMeasurePeakResidentSetSize(path, program_text)
+    };
+    REQUIRE(mapped_peak);
+    REQUIRE(piped_peak);
+    std::println(
+      "peak RSS of sc2 --lex on {} bytes: {} KiB mapped, {} KiB piped",
+      program_text.size(),
+      *mapped_peak,
+      *piped_peak
+    );
+
+    BENCHMARK(std::format("mapped file, {} statements", statement_count))
+    {
+      return lexAndMeasurePeakResidentSetSize(path);
+    };
+    BENCHMARK(std::format("pipe, {} statements", statement_count))
+    {
+      return lexAndMeasurePeakResidentSetSize(path, program_text);
+    };
+  }
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,58 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/compile_fixtures.hpp>
+#include <sc2/jit.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <string>
+
+// The test farm case: compile a small program only to learn its exit code.
+TEST_CASE("JIT benchmarks")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_jit_benchmarks" };
+  std::filesystem::create_directories(directory);
+  auto const assembly_path{ directory / "program.s" };
+  auto const executable_path{ directory / "program" };
+  std::string const command{ std::format(
+    "gcc -o {0} {1} && {0}",
+    executable_path.string(),
+    assembly_path.string()
+  ) };
+
+  for (std::size_t const statement_count: { 10, 100 }) {
+    std::string const program_text{ generateBenchmarkProgramText(statement_count
+    ) };
+    BENCHMARK(std::format(
+      "compiling, assembling, linking and running, {} statements",
+      statement_count
+    ))
+    {
+      SC2::AssemblyBuffer assembly_buffer{};
+      compileProgram(program_text)->emitCode(assembly_buffer);
+      assembly_buffer.writeToFile(assembly_path.string());
+      return std::system(command.c_str());
+    };
+    BENCHMARK(std::format(
+      "compiling and running in a child process, {} statements",
+      statement_count
+    ))
+    {
+      return SC2::runProgramInChildProcess(*compileProgram(program_text));
+    };
+    BENCHMARK(std::format(
+      "compiling and running in process, {} statements",
+      statement_count
+    ))
+    {
+      return SC2::runProgram(*compileProgram(program_text));
+    };
+  }
+  std::filesystem::remove_all(directory);
+}
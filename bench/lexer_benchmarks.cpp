@@ -0,0 +1,130 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/lexer.hpp>
+#include <string_view>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <regex>
+#include <string>
+
+namespace {
+  std::regex const whitespace_prefix_regex("\\s+", std::regex::optimize);
+
+  std::array<std::regex, 39> const token_regexes{
+    std::regex("[a-zA-Z_]\\w*\\b", std::regex::optimize),
+    std::regex("[0-9]+\\b", std::regex::optimize),
+    std::regex("\\(|\\)", std::regex::optimize),
+    std::regex("\\{|\\}", std::regex::optimize),
+    std::regex(";", std::regex::optimize),
+    std::regex("~", std::regex::optimize),
+    std::regex("-", std::regex::optimize),
+    std::regex("--", std::regex::optimize),
+    std::regex("\\+", std::regex::optimize),
+    std::regex("\\*", std::regex::optimize),
+    std::regex("/", std::regex::optimize),
+    std::regex("%", std::regex::optimize),
+    std::regex("&", std::regex::optimize),
+    std::regex("\\|", std::regex::optimize),
+    std::regex("\\^", std::regex::optimize),
+    std::regex("<<", std::regex::optimize),
+    std::regex(">>", std::regex::optimize),
+    std::regex("!", std::regex::optimize),
+    std::regex("&&", std::regex::optimize),
+    std::regex("\\|\\|", std::regex::optimize),
+    std::regex("==", std::regex::optimize),
+    std::regex("!=", std::regex::optimize),
+    std::regex("<", std::regex::optimize),
+    std::regex(">", std::regex::optimize),
+    std::regex("<=", std::regex::optimize),
+    std::regex(">=", std::regex::optimize),
+    std::regex("=", std::regex::optimize),
+    std::regex("\\+=", std::regex::optimize),
+    std::regex("-=", std::regex::optimize),
+    std::regex("\\*=", std::regex::optimize),
+    std::regex("/=", std::regex::optimize),
+    std::regex("%=", std::regex::optimize),
+    std::regex("&=", std::regex::optimize),
+    std::regex("\\|=", std::regex::optimize),
+    std::regex("\\^=", std::regex::optimize),
+    std::regex("<<=", std::regex::optimize),
+    std::regex(">>=", std::regex::optimize),
+    std::regex("\\+\\+", std::regex::optimize),
+    std::regex(",", std::regex::optimize)
+  };
+
+  [[nodiscard]] std::size_t
+  countTokensWithRegexes(std::string_view const program_text)
+  {
+    constexpr auto flags{ std::regex_constants::match_continuous };
+    char const    *cursor{ program_text.data() };
+    char const    *last{ program_text.data() + program_text.size() };
+    std::size_t    token_count{};
+    while (true) {
+      if (std::cmatch whitespace_match{}; std::regex_search(
+            cursor,
+            last,
+            whitespace_match,
+            whitespace_prefix_regex,
+            flags
+          ))
+        cursor += whitespace_match.length();
+      if (cursor == last) return token_count;
+      std::cmatch::difference_type largest_match_size{};
+      for (auto const &token_regex: token_regexes) {
+        if (std::cmatch token_match{};
+            std::regex_search(cursor, last, token_match, token_regex, flags))
+          largest_match_size
+            = std::max(largest_match_size, token_match.length());
+      }
+      if (largest_match_size < 1)
+        throw SC2::LexerInvalidTokenError(std::string_view(cursor, last));
+      cursor += largest_match_size;
+      ++token_count;
+    }
+  }
+
+  [[nodiscard]] std::size_t
+  countTokensWithLexer(std::string_view const program_text)
+  {
+    std::size_t token_count{};
+    for (SC2::Lexer lexer{ program_text }; lexer != lexer.end(); ++lexer)
+      ++token_count;
+    return token_count;
+  }
+} // namespace
+
+TEST_CASE("lexer benchmarks")
+{
+  for (std::size_t const statement_count: { 100, 1000 }) {
+    std::string const program_text{ generateBenchmarkProgramText(statement_count
+    ) };
+    REQUIRE(
+      countTokensWithLexer(program_text)
+      == countTokensWithRegexes(program_text)
+    );
+    BENCHMARK(std::format("scanner, {} statements", statement_count))
+    {
+      return countTokensWithLexer(program_text);
+    };
+    BENCHMARK(std::format("regexes, {} statements", statement_count))
+    {
+      return countTokensWithRegexes(program_text);
+    };
+  }
+  for (std::size_t const statement_count: { 10000, 50000 }) {
+    std::string const program_text{ generateBenchmarkProgramText(statement_count
+    ) };
+    BENCHMARK(std::format(
+      "scanner, {} statements ({} bytes)",
+      statement_count,
+      program_text.size()
+    ))
+    {
+      return countTokensWithLexer(program_text);
+    };
+  }
+}
@@ -0,0 +1,67 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/driver.hpp>
+#include <sc2/lexer.hpp>
+#include <sc2/preprocessor.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace {
+  [[nodiscard]] std::size_t countTokens(std::string const &program_text)
+  {
+    std::size_t token_count{};
+    for (SC2::Lexer lexer{ program_text }; lexer != lexer.end(); ++lexer)
+      ++token_count;
+    return token_count;
+  }
+} // namespace
+
+// Preprocessing a .c file that includes a guarded header of macros, in
+// process and through gcc -E.
+TEST_CASE("preprocessor benchmarks")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_preprocessor_benchmarks" };
+  std::filesystem::create_directories(directory);
+  auto const source_path{ directory / "program.c" };
+  {
+    std::ofstream out{ directory / "macros.h" };
+    out << "// Macros shared by the generated sources.\n"
+           "#ifndef MACROS_H\n"
+           "#define MACROS_H\n"
+           "#define SCALE(x) ((x) * 3)\n"
+           "#define MASK 255\n"
+           "#endif\n";
+  }
+
+  for (std::size_t const statement_count: { 10, 1000 }) {
+    {
+      std::ofstream out{ source_path };
+      out << "#include \"macros.h\"\n"
+             "#include \"macros.h\"\n"
+             "/* Generated. */\n"
+          << generateBenchmarkProgramText(statement_count)
+          << "int scaled(void) { return SCALE(MASK); }\n";
+    }
+    REQUIRE(
+      countTokens(SC2::Preprocessor{}.preprocessFile(source_path))
+      == countTokens(SC2::preprocess(source_path.string()))
+    );
+
+    BENCHMARK(std::format("built-in preprocessor, {} statements", statement_count
+    ))
+    {
+      return SC2::Preprocessor{}.preprocessFile(source_path);
+    };
+    BENCHMARK(std::format("gcc -E, {} statements", statement_count))
+    {
+      return SC2::preprocess(source_path.string());
+    };
+  }
+  std::filesystem::remove_all(directory);
+}
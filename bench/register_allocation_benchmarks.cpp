@@ -0,0 +1,97 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/compile_fixtures.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace {
+  constexpr std::size_t call_count{ 10000 };
+
+  // Calls the compiled function repeatedly so that the running time of the
+  // generated code outweighs that of starting the process.
+  constexpr std::string_view driver_format{
+    "int benchmark_function(void);\n"
+    "int main(void) {{\n"
+    "  int result = 0;\n"
+    "  for (int call = 0; call < {}; ++call)\n"
+    "    result ^= benchmark_function();\n"
+    "  return result & 255;\n"
+    "}}\n"
+  };
+
+
+  [[nodiscard]] std::filesystem::path build(
+    std::filesystem::path const &directory,
+    std::string_view const       program_text,
+    bool const                   allocate_registers
+  )
+  {
+    std::string const name{ allocate_registers ? "allocated" : "stack" };
+    auto const        assembly_path{ directory / (name + ".s") };
+    auto const        executable_path{ directory / name };
+    SC2::AssemblyBuffer assembly_buffer{};
+    compileProgram(program_text, allocate_registers)->emitCode(assembly_buffer);
+    assembly_buffer.writeToFile(assembly_path.string());
+    std::string const command{ std::format(
+      "gcc -o {} {} {}",
+      executable_path.string(),
+      assembly_path.string(),
+      (directory / "driver.c").string()
+    ) };
+    REQUIRE(std::system(command.c_str()) == 0);
+    return executable_path;
+  }
+} // namespace
+
+TEST_CASE("register allocation benchmarks")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_register_allocation_benchmarks" };
+  std::filesystem::create_directories(directory);
+  {
+    std::ofstream out{ directory / "driver.c" };
+    out << std::format(driver_format, call_count);
+  }
+  for (std::size_t const statement_count: { 100, 1000 }) {
+    std::string program_text{ generateBenchmarkProgramText(statement_count) };
+    program_text.replace(
+      0,
+      std::string_view{ "int main" }.size(),
+      "int benchmark_function"
+    );
+    BENCHMARK(std::format("allocation, {} statements", statement_count))
+    {
+      return compileProgram(program_text, true);
+    };
+    auto const stack_executable{ build(directory, program_text, false) };
+    auto const allocated_executable{ build(directory, program_text, true) };
+    REQUIRE(
+      std::system(stack_executable.c_str())
+      == std::system(allocated_executable.c_str())
+    );
+    BENCHMARK(std::format(
+      "generated code with stack slots, {} statements",
+      statement_count
+    ))
+    {
+      return std::system(stack_executable.c_str());
+    };
+    BENCHMARK(std::format(
+      "generated code with allocated registers, {} statements",
+      statement_count
+    ))
+    {
+      return std::system(allocated_executable.c_str());
+    };
+  }
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,86 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/assembly_ast.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/lexer.hpp>
+#include <sc2/parser.hpp>
+#include <sc2/tacky_ast.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+  std::size_t heap_allocation_count{};
+} // namespace
+
+void *operator new(std::size_t const size)
+{
+  ++heap_allocation_count;
+  if (void * const pointer{ std::malloc(size) }) return pointer;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void * const pointer) noexcept { std::free(pointer); }
+
+void operator delete(void * const pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+namespace {
+  [[nodiscard]] std::shared_ptr<SC2::ProgramAssemblyASTNode>
+  emitAssembly(std::string_view const program_text)
+  {
+    SC2::Lexer  lexer{ program_text };
+    SC2::Parser parser{ lexer };
+    return parser.parseProgram()->emitTACKY()->emitAssembly();
+  }
+} // namespace
+
+TEST_CASE("stack slot benchmarks")
+{
+  for (std::size_t const statement_count: { 100, 2500 }) {
+    std::string const program_text{ generateBenchmarkProgramText(statement_count
+    ) };
+    auto const        assembly{ emitAssembly(program_text) };
+    std::size_t const instruction_count{
+      std::as_const(*assembly->getFunction()).getInstructions().size()
+    };
+    std::size_t const heap_allocations_before{ heap_allocation_count };
+    auto const        last_offset{ assembly->replacePseudoRegisters() };
+    std::size_t const heap_allocations{
+      heap_allocation_count - heap_allocations_before
+    };
+    std::size_t const stack_slot_count{
+      static_cast<std::size_t>(-last_offset / 4)
+    };
+    // One node per stack slot, plus the regrowth of the slot table.
+    REQUIRE(heap_allocations <= stack_slot_count + 64);
+    std::cout << std::format(
+      "{} statements: {} instructions, {} stack slots, {} heap allocations\n",
+      statement_count,
+      instruction_count,
+      stack_slot_count,
+      heap_allocations
+    );
+    BENCHMARK_ADVANCED(
+      std::format("replacing pseudo-registers, {} statements", statement_count)
+    )(Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<std::shared_ptr<SC2::ProgramAssemblyASTNode>> assemblies{};
+      for (int run{}; run < meter.runs(); ++run)
+        assemblies.push_back(emitAssembly(program_text));
+      meter.measure([&assemblies](int const run) {
+        return assemblies[run]->replacePseudoRegisters();
+      });
+    };
+  }
+}
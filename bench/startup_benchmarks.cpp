@@ -0,0 +1,34 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/process_fixtures.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// Wall time of a whole sc2 process on a tiny file, from spawning it to
+// reaping it: dynamic loading, static initialisation and, in sanitized
+// builds, the sanitizer runtimes, with almost no compilation on top.
+TEST_CASE("startup benchmarks")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_startup_benchmarks" };
+  std::filesystem::create_directories(directory);
+  std::string const source_path{ (directory / "program.c").string() };
+  {
+    std::ofstream out{ source_path };
+    out << "int main(void){return 2;}\n";
+  }
+
+  BENCHMARK("sc2 --lex on int main(void){return 2;}")
+  {
+    return measureProcess(SC2_EXECUTABLE_PATH, { "--lex", source_path.c_str() });
+  };
+
+  BENCHMARK("sc2 -S on int main(void){return 2;}")
+  {
+    return measureProcess(SC2_EXECUTABLE_PATH, { "-S", source_path.c_str() });
+  };
+
+  std::filesystem::remove_all(directory);
+}
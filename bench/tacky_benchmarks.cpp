@@ -0,0 +1,45 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/ast.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/lexer.hpp>
+#include <sc2/parser.hpp>
+#include <sc2/tacky_ast.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+
+TEST_CASE("TACKY lowering benchmarks")
+{
+  for (std::size_t const statement_count: { 100, 1000, 10000 }) {
+    std::string const program_text{ generateBenchmarkProgramText(statement_count
+    ) };
+    SC2::Lexer                                 lexer{ program_text };
+    SC2::Parser                                parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode> const program{ parser.parseProgram() };
+
+    // Lowering is linear when the time per statement stays flat as the
+    // program grows.
+    constexpr int repetitions{ 5 };
+    auto const    start{ std::chrono::steady_clock::now() };
+    for (int repetition{}; repetition < repetitions; ++repetition)
+      std::ignore = program->emitTACKY();
+    std::chrono::duration<double, std::micro> const elapsed{
+      std::chrono::steady_clock::now() - start
+    };
+    std::cout << std::format(
+      "{} statements: lowered in {:.1f} us per statement\n",
+      statement_count,
+      elapsed.count() / static_cast<double>(repetitions * statement_count)
+    );
+    BENCHMARK(std::format("lowering, {} statements", statement_count))
+    {
+      return program->emitTACKY();
+    };
+  }
+}
@@ -2,6 +2,10 @@
 
 set -euo pipefail
 
+# sc2 can act as its own driver when given a .c file; this script is kept as
+# the baseline that driver is measured against.
+SC2="${SC2:-${HOME}/Documents/simple-c-compiler/g++-build/sc2}"
+
 function parse_file_name {
   if (( $# == 2 )); then
     echo "${2}"
@@ -12,7 +16,7 @@ function parse_file_name {
 
 function print_usage_message {
   >&2 echo "error: wrong number of arguments"
-  >&2 echo "  usage: compiler_driver.bash [-(-(lex|parse|codegen|tacky|validate)|S)] /path/to/program.c"
+  >&2 echo "  usage: compiler_driver.bash [-(-(lex|parse|codegen|tacky|validate|run|run-sandboxed)|S|c)] /path/to/program.c"
 }
 
 function exit_with_usage_message {
@@ -24,9 +28,10 @@ function parse_option {
   if (( $# == 1)); then
     echo ""
   else
-    while getopts ":-:S" OPTION; do
+    while getopts ":-:Sc" OPTION; do
       case "${OPTION}" in
 	S ) echo "S";;
+	c ) echo -c;;
 	- )
 	  case "${OPTARG}" in
 	    lex ) echo --lex;;
@@ -34,6 +39,8 @@ function parse_option {
 	    codegen ) echo --codegen;;
 	    tacky ) echo --tacky;;
 	    validate ) echo --validate;;
+	    run ) echo --run;;
+	    run-sandboxed ) echo --run-sandboxed;;
 	    * ) exit_with_usage_message;;
           esac
 	  ;;
@@ -55,11 +62,15 @@ function main {
   ASSEMBLY_FILE="${FILE_NAME_WITHOUT_EXTENSION}.s"
   gcc -E -P "${FILE_NAME}" -o "${PREPROCESSED_FILE}"
   if [ -n "${OPTION}" ]; then
-     "${HOME}/Documents/simple-c-compiler/g++-build/sc2" "${OPTION}" "${PREPROCESSED_FILE}";
+     "${SC2}" "${OPTION}" "${PREPROCESSED_FILE}";
   else
-     "${HOME}/Documents/simple-c-compiler/g++-build/sc2" "${PREPROCESSED_FILE}";
+     "${SC2}" "${PREPROCESSED_FILE}";
   fi
   EXIT_CODE="$?"
+  if [ "${OPTION}" == "-c" ]; then
+    rm "${PREPROCESSED_FILE}"
+    exit "${EXIT_CODE}"
+  fi
   if [ -n "${OPTION}" ]; then
     exit "${EXIT_CODE}"
   fi
@@ -1,19 +1,22 @@
 #ifndef SC2_ASSEMBLY_AST_HPP_INCLUDED
 #define SC2_ASSEMBLY_AST_HPP_INCLUDED
 
+#include <sc2/assembly_buffer.hpp>
 #include <sc2/ast.hpp>
 #include <sc2/compiler_error.hpp>
+#include <sc2/elf_object_writer.hpp>
+#include <sc2/machine_code_buffer.hpp>
 #include <sc2/pretty_printer_mixin.hpp>
 #include <sc2/utility.hpp>
+#include <sc2/virtual_register.hpp>
 #include <string_view>
-#include <unordered_map>
 
 #include <cstddef>
 #include <cstdint>
 #include <format>
-#include <iostream>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <ostream>
 #include <span>
 #include <stdexcept>
@@ -41,38 +44,77 @@ namespace SC2 {
     }
   };
 
-  struct ReplacePseudoRegistersInput
-  {
-    std::intptr_t                                  last_offset{};
-    std::unordered_map<std::string, std::intptr_t> identifier_to_offset_map{};
-  };
+  class StackSlotTable;
 
-  template <typename OutputNodeType> struct ReplacePseudoRegistersResult
+  // The general-purpose registers that the register allocator may assign to
+  // pseudo-registers. %r10d and %r11d are left out because fixUp() uses them
+  // as scratch registers, and the callee-saved registers are left out because
+  // functions do not save and restore them.
+  enum class HardRegister : std::uint8_t
   {
-    std::intptr_t                                  last_offset{};
-    std::unordered_map<std::string, std::intptr_t> identifier_to_offset_map{};
-    std::shared_ptr<OutputNodeType>                new_assembly_ast_node{};
+    EAX,
+    ECX,
+    EDX,
+    ESI,
+    EDI,
+    R8D,
+    R9D
   };
 
+  inline constexpr std::uint32_t hard_register_count{ 7 };
+
+  // The hard register chosen for each pseudo-register of a function, indexed
+  // by virtual register number. Pseudo-registers without one are left for
+  // replacePseudoRegisters() to spill to the stack.
+  using RegisterAssignment = std::vector<std::optional<HardRegister>>;
+
   struct AssemblyASTNode
     : public std::enable_shared_from_this<AssemblyASTNode>
     , public PrettyPrinterMixin
   {
-    virtual void emitCode(std::ostream &out) = 0;
+    virtual void emitCode(AssemblyBuffer &out) = 0;
     virtual ~AssemblyASTNode()               = default;
   };
 
   struct OperandAssemblyASTNode: public AssemblyASTNode
   {
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<OperandAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input)
+    // The node that stands for this operand in the interference graph of the
+    // register allocator, which numbers the hard registers first and the
+    // pseudo-registers after them. Operands the allocator does not track have
+    // none.
+    [[nodiscard]] virtual std::optional<std::uint32_t>
+    getRegisterNode() const noexcept
     {
-      auto [offset, map]{ std::move(input) };
-      return ReplacePseudoRegistersResult<OperandAssemblyASTNode>{
-        offset,
-        std::move(map),
-        std::dynamic_pointer_cast<OperandAssemblyASTNode>(shared_from_this())
-      };
+      return std::nullopt;
+    }
+
+    [[nodiscard]] virtual std::shared_ptr<OperandAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &)
+    {
+      return std::dynamic_pointer_cast<OperandAssemblyASTNode>(
+        shared_from_this()
+      );
+    }
+
+    [[nodiscard]] virtual std::shared_ptr<OperandAssemblyASTNode>
+    replacePseudoRegisters(StackSlotTable &)
+    {
+      return std::dynamic_pointer_cast<OperandAssemblyASTNode>(
+        shared_from_this()
+      );
+    }
+
+    [[nodiscard]] virtual std::optional<int> getImmediateValue() const noexcept
+    {
+      return std::nullopt;
+    }
+
+    // How a register or memory operand is encoded in machine code. Immediate
+    // values and pseudo-registers have no such encoding.
+    [[nodiscard]] virtual std::optional<ModRMOperand>
+    getModRMOperand() const noexcept
+    {
+      return std::nullopt;
     }
 
     virtual ~OperandAssemblyASTNode() override = default;
@@ -87,7 +129,13 @@ namespace SC2 {
     public:
     constexpr ImmediateValueAssemblyASTNode(int value): value{ value } {}
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    [[nodiscard]] virtual std::optional<int>
+    getImmediateValue() const noexcept final override
+    {
+      return getValue();
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "$" << getValue();
     }
@@ -111,18 +159,41 @@ namespace SC2 {
       out << "Register: ";
     }
 
-    virtual void emitRegister(std::ostream &out) = 0;
+    virtual void emitRegister(AssemblyBuffer &out) = 0;
 
     virtual void printRegister(std::ostream &out) = 0;
 
     public:
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept
+    {
+      return std::nullopt;
+    }
+
+    [[nodiscard]] virtual std::optional<std::uint32_t>
+    getRegisterNode() const noexcept final override
+    {
+      if (auto const hard_register{ getHardRegister() })
+        return std::to_underlying(*hard_register);
+      return std::nullopt;
+    }
+
+    // The number of the register in the ModRM byte and REX prefix.
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept = 0;
+
+    [[nodiscard]] virtual std::optional<ModRMOperand>
+    getModRMOperand() const noexcept override
+    {
+      return ModRMOperand{ getEncoding() };
+    }
+
     [[nodiscard]] virtual std::shared_ptr<ByteRegisterAssemblyASTNode>
     toByteRegister() = 0;
 
     [[nodiscard]] virtual std::shared_ptr<LongWordRegisterAssemblyASTNode>
     toLongWordRegister() = 0;
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "%";
       emitRegister(out);
@@ -153,6 +224,14 @@ namespace SC2 {
 
   struct ByteRegisterAssemblyASTNode: public RegisterAssemblyASTNode
   {
+    // Without a REX prefix, numbers 4 to 7 name %ah, %ch, %dh and %bh.
+    [[nodiscard]] virtual std::optional<ModRMOperand>
+    getModRMOperand() const noexcept final override
+    {
+      std::uint8_t const encoding{ getEncoding() };
+      return ModRMOperand{ encoding, false, 0, encoding >= 4 && encoding <= 7 };
+    }
+
     [[nodiscard]] virtual std::shared_ptr<ByteRegisterAssemblyASTNode>
     toByteRegister() final override
     {
@@ -167,7 +246,7 @@ namespace SC2 {
   class EAXRegisterAssemblyASTNode final: public LongWordRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "eax";
     }
@@ -178,6 +257,17 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 0;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::EAX;
+    }
+
     [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
     toByteRegister() final override;
 
@@ -187,7 +277,7 @@ namespace SC2 {
   class ALRegisterAssemblyASTNode final: public ByteRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "al";
     }
@@ -198,6 +288,17 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 0;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::EAX;
+    }
+
     [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
     toLongWordRegister() final override;
 
@@ -207,7 +308,7 @@ namespace SC2 {
   class EDXRegisterAssemblyASTNode final: public LongWordRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "edx";
     }
@@ -218,6 +319,17 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 2;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::EDX;
+    }
+
     [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
     toByteRegister() final override;
 
@@ -227,7 +339,7 @@ namespace SC2 {
   class DLRegisterAssemblyASTNode final: public ByteRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "dl";
     }
@@ -238,6 +350,17 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 2;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::EDX;
+    }
+
     [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
     toLongWordRegister() final override;
 
@@ -248,7 +371,7 @@ namespace SC2 {
     : public LongWordRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "r10d";
     }
@@ -259,6 +382,11 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 10;
+    }
+
     [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
     toByteRegister() final override;
 
@@ -268,7 +396,7 @@ namespace SC2 {
   class R10BRegisterAssemblyASTNode final: public ByteRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "r10b";
     }
@@ -279,6 +407,11 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 10;
+    }
+
     [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
     toLongWordRegister() final override;
 
@@ -289,7 +422,7 @@ namespace SC2 {
     : public LongWordRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "r11d";
     }
@@ -300,6 +433,11 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 11;
+    }
+
     [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
     toByteRegister() final override;
 
@@ -309,7 +447,7 @@ namespace SC2 {
   class R11BRegisterAssemblyASTNode final: public ByteRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "r11b";
     }
@@ -320,6 +458,11 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 11;
+    }
+
     [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
     toLongWordRegister() final override;
 
@@ -329,7 +472,7 @@ namespace SC2 {
   class ECXRegisterAssemblyASTNode final: public LongWordRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "ecx";
     }
@@ -340,6 +483,17 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 1;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::ECX;
+    }
+
     [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
     toByteRegister() final override;
 
@@ -349,7 +503,7 @@ namespace SC2 {
   class CLRegisterAssemblyASTNode final: public ByteRegisterAssemblyASTNode
   {
     protected:
-    virtual constexpr void emitRegister(std::ostream &out) final override
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
     {
       out << "cl";
     }
@@ -360,12 +514,274 @@ namespace SC2 {
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 1;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::ECX;
+    }
+
     [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
     toLongWordRegister() final override;
 
     virtual ~CLRegisterAssemblyASTNode() final override = default;
   };
 
+  class ESIRegisterAssemblyASTNode final: public LongWordRegisterAssemblyASTNode
+  {
+    protected:
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
+    {
+      out << "esi";
+    }
+
+    virtual constexpr void printRegister(std::ostream &out) final override
+    {
+      out << "%esi";
+    }
+
+    public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 6;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::ESI;
+    }
+
+    [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
+    toByteRegister() final override;
+
+    virtual ~ESIRegisterAssemblyASTNode() final override = default;
+  };
+
+  class SILRegisterAssemblyASTNode final: public ByteRegisterAssemblyASTNode
+  {
+    protected:
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
+    {
+      out << "sil";
+    }
+
+    virtual constexpr void printRegister(std::ostream &out) final override
+    {
+      out << "%sil";
+    }
+
+    public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 6;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::ESI;
+    }
+
+    [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+    toLongWordRegister() final override;
+
+    virtual ~SILRegisterAssemblyASTNode() final override = default;
+  };
+
+  class EDIRegisterAssemblyASTNode final: public LongWordRegisterAssemblyASTNode
+  {
+    protected:
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
+    {
+      out << "edi";
+    }
+
+    virtual constexpr void printRegister(std::ostream &out) final override
+    {
+      out << "%edi";
+    }
+
+    public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 7;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::EDI;
+    }
+
+    [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
+    toByteRegister() final override;
+
+    virtual ~EDIRegisterAssemblyASTNode() final override = default;
+  };
+
+  class DILRegisterAssemblyASTNode final: public ByteRegisterAssemblyASTNode
+  {
+    protected:
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
+    {
+      out << "dil";
+    }
+
+    virtual constexpr void printRegister(std::ostream &out) final override
+    {
+      out << "%dil";
+    }
+
+    public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 7;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::EDI;
+    }
+
+    [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+    toLongWordRegister() final override;
+
+    virtual ~DILRegisterAssemblyASTNode() final override = default;
+  };
+
+  class R8DRegisterAssemblyASTNode final: public LongWordRegisterAssemblyASTNode
+  {
+    protected:
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
+    {
+      out << "r8d";
+    }
+
+    virtual constexpr void printRegister(std::ostream &out) final override
+    {
+      out << "%r8d";
+    }
+
+    public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 8;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::R8D;
+    }
+
+    [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
+    toByteRegister() final override;
+
+    virtual ~R8DRegisterAssemblyASTNode() final override = default;
+  };
+
+  class R8BRegisterAssemblyASTNode final: public ByteRegisterAssemblyASTNode
+  {
+    protected:
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
+    {
+      out << "r8b";
+    }
+
+    virtual constexpr void printRegister(std::ostream &out) final override
+    {
+      out << "%r8b";
+    }
+
+    public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 8;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::R8D;
+    }
+
+    [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+    toLongWordRegister() final override;
+
+    virtual ~R8BRegisterAssemblyASTNode() final override = default;
+  };
+
+  class R9DRegisterAssemblyASTNode final: public LongWordRegisterAssemblyASTNode
+  {
+    protected:
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
+    {
+      out << "r9d";
+    }
+
+    virtual constexpr void printRegister(std::ostream &out) final override
+    {
+      out << "%r9d";
+    }
+
+    public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 9;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::R9D;
+    }
+
+    [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
+    toByteRegister() final override;
+
+    virtual ~R9DRegisterAssemblyASTNode() final override = default;
+  };
+
+  class R9BRegisterAssemblyASTNode final: public ByteRegisterAssemblyASTNode
+  {
+    protected:
+    virtual constexpr void emitRegister(AssemblyBuffer &out) final override
+    {
+      out << "r9b";
+    }
+
+    virtual constexpr void printRegister(std::ostream &out) final override
+    {
+      out << "%r9b";
+    }
+
+    public:
+    [[nodiscard]] virtual std::uint8_t getEncoding() const noexcept final override
+    {
+      return 9;
+    }
+
+    [[nodiscard]] virtual std::optional<HardRegister>
+    getHardRegister() const noexcept final override
+    {
+      return HardRegister::R9D;
+    }
+
+    [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+    toLongWordRegister() final override;
+
+    virtual ~R9BRegisterAssemblyASTNode() final override = default;
+  };
+
+  [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+  makeHardRegister(HardRegister hard_register);
+
   class StackOffsetAssemblyASTNode final: public OperandAssemblyASTNode
   {
     std::intptr_t const offset{};
@@ -380,55 +796,102 @@ namespace SC2 {
       : offset{ offset }
     {}
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    [[nodiscard]] virtual std::optional<ModRMOperand>
+    getModRMOperand() const noexcept final override
+    {
+      return ModRMOperand{ rbp_register_number,
+                           true,
+                           static_cast<std::int32_t>(getOffset()) };
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << getOffset() << "(%rbp)";
     }
 
-    virtual constexpr void
-    prettyPrintHelper(std::ostream &out, std::size_t) final override
+    virtual constexpr void
+    prettyPrintHelper(std::ostream &out, std::size_t) final override
+    {
+      out << "StackOffset: " << getOffset();
+    }
+
+    virtual ~StackOffsetAssemblyASTNode() final override = default;
+  };
+
+  // The stack slots of the spilled pseudo-registers of one function, indexed
+  // by virtual register number. Each slot node is made once and shared by
+  // every operand that refers to it.
+  class StackSlotTable
+  {
+    std::vector<std::shared_ptr<StackOffsetAssemblyASTNode>> slots{};
+    std::intptr_t                                            last_offset{};
+
+    public:
+    [[nodiscard]] std::shared_ptr<StackOffsetAssemblyASTNode>
+    getSlot(std::uint32_t const index)
+    {
+      if (index >= slots.size()) slots.resize(index + 1);
+      if (!slots[index]) {
+        last_offset  -= 4;
+        slots[index]  = makeNode<StackOffsetAssemblyASTNode>(last_offset);
+      }
+      return slots[index];
+    }
+
+    [[nodiscard]] constexpr std::intptr_t getLastOffset() const noexcept
     {
-      out << "StackOffset: " << getOffset();
+      return last_offset;
     }
-
-    virtual ~StackOffsetAssemblyASTNode() final override = default;
   };
 
   class PseudoRegisterAssemblyASTNode final: public OperandAssemblyASTNode
   {
-    std::string const identifier{};
+    VirtualRegister const virtual_register{};
 
-    [[nodiscard]] constexpr std::string_view getIdentifier() const noexcept
+    [[nodiscard]] constexpr VirtualRegister getVirtualRegister() const noexcept
     {
-      return identifier;
+      return virtual_register;
     }
 
-    [[nodiscard]] constexpr std::string toString() const
+    [[nodiscard]] std::string toString() const
     {
-      return std::format("PseudoRegister: {}", getIdentifier());
+      return std::format(
+        "PseudoRegister: {}",
+        getVirtualRegister().toString()
+      );
     }
 
     public:
-    explicit constexpr PseudoRegisterAssemblyASTNode(std::string_view identifier
+    explicit constexpr PseudoRegisterAssemblyASTNode(
+      VirtualRegister virtual_register
     )
-      : identifier{ identifier }
+      : virtual_register{ virtual_register }
     {}
 
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<OperandAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input) final override
+    [[nodiscard]] virtual std::optional<std::uint32_t>
+    getRegisterNode() const noexcept final override
     {
-      auto [offset, map]{ std::move(input) };
-      if (!map.contains(std::string{ getIdentifier() })) {
-        offset                              -= 4;
-        map[std::string{ getIdentifier() }]  = offset;
-      }
-      auto const &stack_offset{ map[std::string{ getIdentifier() }] };
-      return { offset,
-               std::move(map),
-               std::make_shared<StackOffsetAssemblyASTNode>(stack_offset) };
+      return hard_register_count + getVirtualRegister().index;
+    }
+
+    [[nodiscard]] virtual std::shared_ptr<OperandAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &assignment) final override
+    {
+      auto const index{ getVirtualRegister().index };
+      if (index < assignment.size() && assignment[index])
+        return makeHardRegister(*assignment[index]);
+      return std::dynamic_pointer_cast<OperandAssemblyASTNode>(
+        shared_from_this()
+      );
+    }
+
+    [[nodiscard]] virtual std::shared_ptr<OperandAssemblyASTNode>
+    replacePseudoRegisters(StackSlotTable &stack_slots) final override
+    {
+      return stack_slots.getSlot(getVirtualRegister().index);
     }
 
-    virtual void emitCode(std::ostream &) final override
+    virtual void emitCode(AssemblyBuffer &) final override
     {
       throw CodeEmissionError(toString());
     }
@@ -442,37 +905,79 @@ namespace SC2 {
     virtual ~PseudoRegisterAssemblyASTNode() final override = default;
   };
 
-  struct InstructionAssemblyASTNode: public AssemblyASTNode
+  // The register allocator nodes an instruction reads and writes, and how
+  // control leaves it.
+  struct InstructionDataFlow
   {
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<
-      InstructionAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input)
+    std::vector<std::uint32_t>   uses{};
+    std::vector<std::uint32_t>   definitions{};
+    std::optional<std::uint32_t> move_source{};
+    std::optional<std::string>   label{};
+    std::optional<std::string>   jump_target{};
+    bool                         falls_through{ true };
+
+    void use(std::shared_ptr<OperandAssemblyASTNode> const &operand)
     {
-      auto [offset, map]{ std::move(input) };
-      return ReplacePseudoRegistersResult<InstructionAssemblyASTNode>{
-        offset,
-        std::move(map),
-        std::dynamic_pointer_cast<InstructionAssemblyASTNode>(shared_from_this()
-        )
-      };
+      if (auto const node{ operand->getRegisterNode() }) uses.push_back(*node);
     }
 
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp()
+    void use(HardRegister hard_register)
+    {
+      uses.push_back(std::to_underlying(hard_register));
+    }
+
+    void define(std::shared_ptr<OperandAssemblyASTNode> const &operand)
+    {
+      if (auto const node{ operand->getRegisterNode() })
+        definitions.push_back(*node);
+    }
+
+    void define(HardRegister hard_register)
+    {
+      definitions.push_back(std::to_underlying(hard_register));
+    }
+  };
+
+  struct InstructionAssemblyASTNode: public AssemblyASTNode
+  {
+    virtual void describeDataFlow(InstructionDataFlow &) const {}
+
+    [[nodiscard]] virtual std::shared_ptr<InstructionAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &)
     {
-      return { std::dynamic_pointer_cast<InstructionAssemblyASTNode>(
+      return std::dynamic_pointer_cast<InstructionAssemblyASTNode>(
         shared_from_this()
-      ) };
+      );
+    }
+
+    // Whether the instruction has no effect once registers are assigned, such
+    // as a move of a register to itself.
+    [[nodiscard]] virtual bool isRedundant() const noexcept { return false; }
+
+    // Rewrites the pseudo-register operands of the instruction in place.
+    virtual void replacePseudoRegisters(StackSlotTable &) {}
+
+    // Appends the instruction to the legalized instruction list, preceded and
+    // followed by whatever scratch register moves make its operands legal.
+    virtual void
+    fixUp(std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions
+    )
+    {
+      instructions.push_back(
+        std::dynamic_pointer_cast<InstructionAssemblyASTNode>(shared_from_this())
+      );
     }
 
+    // Appends the machine code of the legalized instruction.
+    virtual void encode(MachineCodeBuffer &out) const = 0;
+
     virtual ~InstructionAssemblyASTNode() override = default;
   };
 
   class MovlAssemblyASTNode final: public InstructionAssemblyASTNode
   {
-    std::shared_ptr<OperandAssemblyASTNode> const source{};
-    std::shared_ptr<OperandAssemblyASTNode> const destination{};
+    std::shared_ptr<OperandAssemblyASTNode> source{};
+    std::shared_ptr<OperandAssemblyASTNode> destination{};
 
     [[nodiscard]] std::shared_ptr<OperandAssemblyASTNode> getSource() const
     {
@@ -493,55 +998,59 @@ namespace SC2 {
       , destination{ destination }
     {}
 
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<
-      InstructionAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
     {
-      auto [offset_zero, map_zero, new_source]{
-        getSource()->replacePseudoRegisters(std::move(input))
-      };
-      auto [offset_one, map_one, new_destination]{
-        getDestination()->replacePseudoRegisters({ offset_zero,
-                                                   std::move(map_zero) })
-      };
-      return { offset_one,
-               std::move(map_one),
-               std::make_shared<MovlAssemblyASTNode>(
-                 std::move(new_source),
-                 std::move(new_destination)
-               ) };
+      data_flow.use(getSource());
+      data_flow.define(getDestination());
+      if (getDestination()->getRegisterNode())
+        data_flow.move_source = getSource()->getRegisterNode();
     }
 
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp() override
+    [[nodiscard]] virtual std::shared_ptr<InstructionAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &assignment) final override
     {
-      auto const &stack_source{
-        std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(getSource())
-      };
-      auto const &stack_destination{
-        std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(getDestination())
-      };
-      if (stack_source && stack_destination) {
-        return {
-          std::make_shared<MovlAssemblyASTNode>(
-            getSource(),
-            std::make_shared<R10DRegisterAssemblyASTNode>()
-          ),
-          std::make_shared<MovlAssemblyASTNode>(
-            std::make_shared<R10DRegisterAssemblyASTNode>(),
+      return makeNode<MovlAssemblyASTNode>(
+        getSource()->assignRegisters(assignment),
+        getDestination()->assignRegisters(assignment)
+      );
+    }
+
+    [[nodiscard]] virtual bool isRedundant() const noexcept final override
+    {
+      auto const source_node{ getSource()->getRegisterNode() };
+      return source_node && source_node == getDestination()->getRegisterNode();
+    }
+
+    virtual void replacePseudoRegisters(StackSlotTable &stack_slots
+    ) final override
+    {
+      source      = source->replacePseudoRegisters(stack_slots);
+      destination = destination->replacePseudoRegisters(stack_slots);
+    }
+
+    virtual void
+    fixUp(std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions
+    ) final override
+    {
+      if (std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(getSource())
+          && std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(
             getDestination()
-          ),
-        };
-      } else
-        return { std::dynamic_pointer_cast<InstructionAssemblyASTNode>(
-          shared_from_this()
-        ) };
+          )) {
+        instructions.push_back(makeNode<MovlAssemblyASTNode>(
+          getSource(),
+          makeNode<R10DRegisterAssemblyASTNode>()
+        ));
+        source = makeNode<R10DRegisterAssemblyASTNode>();
+      }
+      InstructionAssemblyASTNode::fixUp(instructions);
     }
 
-    virtual void emitCode(std::ostream &out) final override
+    virtual void encode(MachineCodeBuffer &out) const final override;
+
+    virtual void emitCode(AssemblyBuffer &out) final override
     {
-      Utility::indent(out, 2);
+      out.indent(2);
       out << "movl ";
       getSource()->emitCode(out);
       out << ", ";
@@ -565,8 +1074,8 @@ namespace SC2 {
 
   class MovbAssemblyASTNode final: public InstructionAssemblyASTNode
   {
-    std::shared_ptr<OperandAssemblyASTNode> const source{};
-    std::shared_ptr<OperandAssemblyASTNode> const destination{};
+    std::shared_ptr<OperandAssemblyASTNode> source{};
+    std::shared_ptr<OperandAssemblyASTNode> destination{};
 
     [[nodiscard]] std::shared_ptr<OperandAssemblyASTNode> getSource() const
     {
@@ -587,55 +1096,51 @@ namespace SC2 {
       , destination{ destination }
     {}
 
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<
-      InstructionAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
     {
-      auto [offset_zero, map_zero, new_source]{
-        getSource()->replacePseudoRegisters(std::move(input))
-      };
-      auto [offset_one, map_one, new_destination]{
-        getDestination()->replacePseudoRegisters({ offset_zero,
-                                                   std::move(map_zero) })
-      };
-      return { offset_one,
-               std::move(map_one),
-               std::make_shared<MovbAssemblyASTNode>(
-                 std::move(new_source),
-                 std::move(new_destination)
-               ) };
+      data_flow.use(getSource());
+      data_flow.define(getDestination());
     }
 
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp() override
+    [[nodiscard]] virtual std::shared_ptr<InstructionAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &assignment) final override
     {
-      auto const &stack_source{
-        std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(getSource())
-      };
-      auto const &stack_destination{
-        std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(getDestination())
-      };
-      if (stack_source && stack_destination) {
-        return {
-          std::make_shared<MovbAssemblyASTNode>(
-            getSource(),
-            std::make_shared<R10DRegisterAssemblyASTNode>()
-          ),
-          std::make_shared<MovbAssemblyASTNode>(
-            std::make_shared<R10DRegisterAssemblyASTNode>(),
+      return makeNode<MovbAssemblyASTNode>(
+        getSource()->assignRegisters(assignment),
+        getDestination()->assignRegisters(assignment)
+      );
+    }
+
+    virtual void replacePseudoRegisters(StackSlotTable &stack_slots
+    ) final override
+    {
+      source      = source->replacePseudoRegisters(stack_slots);
+      destination = destination->replacePseudoRegisters(stack_slots);
+    }
+
+    virtual void
+    fixUp(std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions
+    ) final override
+    {
+      if (std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(getSource())
+          && std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(
             getDestination()
-          ),
-        };
-      } else
-        return { std::dynamic_pointer_cast<InstructionAssemblyASTNode>(
-          shared_from_this()
-        ) };
+          )) {
+        instructions.push_back(makeNode<MovbAssemblyASTNode>(
+          getSource(),
+          makeNode<R10BRegisterAssemblyASTNode>()
+        ));
+        source = makeNode<R10BRegisterAssemblyASTNode>();
+      }
+      InstructionAssemblyASTNode::fixUp(instructions);
     }
 
-    virtual void emitCode(std::ostream &out) final override
+    virtual void encode(MachineCodeBuffer &out) const final override;
+
+    virtual void emitCode(AssemblyBuffer &out) final override
     {
-      Utility::indent(out, 2);
+      out.indent(2);
       out << "movb ";
       getSource()->emitCode(out);
       out << ", ";
@@ -663,6 +1168,9 @@ namespace SC2 {
     virtual void printUnaryOperator(std::ostream &out) = 0;
 
     public:
+    // The opcode extension of the instruction in the reg field of ModRM.
+    [[nodiscard]] virtual std::uint8_t getOpcodeExtension() const noexcept = 0;
+
     constexpr virtual void
     prettyPrintHelper(std::ostream &out, std::size_t) final override
     {
@@ -680,12 +1188,18 @@ namespace SC2 {
       out << "Complement";
     }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "notl";
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t
+    getOpcodeExtension() const noexcept final override
+    {
+      return 2;
+    }
+
     virtual ~ComplementAssemblyASTNode() final override = default;
   };
 
@@ -697,19 +1211,25 @@ namespace SC2 {
       out << "Negate";
     }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "negl";
     }
 
     public:
+    [[nodiscard]] virtual std::uint8_t
+    getOpcodeExtension() const noexcept final override
+    {
+      return 3;
+    }
+
     virtual ~NegateAssemblyASTNode() final override = default;
   };
 
   class UnaryAssemblyASTNode final: public InstructionAssemblyASTNode
   {
     std::shared_ptr<UnaryOperatorAssemblyASTNode> const unary_operator{};
-    std::shared_ptr<OperandAssemblyASTNode> const       operand{};
+    std::shared_ptr<OperandAssemblyASTNode>             operand{};
 
     [[nodiscard]] std::shared_ptr<UnaryOperatorAssemblyASTNode>
     getUnaryOperator() const
@@ -731,22 +1251,31 @@ namespace SC2 {
       , operand{ operand }
     {}
 
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<
-      InstructionAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
     {
-      auto [new_offset, new_map, new_operand]{
-        getOperand()->replacePseudoRegisters(std::move(input))
-      };
-      return { new_offset,
-               std::move(new_map),
-               std::make_shared<UnaryAssemblyASTNode>(
-                 getUnaryOperator(),
-                 std::move(new_operand)
-               ) };
+      data_flow.use(getOperand());
+      data_flow.define(getOperand());
+    }
+
+    [[nodiscard]] virtual std::shared_ptr<InstructionAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &assignment) final override
+    {
+      return makeNode<UnaryAssemblyASTNode>(
+        getUnaryOperator(),
+        getOperand()->assignRegisters(assignment)
+      );
+    }
+
+    virtual void replacePseudoRegisters(StackSlotTable &stack_slots
+    ) final override
+    {
+      operand = operand->replacePseudoRegisters(stack_slots);
     }
 
-    virtual void emitCode(std::ostream &out) final override
+    virtual void encode(MachineCodeBuffer &out) const final override;
+
+    virtual void emitCode(AssemblyBuffer &out) final override
     {
       getUnaryOperator()->emitCode(out);
       out << ' ';
@@ -768,21 +1297,57 @@ namespace SC2 {
     virtual ~UnaryAssemblyASTNode() final override = default;
   };
 
+  // A binary instruction being legalized. Its operator may rewrite the
+  // operands in place before appending the instruction to the list.
   struct BinaryAssemblyASTNodeFixUpInput
   {
-    std::shared_ptr<OperandAssemblyASTNode> source{};
-    std::shared_ptr<OperandAssemblyASTNode> destination{};
+    std::shared_ptr<InstructionAssemblyASTNode>               instruction{};
+    std::shared_ptr<OperandAssemblyASTNode>                  &source;
+    std::shared_ptr<OperandAssemblyASTNode>                  &destination;
+    std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions;
   };
 
+  // Encodes one of add, or, and, sub, xor and cmp, whose opcodes differ only
+  // in the extension that selects the operation.
+  void encodeArithmeticInstruction(
+    MachineCodeBuffer            &out,
+    std::uint8_t                  opcode_extension,
+    OperandAssemblyASTNode const &source,
+    OperandAssemblyASTNode const &destination
+  );
+
+  // Encodes a shift by %cl or by an immediate count.
+  void encodeShiftInstruction(
+    MachineCodeBuffer            &out,
+    std::uint8_t                  opcode_extension,
+    OperandAssemblyASTNode const &source,
+    OperandAssemblyASTNode const &destination
+  );
+
   class BinaryOperatorAssemblyASTNode: public AssemblyASTNode
   {
     protected:
     virtual void printBinaryOperator(std::ostream &out) = 0;
 
     public:
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp(BinaryAssemblyASTNodeFixUpInput &&input);
+    virtual void describeDataFlow(
+      InstructionDataFlow                           &data_flow,
+      std::shared_ptr<OperandAssemblyASTNode> const &source,
+      std::shared_ptr<OperandAssemblyASTNode> const &destination
+    ) const
+    {
+      data_flow.use(source);
+      data_flow.use(destination);
+      data_flow.define(destination);
+    }
+
+    virtual void fixUp(BinaryAssemblyASTNodeFixUpInput const &input);
+
+    virtual void encode(
+      MachineCodeBuffer            &out,
+      OperandAssemblyASTNode const &source,
+      OperandAssemblyASTNode const &destination
+    ) const = 0;
 
     constexpr virtual void
     prettyPrintHelper(std::ostream &out, std::size_t) final override
@@ -802,11 +1367,20 @@ namespace SC2 {
     }
 
     public:
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "addl";
     }
 
+    virtual void encode(
+      MachineCodeBuffer            &out,
+      OperandAssemblyASTNode const &source,
+      OperandAssemblyASTNode const &destination
+    ) const final override
+    {
+      encodeArithmeticInstruction(out, 0, source, destination);
+    }
+
     virtual ~AddAssemblyASTNode() final override = default;
   };
 
@@ -819,11 +1393,20 @@ namespace SC2 {
     }
 
     public:
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "subl";
     }
 
+    virtual void encode(
+      MachineCodeBuffer            &out,
+      OperandAssemblyASTNode const &source,
+      OperandAssemblyASTNode const &destination
+    ) const final override
+    {
+      encodeArithmeticInstruction(out, 5, source, destination);
+    }
+
     virtual ~SubtractAssemblyASTNode() final override = default;
   };
 
@@ -836,15 +1419,20 @@ namespace SC2 {
     }
 
     public:
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp(BinaryAssemblyASTNodeFixUpInput &&input) final override;
+    virtual void fixUp(BinaryAssemblyASTNodeFixUpInput const &input
+    ) final override;
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "imull";
     }
 
+    virtual void encode(
+      MachineCodeBuffer            &out,
+      OperandAssemblyASTNode const &source,
+      OperandAssemblyASTNode const &destination
+    ) const final override;
+
     virtual ~MultiplyAssemblyASTNode() final override = default;
   };
 
@@ -856,12 +1444,21 @@ namespace SC2 {
       out << "BitwiseAnd";
     }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "andl";
     }
 
     public:
+    virtual void encode(
+      MachineCodeBuffer            &out,
+      OperandAssemblyASTNode const &source,
+      OperandAssemblyASTNode const &destination
+    ) const final override
+    {
+      encodeArithmeticInstruction(out, 4, source, destination);
+    }
+
     virtual ~BitwiseAndAssemblyASTNode() final override = default;
   };
 
@@ -873,12 +1470,21 @@ namespace SC2 {
       out << "BitwiseOr";
     }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "orl";
     }
 
     public:
+    virtual void encode(
+      MachineCodeBuffer            &out,
+      OperandAssemblyASTNode const &source,
+      OperandAssemblyASTNode const &destination
+    ) const final override
+    {
+      encodeArithmeticInstruction(out, 1, source, destination);
+    }
+
     virtual ~BitwiseOrAssemblyASTNode() final override = default;
   };
 
@@ -890,20 +1496,43 @@ namespace SC2 {
       out << "BitwiseXor";
     }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "xorl";
     }
 
     public:
+    virtual void encode(
+      MachineCodeBuffer            &out,
+      OperandAssemblyASTNode const &source,
+      OperandAssemblyASTNode const &destination
+    ) const final override
+    {
+      encodeArithmeticInstruction(out, 6, source, destination);
+    }
+
     virtual ~BitwiseXorAssemblyASTNode() final override = default;
   };
 
   struct ShiftOperatorAssemblyASTNode: public BinaryOperatorAssemblyASTNode
   {
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp(BinaryAssemblyASTNodeFixUpInput &&input) final override;
+    // fixUp() moves the shift count through %cl.
+    virtual void describeDataFlow(
+      InstructionDataFlow                           &data_flow,
+      std::shared_ptr<OperandAssemblyASTNode> const &source,
+      std::shared_ptr<OperandAssemblyASTNode> const &destination
+    ) const final override
+    {
+      BinaryOperatorAssemblyASTNode::describeDataFlow(
+        data_flow,
+        source,
+        destination
+      );
+      data_flow.define(HardRegister::ECX);
+    }
+
+    virtual void fixUp(BinaryAssemblyASTNodeFixUpInput const &input
+    ) final override;
 
     virtual ~ShiftOperatorAssemblyASTNode() override = default;
   };
@@ -916,12 +1545,21 @@ namespace SC2 {
       out << "LeftShift";
     }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "sall";
     }
 
     public:
+    virtual void encode(
+      MachineCodeBuffer            &out,
+      OperandAssemblyASTNode const &source,
+      OperandAssemblyASTNode const &destination
+    ) const final override
+    {
+      encodeShiftInstruction(out, 4, source, destination);
+    }
+
     virtual ~LeftShiftAssemblyASTNode() final override = default;
   };
 
@@ -933,20 +1571,29 @@ namespace SC2 {
       out << "RightShift";
     }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "sarl";
     }
 
     public:
+    virtual void encode(
+      MachineCodeBuffer            &out,
+      OperandAssemblyASTNode const &source,
+      OperandAssemblyASTNode const &destination
+    ) const final override
+    {
+      encodeShiftInstruction(out, 7, source, destination);
+    }
+
     virtual ~RightShiftAssemblyASTNode() final override = default;
   };
 
   class BinaryAssemblyASTNode final: public InstructionAssemblyASTNode
   {
     std::shared_ptr<BinaryOperatorAssemblyASTNode> const binary_operator{};
-    std::shared_ptr<OperandAssemblyASTNode> const        source{};
-    std::shared_ptr<OperandAssemblyASTNode> const        destination{};
+    std::shared_ptr<OperandAssemblyASTNode>              source{};
+    std::shared_ptr<OperandAssemblyASTNode>              destination{};
 
     [[nodiscard]] std::shared_ptr<BinaryOperatorAssemblyASTNode>
     getBinaryOperator() const
@@ -975,34 +1622,49 @@ namespace SC2 {
       , destination{ destination }
     {}
 
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<
-      InstructionAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
     {
-      auto [offset_zero, map_zero, new_source]{
-        getSource()->replacePseudoRegisters(std::move(input))
-      };
-      auto [offset_one, map_one, new_destination]{
-        getDestination()->replacePseudoRegisters({ offset_zero,
-                                                   std::move(map_zero) })
-      };
-      return { offset_one,
-               std::move(map_one),
-               std::make_shared<BinaryAssemblyASTNode>(
-                 getBinaryOperator(),
-                 std::move(new_source),
-                 std::move(new_destination)
-               ) };
+      getBinaryOperator()->describeDataFlow(
+        data_flow,
+        getSource(),
+        getDestination()
+      );
     }
 
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp() override
+    [[nodiscard]] virtual std::shared_ptr<InstructionAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &assignment) final override
+    {
+      return makeNode<BinaryAssemblyASTNode>(
+        getBinaryOperator(),
+        getSource()->assignRegisters(assignment),
+        getDestination()->assignRegisters(assignment)
+      );
+    }
+
+    virtual void replacePseudoRegisters(StackSlotTable &stack_slots
+    ) final override
+    {
+      source      = source->replacePseudoRegisters(stack_slots);
+      destination = destination->replacePseudoRegisters(stack_slots);
+    }
+
+    virtual void
+    fixUp(std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions
+    ) final override
     {
-      return getBinaryOperator()->fixUp({ getSource(), getDestination() });
+      getBinaryOperator()->fixUp({
+        std::dynamic_pointer_cast<InstructionAssemblyASTNode>(shared_from_this()
+        ),
+        source,
+        destination,
+        instructions,
+      });
     }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual void encode(MachineCodeBuffer &out) const final override;
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       getBinaryOperator()->emitCode(out);
       out << ' ';
@@ -1032,8 +1694,8 @@ namespace SC2 {
 
   class CmpAssemblyASTNode final: public InstructionAssemblyASTNode
   {
-    std::shared_ptr<OperandAssemblyASTNode> const left_operand{};
-    std::shared_ptr<OperandAssemblyASTNode> const right_operand{};
+    std::shared_ptr<OperandAssemblyASTNode> left_operand{};
+    std::shared_ptr<OperandAssemblyASTNode> right_operand{};
 
     [[nodiscard]] std::shared_ptr<OperandAssemblyASTNode> getLeftOperand() const
     {
@@ -1055,32 +1717,38 @@ namespace SC2 {
       , right_operand{ right_operand }
     {}
 
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<
-      InstructionAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
     {
-      auto [offset_zero, map_zero, new_left_operand]{
-        getLeftOperand()->replacePseudoRegisters(std::move(input))
-      };
-      auto [offset_one, map_one, new_right_operand]{
-        getRightOperand()->replacePseudoRegisters({ offset_zero,
-                                                    std::move(map_zero) })
-      };
-      return { offset_one,
-               std::move(map_one),
-               std::make_shared<CmpAssemblyASTNode>(
-                 std::move(new_left_operand),
-                 std::move(new_right_operand)
-               ) };
+      data_flow.use(getLeftOperand());
+      data_flow.use(getRightOperand());
     }
 
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp() final override;
+    [[nodiscard]] virtual std::shared_ptr<InstructionAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &assignment) final override
+    {
+      return makeNode<CmpAssemblyASTNode>(
+        getLeftOperand()->assignRegisters(assignment),
+        getRightOperand()->assignRegisters(assignment)
+      );
+    }
+
+    virtual void replacePseudoRegisters(StackSlotTable &stack_slots
+    ) final override
+    {
+      left_operand  = left_operand->replacePseudoRegisters(stack_slots);
+      right_operand = right_operand->replacePseudoRegisters(stack_slots);
+    }
+
+    virtual void
+    fixUp(std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions
+    ) final override;
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual void encode(MachineCodeBuffer &out) const final override;
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
-      Utility::indent(out, 2);
+      out.indent(2);
       out << "cmpl ";
       getLeftOperand()->emitCode(out);
       out << ", ";
@@ -1115,9 +1783,21 @@ namespace SC2 {
       : identifier{ identifier }
     {}
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
+    {
+      data_flow.jump_target   = std::string{ getIdentifier() };
+      data_flow.falls_through = false;
+    }
+
+    virtual void encode(MachineCodeBuffer &out) const final override
     {
-      Utility::indent(out, 2);
+      out.emitJump(getIdentifier(), std::nullopt);
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
+    {
+      out.indent(2);
       out << "jmp " << Utility::emitLocalLabelPrefix() << getIdentifier()
           << '\n';
     }
@@ -1135,11 +1815,21 @@ namespace SC2 {
   };
 
   struct CondCodeAssemblyASTNode: public AssemblyASTNode
-  {};
+  {
+    // The low nibble of the Jcc and SETcc opcodes.
+    [[nodiscard]] virtual std::uint8_t
+    getConditionCodeNumber() const noexcept = 0;
+  };
 
   struct ECondCodeAssemblyASTNode final: public CondCodeAssemblyASTNode
   {
-    virtual constexpr void emitCode(std::ostream &out) final override
+    [[nodiscard]] virtual std::uint8_t
+    getConditionCodeNumber() const noexcept final override
+    {
+      return 0x4;
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << 'e';
     }
@@ -1153,7 +1843,13 @@ namespace SC2 {
 
   struct NECondCodeAssemblyASTNode final: public CondCodeAssemblyASTNode
   {
-    virtual constexpr void emitCode(std::ostream &out) final override
+    [[nodiscard]] virtual std::uint8_t
+    getConditionCodeNumber() const noexcept final override
+    {
+      return 0x5;
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "ne";
     }
@@ -1167,7 +1863,13 @@ namespace SC2 {
 
   struct GCondCodeAssemblyASTNode final: public CondCodeAssemblyASTNode
   {
-    virtual constexpr void emitCode(std::ostream &out) final override
+    [[nodiscard]] virtual std::uint8_t
+    getConditionCodeNumber() const noexcept final override
+    {
+      return 0xF;
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << 'g';
     }
@@ -1181,7 +1883,13 @@ namespace SC2 {
 
   struct GECondCodeAssemblyASTNode final: public CondCodeAssemblyASTNode
   {
-    virtual constexpr void emitCode(std::ostream &out) final override
+    [[nodiscard]] virtual std::uint8_t
+    getConditionCodeNumber() const noexcept final override
+    {
+      return 0xD;
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "ge";
     }
@@ -1195,7 +1903,13 @@ namespace SC2 {
 
   struct LCondCodeAssemblyASTNode final: public CondCodeAssemblyASTNode
   {
-    virtual constexpr void emitCode(std::ostream &out) final override
+    [[nodiscard]] virtual std::uint8_t
+    getConditionCodeNumber() const noexcept final override
+    {
+      return 0xC;
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << 'l';
     }
@@ -1209,7 +1923,13 @@ namespace SC2 {
 
   struct LECondCodeAssemblyASTNode final: public CondCodeAssemblyASTNode
   {
-    virtual constexpr void emitCode(std::ostream &out) final override
+    [[nodiscard]] virtual std::uint8_t
+    getConditionCodeNumber() const noexcept final override
+    {
+      return 0xE;
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "le";
     }
@@ -1243,7 +1963,21 @@ namespace SC2 {
       , identifier{ identifier }
     {}
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
+    {
+      data_flow.jump_target = std::string{ getIdentifier() };
+    }
+
+    virtual void encode(MachineCodeBuffer &out) const final override
+    {
+      out.emitJump(
+        getIdentifier(),
+        getConditionCode()->getConditionCodeNumber()
+      );
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << 'j';
       getConditionCode()->emitCode(out);
@@ -1267,7 +2001,7 @@ namespace SC2 {
   class SetCCAssemblyASTNode final: public InstructionAssemblyASTNode
   {
     std::shared_ptr<CondCodeAssemblyASTNode> const condition_code{};
-    std::shared_ptr<OperandAssemblyASTNode> const  destination{};
+    std::shared_ptr<OperandAssemblyASTNode>        destination{};
 
     [[nodiscard]] std::shared_ptr<CondCodeAssemblyASTNode>
     getConditionCode() const
@@ -1289,26 +2023,35 @@ namespace SC2 {
       , destination{ destination }
     {}
 
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<
-      InstructionAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
     {
-      auto [offset_zero, map_zero, new_destination]{
-        getDestination()->replacePseudoRegisters(std::move(input))
-      };
-      return { offset_zero,
-               std::move(map_zero),
-               std::make_shared<SetCCAssemblyASTNode>(
-                 getConditionCode(),
-                 std::move(new_destination)
-               ) };
+      data_flow.use(getDestination());
+      data_flow.define(getDestination());
     }
 
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp() final override;
+    [[nodiscard]] virtual std::shared_ptr<InstructionAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &assignment) final override
+    {
+      return makeNode<SetCCAssemblyASTNode>(
+        getConditionCode(),
+        getDestination()->assignRegisters(assignment)
+      );
+    }
+
+    virtual void replacePseudoRegisters(StackSlotTable &stack_slots
+    ) final override
+    {
+      destination = destination->replacePseudoRegisters(stack_slots);
+    }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual void
+    fixUp(std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions
+    ) final override;
+
+    virtual void encode(MachineCodeBuffer &out) const final override;
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "set";
       getConditionCode()->emitCode(out);
@@ -1344,7 +2087,18 @@ namespace SC2 {
       : identifier{ identifier }
     {}
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
+    {
+      data_flow.label = std::string{ getIdentifier() };
+    }
+
+    virtual void encode(MachineCodeBuffer &out) const final override
+    {
+      out.defineLabel(getIdentifier());
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << Utility::emitLocalLabelPrefix() << getIdentifier() << ":\n";
     }
@@ -1373,7 +2127,9 @@ namespace SC2 {
       return size;
     }
 
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual void encode(MachineCodeBuffer &out) const final override;
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "subq $" << getSize() << ", %rsp\n";
     }
@@ -1392,7 +2148,19 @@ namespace SC2 {
 
   struct CdqAssemblyASTNode final: public InstructionAssemblyASTNode
   {
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
+    {
+      data_flow.use(HardRegister::EAX);
+      data_flow.define(HardRegister::EDX);
+    }
+
+    virtual void encode(MachineCodeBuffer &out) const final override
+    {
+      out.emitByte(0x99);
+    }
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "cdq\n";
     }
@@ -1411,7 +2179,7 @@ namespace SC2 {
 
   class IdivAssemblyASTNode final: public InstructionAssemblyASTNode
   {
-    std::shared_ptr<OperandAssemblyASTNode> const operand{};
+    std::shared_ptr<OperandAssemblyASTNode> operand{};
 
     [[nodiscard]] constexpr std::shared_ptr<OperandAssemblyASTNode>
     getOperand() const noexcept
@@ -1426,44 +2194,48 @@ namespace SC2 {
       : operand{ operand }
     {}
 
-    [[nodiscard]] virtual ReplacePseudoRegistersResult<
-      InstructionAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input)
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
     {
-      auto [offset, map, new_operand]{
-        getOperand()->replacePseudoRegisters(std::move(input))
-      };
-      return ReplacePseudoRegistersResult<InstructionAssemblyASTNode>{
-        offset,
-        std::move(map),
-        std::make_shared<IdivAssemblyASTNode>(std::move(new_operand))
-      };
+      data_flow.use(getOperand());
+      data_flow.use(HardRegister::EAX);
+      data_flow.use(HardRegister::EDX);
+      data_flow.define(HardRegister::EAX);
+      data_flow.define(HardRegister::EDX);
     }
 
-    [[nodiscard]] virtual std::vector<
-      std::shared_ptr<InstructionAssemblyASTNode>>
-    fixUp() final override
-    {
-      return std::dynamic_pointer_cast<ImmediateValueAssemblyASTNode>(
-               getOperand()
-             ) ?
-               std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-                 std::make_shared<MovlAssemblyASTNode>(
-                   getOperand(),
-                   std::make_shared<R10DRegisterAssemblyASTNode>()
-                 ),
-                 std::make_shared<IdivAssemblyASTNode>(
-                   std::make_shared<R10DRegisterAssemblyASTNode>()
-                 )
-               } :
-               std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-                 std::dynamic_pointer_cast<InstructionAssemblyASTNode>(
-                   shared_from_this()
-                 )
-               };
-    }
-
-    virtual constexpr void emitCode(std::ostream &out) final override
+    [[nodiscard]] virtual std::shared_ptr<InstructionAssemblyASTNode>
+    assignRegisters(RegisterAssignment const &assignment) final override
+    {
+      return makeNode<IdivAssemblyASTNode>(
+        getOperand()->assignRegisters(assignment)
+      );
+    }
+
+    virtual void replacePseudoRegisters(StackSlotTable &stack_slots
+    ) final override
+    {
+      operand = operand->replacePseudoRegisters(stack_slots);
+    }
+
+    virtual void
+    fixUp(std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions
+    ) final override
+    {
+      if (std::dynamic_pointer_cast<ImmediateValueAssemblyASTNode>(getOperand()
+          )) {
+        instructions.push_back(makeNode<MovlAssemblyASTNode>(
+          getOperand(),
+          makeNode<R10DRegisterAssemblyASTNode>()
+        ));
+        operand = makeNode<R10DRegisterAssemblyASTNode>();
+      }
+      InstructionAssemblyASTNode::fixUp(instructions);
+    }
+
+    virtual void encode(MachineCodeBuffer &out) const final override;
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "idivl ";
       getOperand()->emitCode(out);
@@ -1486,7 +2258,16 @@ namespace SC2 {
 
   struct ReturnAssemblyASTNode final: public InstructionAssemblyASTNode
   {
-    virtual constexpr void emitCode(std::ostream &out) final override
+    virtual void describeDataFlow(InstructionDataFlow &data_flow
+    ) const final override
+    {
+      data_flow.use(HardRegister::EAX);
+      data_flow.falls_through = false;
+    }
+
+    virtual void encode(MachineCodeBuffer &out) const final override;
+
+    virtual constexpr void emitCode(AssemblyBuffer &out) final override
     {
       out << "movq %rbp, %rsp\n"
              "popq %rbp\n"
@@ -1538,54 +2319,48 @@ namespace SC2 {
       return instructions;
     }
 
-    [[nodiscard]] ReplacePseudoRegistersResult<FunctionAssemblyASTNode>
-    replacePseudoRegisters(ReplacePseudoRegistersInput &&input)
+    // Assigns hard registers to as many pseudo-registers as possible, leaving
+    // the rest for replacePseudoRegisters() to spill.
+    [[nodiscard]] std::shared_ptr<FunctionAssemblyASTNode> allocateRegisters();
+
+    // Gives every remaining pseudo-register a stack slot, rewriting the
+    // instructions in place, and returns the offset of the lowest slot.
+    [[nodiscard]] std::intptr_t replacePseudoRegisters()
     {
-      std::vector<std::shared_ptr<InstructionAssemblyASTNode>>
-        new_instructions{};
-      auto [offset, map]{ std::move(input) };
-      for (auto &instruction: getInstructions()) {
-        auto [new_offset, new_map, new_instruction]{
-          instruction->replacePseudoRegisters({ offset, std::move(map) })
-        };
-        offset = new_offset;
-        map    = std::move(new_map);
-        new_instructions.push_back(new_instruction);
-      }
-      return { offset,
-               std::move(map),
-               std::make_shared<FunctionAssemblyASTNode>(
-                 getIdentifier(),
-                 std::move(new_instructions)
-               ) };
+      StackSlotTable stack_slots{};
+      for (auto const &instruction: getInstructions())
+        instruction->replacePseudoRegisters(stack_slots);
+      return stack_slots.getLastOffset();
     }
 
-    [[nodiscard]] std::shared_ptr<FunctionAssemblyASTNode>
-    fixUp(std::intptr_t size)
+    // Legalizes the instructions into a single list sized up front, so that
+    // only the instructions that need scratch registers allocate anything.
+    void fixUp(std::intptr_t size)
     {
-      std::vector<std::shared_ptr<InstructionAssemblyASTNode>> new_instructions{
-        std::make_shared<AllocateStackAssemblyASTNode>(size)
-      };
-      for (auto &instruction: getInstructions())
-        for (auto &new_instruction: instruction->fixUp())
-          new_instructions.push_back(new_instruction);
-      return std::make_shared<FunctionAssemblyASTNode>(
-        getIdentifier(),
-        new_instructions
+      std::vector<std::shared_ptr<InstructionAssemblyASTNode>>
+        fixed_instructions{};
+      fixed_instructions.reserve(instructions.size() + instructions.size() / 4
+                                 + 1);
+      fixed_instructions.push_back(makeNode<AllocateStackAssemblyASTNode>(size)
       );
+      for (auto const &instruction: instructions)
+        instruction->fixUp(fixed_instructions);
+      instructions = std::move(fixed_instructions);
     }
 
-    constexpr void emitCode(std::ostream &out) final override
+    void encode(MachineCodeBuffer &out) const;
+
+    constexpr void emitCode(AssemblyBuffer &out) final override
     {
-      Utility::indent(out, 2);
+      out.indent(2);
       std::string const specialised_function_name{
         Utility::specialiseFunctionNameForOS(getIdentifier())
       };
       out << ".globl " << specialised_function_name << '\n';
       out << specialised_function_name << ":\n";
-      Utility::indent(out, 2);
+      out.indent(2);
       out << "pushq %rbp\n";
-      Utility::indent(out, 2);
+      out.indent(2);
       out << "movq %rsp, %rbp\n";
       for (auto const &instruction: getInstructions()) {
         instruction->emitCode(out);
@@ -1610,10 +2385,15 @@ namespace SC2 {
   class ProgramAssemblyASTNode final: public AssemblyASTNode
   {
     std::shared_ptr<FunctionAssemblyASTNode> function{};
+    std::shared_ptr<StringInterner const>    string_interner{};
 
     public:
-    ProgramAssemblyASTNode(std::shared_ptr<FunctionAssemblyASTNode> function)
+    ProgramAssemblyASTNode(
+      std::shared_ptr<FunctionAssemblyASTNode> function,
+      std::shared_ptr<StringInterner const>    string_interner
+    )
       : function{ function }
+      , string_interner{ std::move(string_interner) }
     {}
 
     [[nodiscard]] std::shared_ptr<FunctionAssemblyASTNode> getFunction() const
@@ -1621,27 +2401,24 @@ namespace SC2 {
       return function;
     }
 
-    [[nodiscard]] ReplacePseudoRegistersResult<ProgramAssemblyASTNode>
-    replacePseudoRegisters()
+    [[nodiscard]] std::shared_ptr<ProgramAssemblyASTNode> allocateRegisters()
     {
-      auto [offset, map, new_function]{ getFunction()->replacePseudoRegisters({
-        0,
-        {},
-      }) };
-      return { offset,
-               std::move(map),
-               std::make_shared<ProgramAssemblyASTNode>(std::move(new_function)
-               ) };
+      return makeNode<ProgramAssemblyASTNode>(
+        getFunction()->allocateRegisters(),
+        string_interner
+      );
     }
 
-    [[nodiscard]] std::shared_ptr<ProgramAssemblyASTNode>
-    fixUp(std::intptr_t size)
+    [[nodiscard]] std::intptr_t replacePseudoRegisters()
     {
-      return std::make_shared<ProgramAssemblyASTNode>(getFunction()->fixUp(size)
-      );
+      return getFunction()->replacePseudoRegisters();
     }
 
-    virtual void emitCode(std::ostream &out) final override
+    void fixUp(std::intptr_t size) { getFunction()->fixUp(size); }
+
+    void encode(ElfObjectWriter &out) const;
+
+    virtual void emitCode(AssemblyBuffer &out) final override
     {
       getFunction()->emitCode(out);
       Utility::emitAssemblyEpilogue(out);
@@ -0,0 +1,63 @@
+#ifndef SC2_ASSEMBLY_BUFFER_HPP_INCLUDED
+#define SC2_ASSEMBLY_BUFFER_HPP_INCLUDED
+
+#include <string_view>
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <string>
+
+namespace SC2 {
+  // Assembly text formatted straight into one contiguous buffer, which is
+  // written out with a single write(2) once the whole program is emitted.
+  class AssemblyBuffer
+  {
+    static constexpr std::size_t initial_capacity{ 64 * 1024 };
+
+    std::string text{};
+
+    public:
+    AssemblyBuffer() { text.reserve(initial_capacity); }
+
+    AssemblyBuffer &operator<<(std::string_view const fragment)
+    {
+      text.append(fragment);
+      return *this;
+    }
+
+    AssemblyBuffer &operator<<(char const character)
+    {
+      text.push_back(character);
+      return *this;
+    }
+
+    template <std::integral Integer>
+      requires(!std::same_as<Integer, char> && !std::same_as<Integer, bool>)
+    AssemblyBuffer &operator<<(Integer const value)
+    {
+      std::array<char, 24> digits{};
+      auto const [end, _]{
+        std::to_chars(digits.data(), digits.data() + digits.size(), value)
+      };
+      text.append(digits.data(), end);
+      return *this;
+    }
+
+    void indent(std::size_t const indent_level)
+    {
+      text.append(indent_level, ' ');
+    }
+
+    [[nodiscard]] std::string_view getText() const noexcept { return text; }
+
+    [[nodiscard]] std::size_t getSize() const noexcept { return text.size(); }
+
+    void clear() noexcept { text.clear(); }
+
+    void writeToFile(std::string const &path) const;
+  };
+} // namespace SC2
+
+#endif
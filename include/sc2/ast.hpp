@@ -1,16 +1,22 @@
 #ifndef SC2_AST_HPP_INCLUDED
 #define SC2_AST_HPP_INCLUDED
 
+#include <sc2/flat_ast.hpp>
+#include <sc2/node_arena.hpp>
 #include <sc2/pretty_printer_mixin.hpp>
+#include <sc2/string_interner.hpp>
 #include <sc2/utility.hpp>
 #include <string_view>
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <format>
 #include <memory>
 #include <ostream>
 #include <span>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -26,6 +32,7 @@ namespace SC2 {
   {
     [[nodiscard]] virtual std::string toString() const = 0;
     [[nodiscard]] bool                operator==(TypeASTNode const &) const;
+    [[nodiscard]] virtual std::uint32_t flatten(FlatAST &) const = 0;
     virtual ~TypeASTNode() override = default;
   };
 
@@ -42,6 +49,12 @@ namespace SC2 {
       out << toString();
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &flat_ast) const final override
+    {
+      return flat_ast.appendNode(FlatASTNodeKind::IntType);
+    }
+
     virtual ~IntTypeASTNode() final override = default;
   };
 
@@ -58,38 +71,92 @@ namespace SC2 {
       out << toString();
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &flat_ast) const final override
+    {
+      return flat_ast.appendNode(FlatASTNodeKind::VoidType);
+    }
+
     virtual ~VoidTypeASTNode() final override = default;
   };
 
   struct InstructionTACKYASTNode;
-  struct ExpressionASTNodeEmitTACKYInput
-  {
-    std::string                                           identifier{};
+  class VariableTACKYASTNode;
+  // Collects the TACKY instructions of a single function as its AST is
+  // lowered, so that nodes append to one vector instead of threading it
+  // through every call. The sink also numbers the function's variables and
+  // temporaries as dense virtual registers, so no names are built or hashed
+  // for them while lowering. Variable names are views of interned spellings,
+  // so each name has exactly one address and the sink keys them on it. Labels
+  // still need names, since the assembly refers to them symbolically, but each
+  // is formatted exactly once.
+  class TACKYInstructionSink
+  {
+    std::string_view const                                identifier{};
     std::vector<std::shared_ptr<InstructionTACKYASTNode>> instructions{};
+    std::unordered_map<char const *, std::uint32_t>       variables{};
+    std::uint32_t                                         register_count{};
+    std::uint32_t                                         label_count{};
+
+    public:
+    explicit TACKYInstructionSink(std::string_view identifier)
+      : identifier{ identifier }
+    {}
+
+    [[nodiscard]] constexpr std::string_view getIdentifier() const noexcept
+    {
+      return identifier;
+    }
+
+    [[nodiscard]] std::shared_ptr<VariableTACKYASTNode> makeTemporary();
+
+    [[nodiscard]] std::shared_ptr<VariableTACKYASTNode>
+    getVariable(std::string_view name);
+
+    [[nodiscard]] std::string generateFreshLabel()
+    {
+      return std::format("{}.{}", getIdentifier(), label_count++);
+    }
+
+    [[nodiscard]] std::string generateFreshLabel(std::string_view const suffix)
+    {
+      return std::format("{}.{}_{}", getIdentifier(), label_count++, suffix);
+    }
+
+    [[nodiscard]] constexpr std::uint32_t getRegisterCount() const noexcept
+    {
+      return register_count;
+    }
+
+    void append(std::shared_ptr<InstructionTACKYASTNode> instruction)
+    {
+      instructions.push_back(std::move(instruction));
+    }
+
+    [[nodiscard]] std::vector<std::shared_ptr<InstructionTACKYASTNode>>
+    takeInstructions() && noexcept
+    {
+      return std::move(instructions);
+    }
   };
 
   struct ExpressionASTNode;
   struct BinaryOperatorASTNodeEmitTACKYInput
   {
-    std::string                                           identifier{};
-    std::shared_ptr<ExpressionASTNode>                    left_operand{};
-    std::shared_ptr<ExpressionASTNode>                    right_operand{};
-    std::vector<std::shared_ptr<InstructionTACKYASTNode>> instructions{};
+    TACKYInstructionSink              &sink;
+    std::shared_ptr<ExpressionASTNode> left_operand{};
+    std::shared_ptr<ExpressionASTNode> right_operand{};
   };
 
   struct ValueTACKYASTNode;
-  struct ExpressionASTNodeEmitTACKYOutput
-  {
-    std::shared_ptr<ValueTACKYASTNode>                    output_value{};
-    std::vector<std::shared_ptr<InstructionTACKYASTNode>> instructions{};
-  };
-
   struct ExpressionASTNode: public ASTNode
   {
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
-    emitTACKY(ExpressionASTNodeEmitTACKYInput &&) const
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
+    emitTACKY(TACKYInstructionSink &) const
       = 0;
 
+    [[nodiscard]] virtual std::uint32_t flatten(FlatAST &) const = 0;
+
     virtual ~ExpressionASTNode() override = default;
   };
 
@@ -102,8 +169,8 @@ namespace SC2 {
     public:
     explicit constexpr LiteralConstantASTNode(int value): value{ value } {}
 
-    [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
-    emitTACKY(ExpressionASTNodeEmitTACKYInput &&) const final override;
+    [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
+    emitTACKY(TACKYInstructionSink &) const final override;
 
     virtual constexpr void
     prettyPrintHelper(std::ostream &out, std::size_t) final override
@@ -111,12 +178,24 @@ namespace SC2 {
       out << getValue();
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &flat_ast) const final override
+    {
+      return flat_ast.appendNode(
+        FlatASTNodeKind::LiteralConstant,
+        FlatASTOperator::None,
+        flat_ast.addLiteralConstant(getValue())
+      );
+    }
+
     virtual ~LiteralConstantASTNode() final override = default;
   };
 
+  // Identifiers of functions, variables and declarations are views of names
+  // interned by the parser, which the enclosing ProgramASTNode keeps alive.
   class VariableASTNode final: public ExpressionASTNode
   {
-    std::string const identifier{};
+    std::string_view const identifier{};
 
     [[nodiscard]] constexpr std::string_view getIdentifier() const noexcept
     {
@@ -128,8 +207,8 @@ namespace SC2 {
       : identifier{ identifier }
     {}
 
-    [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
-    emitTACKY(ExpressionASTNodeEmitTACKYInput &&) const final override;
+    [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
+    emitTACKY(TACKYInstructionSink &) const final override;
 
     virtual constexpr void
     prettyPrintHelper(std::ostream &out, std::size_t) final override
@@ -137,6 +216,16 @@ namespace SC2 {
       out << getIdentifier();
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &flat_ast) const final override
+    {
+      return flat_ast.appendNode(
+        FlatASTNodeKind::Variable,
+        FlatASTOperator::None,
+        flat_ast.addIdentifier(getIdentifier())
+      );
+    }
+
     virtual ~VariableASTNode() final override = default;
   };
 
@@ -149,10 +238,8 @@ namespace SC2 {
 
   struct UnaryOperatorASTNodeEmitTACKYInput
   {
-    // TODO: consider making into string_view
-    std::string                                           identifier{};
-    std::shared_ptr<ExpressionASTNode>                    expression{};
-    std::vector<std::shared_ptr<InstructionTACKYASTNode>> instructions{};
+    TACKYInstructionSink              &sink;
+    std::shared_ptr<ExpressionASTNode> expression{};
   };
 
   class UnaryOperatorTACKYASTNode;
@@ -162,10 +249,13 @@ namespace SC2 {
     unaryOperatorPrettyPrintHelper(UnaryOperatorPrettyPrintHelperInput &&)
       = 0;
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&) const
       = 0;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept = 0;
+
     virtual ~UnaryOperatorASTNode() override = default;
   };
 
@@ -195,9 +285,15 @@ namespace SC2 {
       out << "~";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Complement;
+    }
+
     virtual ~ComplementASTNode() final override = default;
   };
 
@@ -209,9 +305,15 @@ namespace SC2 {
       out << "-";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Negate;
+    }
+
     virtual ~NegateASTNode() final override = default;
   };
 
@@ -224,9 +326,15 @@ namespace SC2 {
       out << "!";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Not;
+    }
+
     virtual ~NotASTNode() final override = default;
   };
 
@@ -238,7 +346,7 @@ namespace SC2 {
     emitBinaryOperatorTACKYASTNode() const = 0;
 
     public:
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
     virtual void
@@ -266,6 +374,12 @@ namespace SC2 {
       out << "++";
     }
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::PrefixIncrement;
+    }
+
     virtual ~PrefixIncrementASTNode() final override = default;
   };
 
@@ -282,6 +396,12 @@ namespace SC2 {
       out << "--";
     }
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::PrefixDecrement;
+    }
+
     virtual ~PrefixDecrementASTNode() final override = default;
   };
 
@@ -306,7 +426,7 @@ namespace SC2 {
     emitBinaryOperatorTACKYASTNode() const = 0;
 
     public:
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
     virtual ~PostfixAddSubtractASTNode() override = default;
@@ -325,6 +445,12 @@ namespace SC2 {
       out << "++";
     }
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::PostfixIncrement;
+    }
+
     virtual ~PostfixIncrementASTNode() final override = default;
   };
 
@@ -341,6 +467,12 @@ namespace SC2 {
       out << "--";
     }
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::PostfixDecrement;
+    }
+
     virtual ~PostfixDecrementASTNode() final override = default;
   };
 
@@ -368,13 +500,10 @@ namespace SC2 {
       , expression{ expression }
     {}
 
-    [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
-    emitTACKY(ExpressionASTNodeEmitTACKYInput &&input) const final override
+    [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
+    emitTACKY(TACKYInstructionSink &sink) const final override
     {
-      auto const &[identifier, instructions]{ std::move(input) };
-      return getUnaryOperator()->emitTACKY(
-        { identifier, getExpression(), std::move(instructions) }
-      );
+      return getUnaryOperator()->emitTACKY({ sink, getExpression() });
     }
 
     virtual void prettyPrintHelper(std::ostream &out, std::size_t indent_level)
@@ -385,15 +514,21 @@ namespace SC2 {
       );
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &) const final override;
+
     virtual ~UnaryExpressionASTNode() final override = default;
   };
 
   struct BinaryOperatorASTNode: public ASTNode
   {
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
       = 0;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept = 0;
+
     virtual ~BinaryOperatorASTNode() override = default;
   };
 
@@ -405,9 +540,15 @@ namespace SC2 {
       out << '+';
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Add;
+    }
+
     virtual ~AddASTNode() final override = default;
   };
 
@@ -419,9 +560,15 @@ namespace SC2 {
       out << '-';
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Subtract;
+    }
+
     virtual ~SubtractASTNode() final override = default;
   };
 
@@ -433,9 +580,15 @@ namespace SC2 {
       out << '*';
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Multiply;
+    }
+
     virtual ~MultiplyASTNode() final override = default;
   };
 
@@ -447,9 +600,15 @@ namespace SC2 {
       out << '/';
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Divide;
+    }
+
     virtual ~DivideASTNode() final override = default;
   };
 
@@ -461,9 +620,15 @@ namespace SC2 {
       out << '%';
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Modulo;
+    }
+
     virtual ~ModuloASTNode() final override = default;
   };
 
@@ -475,9 +640,15 @@ namespace SC2 {
       out << '&';
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::BitwiseAnd;
+    }
+
     virtual ~BitwiseAndASTNode() final override = default;
   };
 
@@ -489,9 +660,15 @@ namespace SC2 {
       out << '|';
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::BitwiseOr;
+    }
+
     virtual ~BitwiseOrASTNode() final override = default;
   };
 
@@ -503,9 +680,15 @@ namespace SC2 {
       out << '^';
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::BitwiseXor;
+    }
+
     virtual ~BitwiseXorASTNode() final override = default;
   };
 
@@ -517,9 +700,15 @@ namespace SC2 {
       out << "<<";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::LeftShift;
+    }
+
     virtual ~LeftShiftASTNode() final override = default;
   };
 
@@ -531,9 +720,15 @@ namespace SC2 {
       out << ">>";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::RightShift;
+    }
+
     virtual ~RightShiftASTNode() final override = default;
   };
 
@@ -545,9 +740,15 @@ namespace SC2 {
       out << "&&";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::And;
+    }
+
     virtual ~AndASTNode() final override = default;
   };
 
@@ -559,9 +760,15 @@ namespace SC2 {
       out << "||";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Or;
+    }
+
     virtual ~OrASTNode() final override = default;
   };
 
@@ -573,9 +780,15 @@ namespace SC2 {
       out << "==";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Equals;
+    }
+
     virtual ~EqualsASTNode() final override = default;
   };
 
@@ -587,9 +800,15 @@ namespace SC2 {
       out << "!=";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::NotEquals;
+    }
+
     virtual ~NotEqualsASTNode() final override = default;
   };
 
@@ -601,9 +820,15 @@ namespace SC2 {
       out << "<";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::LessThan;
+    }
+
     virtual ~LessThanASTNode() final override = default;
   };
 
@@ -615,9 +840,15 @@ namespace SC2 {
       out << ">";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::GreaterThan;
+    }
+
     virtual ~GreaterThanASTNode() final override = default;
   };
 
@@ -629,9 +860,15 @@ namespace SC2 {
       out << "<=";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::LessThanOrEqualTo;
+    }
+
     virtual ~LessThanOrEqualToASTNode() final override = default;
   };
 
@@ -643,27 +880,35 @@ namespace SC2 {
       out << ">=";
     }
 
-    virtual ExpressionASTNodeEmitTACKYOutput
+    virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&) const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::GreaterThanOrEqualTo;
+    }
+
     virtual ~GreaterThanOrEqualToASTNode() final override = default;
   };
 
   class AssignmentASTNode;
   struct BasicAssignmentOperatorASTNodeEmitTACKYInput
   {
-    std::string const                                     identifier{};
-    std::shared_ptr<VariableASTNode>                      variable{};
-    std::shared_ptr<ExpressionASTNode>                    expression{};
-    std::vector<std::shared_ptr<InstructionTACKYASTNode>> instructions{};
+    TACKYInstructionSink              &sink;
+    std::shared_ptr<VariableASTNode>   variable{};
+    std::shared_ptr<ExpressionASTNode> expression{};
   };
 
   struct BasicAssignmentOperatorASTNode: public ASTNode
   {
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&) const
       = 0;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept = 0;
+
     virtual ~BasicAssignmentOperatorASTNode() override = default;
   };
 
@@ -675,10 +920,16 @@ namespace SC2 {
       out << '=';
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::Assignment;
+    }
+
     virtual ~AssignmentOperatorASTNode() final override = default;
   };
 
@@ -691,10 +942,16 @@ namespace SC2 {
       out << "+=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::AddAssignment;
+    }
+
     virtual ~AddAssignmentOperatorASTNode() final override = default;
   };
 
@@ -707,10 +964,16 @@ namespace SC2 {
       out << "-=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::SubtractAssignment;
+    }
+
     virtual ~SubtractAssignmentOperatorASTNode() final override = default;
   };
 
@@ -723,10 +986,16 @@ namespace SC2 {
       out << "*=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::MultiplyAssignment;
+    }
+
     virtual ~MultiplyAssignmentOperatorASTNode() final override = default;
   };
 
@@ -739,10 +1008,16 @@ namespace SC2 {
       out << "/=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::DivideAssignment;
+    }
+
     virtual ~DivideAssignmentOperatorASTNode() final override = default;
   };
 
@@ -755,10 +1030,16 @@ namespace SC2 {
       out << "%=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::ModuloAssignment;
+    }
+
     virtual ~ModuloAssignmentOperatorASTNode() final override = default;
   };
 
@@ -771,10 +1052,16 @@ namespace SC2 {
       out << "&=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::BitwiseAndAssignment;
+    }
+
     virtual ~BitwiseAndAssignmentOperatorASTNode() final override = default;
   };
 
@@ -787,10 +1074,16 @@ namespace SC2 {
       out << "|=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::BitwiseOrAssignment;
+    }
+
     virtual ~BitwiseOrAssignmentOperatorASTNode() final override = default;
   };
 
@@ -803,10 +1096,16 @@ namespace SC2 {
       out << "^=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::BitwiseXorAssignment;
+    }
+
     virtual ~BitwiseXorAssignmentOperatorASTNode() final override = default;
   };
 
@@ -819,10 +1118,16 @@ namespace SC2 {
       out << "<<=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::LeftShiftAssignment;
+    }
+
     virtual ~LeftShiftAssignmentOperatorASTNode() final override = default;
   };
 
@@ -835,10 +1140,16 @@ namespace SC2 {
       out << ">>=";
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
     emitTACKY(BasicAssignmentOperatorASTNodeEmitTACKYInput &&)
       const final override;
 
+    [[nodiscard]] virtual FlatASTOperator
+    getFlatASTOperator() const noexcept final override
+    {
+      return FlatASTOperator::RightShiftAssignment;
+    }
+
     virtual ~RightShiftAssignmentOperatorASTNode() final override = default;
   };
 
@@ -887,18 +1198,17 @@ namespace SC2 {
       out << ')';
     }
 
-    [[nodiscard]] virtual ExpressionASTNodeEmitTACKYOutput
-    emitTACKY(ExpressionASTNodeEmitTACKYInput &&input) const
+    [[nodiscard]] virtual std::shared_ptr<ValueTACKYASTNode>
+    emitTACKY(TACKYInstructionSink &sink) const
     {
-      auto const &[identifier, instructions]{ std::move(input) };
       return getBasicAssignmentOperator()->emitTACKY(
-        BasicAssignmentOperatorASTNodeEmitTACKYInput{ identifier,
-                                                      variable,
-                                                      expression,
-                                                      std::move(instructions) }
+        { sink, getVariable(), getExpression() }
       );
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &) const final override;
+
     virtual ~AssignmentASTNode() final override = default;
   };
 
@@ -935,14 +1245,12 @@ namespace SC2 {
       , right_operand{ right_operand }
     {}
 
-    [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
-    emitTACKY(ExpressionASTNodeEmitTACKYInput &&input) const final override
+    [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
+    emitTACKY(TACKYInstructionSink &sink) const final override
     {
-      auto const &[identifier, instructions]{ std::move(input) };
-      return getBinaryOperator()->emitTACKY({ std::move(identifier),
-                                              std::move(getLeftOperand()),
-                                              std::move(getRightOperand()),
-                                              std::move(instructions) });
+      return getBinaryOperator()->emitTACKY(
+        { sink, getLeftOperand(), getRightOperand() }
+      );
     }
 
     virtual constexpr void prettyPrintHelper(
@@ -959,25 +1267,24 @@ namespace SC2 {
       out << ')';
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &) const final override;
+
     virtual ~BinaryExpressionASTNode() final override = default;
   };
 
   struct BlockItemASTNode: public ASTNode
   {
     BlockItemASTNode() = default;
-    [[nodiscard]] virtual std::vector<std::shared_ptr<InstructionTACKYASTNode>>
-    emitTACKY(std::string_view) const
-    {
-      return std::vector<std::shared_ptr<InstructionTACKYASTNode>>{};
-    }
+    virtual void emitTACKY(TACKYInstructionSink &) const {}
+    [[nodiscard]] virtual std::uint32_t flatten(FlatAST &) const = 0;
     virtual ~BlockItemASTNode() override = default;
   };
 
   struct StatementASTNode: public BlockItemASTNode
   {
     StatementASTNode() = default;
-    [[nodiscard]] virtual std::vector<std::shared_ptr<InstructionTACKYASTNode>>
-      emitTACKY(std::string_view) const  = 0;
+    virtual void emitTACKY(TACKYInstructionSink &) const = 0;
     virtual ~StatementASTNode() override = default;
   };
 
@@ -998,8 +1305,7 @@ namespace SC2 {
       : expression{ expression }
     {}
 
-    [[nodiscard]] virtual std::vector<std::shared_ptr<InstructionTACKYASTNode>>
-      emitTACKY(std::string_view) const final override;
+    virtual void emitTACKY(TACKYInstructionSink &) const final override;
 
     virtual void prettyPrintHelper(std::ostream &out, std::size_t indent_level)
       final override
@@ -1010,6 +1316,9 @@ namespace SC2 {
       out << ";\n";
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &) const final override;
+
     virtual ~ReturnStatementASTNode() final override = default;
   };
 
@@ -1030,8 +1339,7 @@ namespace SC2 {
       : expression{ expression }
     {}
 
-    [[nodiscard]] virtual std::vector<std::shared_ptr<InstructionTACKYASTNode>>
-      emitTACKY(std::string_view) const final override;
+    virtual void emitTACKY(TACKYInstructionSink &) const final override;
 
     virtual void prettyPrintHelper(std::ostream &out, std::size_t indent_level)
       final override
@@ -1041,16 +1349,21 @@ namespace SC2 {
       out << ";\n";
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &) const final override;
+
     virtual ~ExpressionStatementASTNode() final override = default;
   };
 
   class NullStatementASTNode final: public StatementASTNode
   {
     public:
-    [[nodiscard]] virtual std::vector<std::shared_ptr<InstructionTACKYASTNode>>
-    emitTACKY(std::string_view) const final override
+    virtual void emitTACKY(TACKYInstructionSink &) const final override {}
+
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &flat_ast) const final override
     {
-      return std::vector<std::shared_ptr<InstructionTACKYASTNode>>{};
+      return flat_ast.appendNode(FlatASTNodeKind::NullStatement);
     }
 
     virtual void prettyPrintHelper(std::ostream &out, std::size_t indent_level)
@@ -1066,7 +1379,7 @@ namespace SC2 {
   class DeclarationASTNode final: public BlockItemASTNode
   {
     std::shared_ptr<TypeASTNode>       type{};
-    std::string const                  identifier{};
+    std::string_view const             identifier{};
     std::shared_ptr<ExpressionASTNode> initializer{};
 
     [[nodiscard]] constexpr std::string_view getIdentifier() const
@@ -1090,8 +1403,7 @@ namespace SC2 {
       , initializer{ initializer }
     {}
 
-    [[nodiscard]] virtual std::vector<std::shared_ptr<InstructionTACKYASTNode>>
-      emitTACKY(std::string_view) const override;
+    virtual void emitTACKY(TACKYInstructionSink &) const override;
 
     virtual void prettyPrintHelper(std::ostream &out, std::size_t indent_level)
       final override
@@ -1106,13 +1418,16 @@ namespace SC2 {
       out << ";\n";
     }
 
+    [[nodiscard]] virtual std::uint32_t
+    flatten(FlatAST &) const final override;
+
     virtual ~DeclarationASTNode() final override = default;
   };
 
   class FunctionTACKYASTNode;
   class FunctionASTNode final: public ASTNode
   {
-    std::string const                              identifier{};
+    std::string_view const                         identifier{};
     std::vector<std::shared_ptr<BlockItemASTNode>> block_items{};
 
     [[nodiscard]] constexpr std::string_view getIdentifier() const noexcept
@@ -1137,6 +1452,9 @@ namespace SC2 {
 
     [[nodiscard]] std::shared_ptr<FunctionTACKYASTNode> emitTACKY();
 
+    [[nodiscard]] FlatAST
+    flatten(std::shared_ptr<StringInterner const> string_interner) const;
+
     virtual void prettyPrintHelper(std::ostream &out, std::size_t indent_level)
       final override
     {
@@ -1157,7 +1475,8 @@ namespace SC2 {
   class ProgramTACKYASTNode;
   class ProgramASTNode final: public ASTNode
   {
-    std::shared_ptr<FunctionASTNode> function{};
+    std::shared_ptr<FunctionASTNode>      function{};
+    std::shared_ptr<StringInterner const> string_interner{};
 
     [[nodiscard]] std::shared_ptr<FunctionASTNode> getFunction() const
     {
@@ -1165,12 +1484,18 @@ namespace SC2 {
     }
 
     public:
-    explicit ProgramASTNode(std::shared_ptr<FunctionASTNode> function)
+    ProgramASTNode(
+      std::shared_ptr<FunctionASTNode>      function,
+      std::shared_ptr<StringInterner const> string_interner
+    )
       : function{ function }
+      , string_interner{ std::move(string_interner) }
     {}
 
     [[nodiscard]] std::shared_ptr<ProgramTACKYASTNode> emitTACKY() const;
 
+    [[nodiscard]] FlatAST flatten() const;
+
     virtual void prettyPrintHelper(std::ostream &out, std::size_t indent_level)
       final override
     {
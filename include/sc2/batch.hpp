@@ -0,0 +1,36 @@
+#ifndef SC2_BATCH_HPP_INCLUDED
+#define SC2_BATCH_HPP_INCLUDED
+
+#include <sc2/compilation_cache.hpp>
+#include <sc2/thread_pool.hpp>
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SC2 {
+  struct BatchFailure
+  {
+    std::string source_path{};
+    std::string message{};
+  };
+
+  // Expands each @response-file argument into the whitespace-separated paths
+  // the file lists. Other arguments are kept as they are.
+  [[nodiscard]] std::vector<std::string>
+  expandResponseFiles(std::span<std::string const> arguments);
+
+  // Compiles each .c or preprocessed source file to a .s file next to it,
+  // concurrently. Every compilation has its own string interner and node
+  // arena, so no state is shared between them. With a cache, files whose
+  // preprocessed text was compiled before are not compiled again. Returns the
+  // failures in the order the files were given.
+  [[nodiscard]] std::vector<BatchFailure> compileBatch(
+    std::span<std::string const> source_paths,
+    std::size_t                  thread_count = getDefaultThreadCount(),
+    CompilationCache            *cache        = nullptr
+  );
+} // namespace SC2
+
+#endif
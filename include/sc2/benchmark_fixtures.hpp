@@ -0,0 +1,32 @@
+#ifndef BENCHMARK_FIXTURES_HPP_INCLUDED
+#define BENCHMARK_FIXTURES_HPP_INCLUDED
+
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <string>
+
+[[nodiscard]] inline std::string
+generateBenchmarkProgramText(std::size_t const statement_count)
+{
+  std::string program_text{ "int main(void) {\n  int v0 = 1;\n" };
+  auto        out{ std::back_inserter(program_text) };
+  for (std::size_t statement{ 1 }; statement <= statement_count; ++statement) {
+    std::size_t const previous{ statement - 1 };
+    std::format_to(
+      out,
+      "  int v{0} = v{1} * 3 + (v{1} >> 1) - ~{0} % 7;\n"
+      "  v{0} ^= v{1} & 255 | {0};\n"
+      "  v{0} = v{0} != 0 && v{1} <= 100 || !v{0} == (v{1} >= 2);\n"
+      "  v{0} <<= v{0} < 4;\n"
+      "  v{0}++;\n"
+      "  --v{1};\n",
+      statement,
+      previous
+    );
+  }
+  std::format_to(out, "  return v{};\n}}\n", statement_count);
+  return program_text;
+}
+
+#endif
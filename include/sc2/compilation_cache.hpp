@@ -0,0 +1,114 @@
+#ifndef SC2_COMPILATION_CACHE_HPP_INCLUDED
+#define SC2_COMPILATION_CACHE_HPP_INCLUDED
+
+#include <sc2/compiler_error.hpp>
+#include <string_view>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <string>
+
+namespace SC2 {
+  class CompilationCacheError: public CompilerError
+  {
+    std::string const message{};
+
+    public:
+    CompilationCacheError(
+      std::filesystem::path const &directory,
+      std::string_view             problem
+    )
+      : message{ std::format(
+          "Cannot use cache directory {}: {}",
+          directory.string(),
+          problem
+        ) }
+    {}
+
+    constexpr virtual char const *what() const noexcept final override
+    {
+      return message.c_str();
+    }
+  };
+
+  // XXH64, as specified by the xxHash project.
+  [[nodiscard]] std::uint64_t
+  hashXXH64(std::string_view data, std::uint64_t seed = 0) noexcept;
+
+  // Identifies the running sc2 build by the size and modification time of its
+  // executable, as ccache identifies compilers by default, so that rebuilding
+  // sc2 invalidates what older builds cached.
+  [[nodiscard]] std::string getCompilerIdentity();
+
+  struct CompilationCacheStatistics
+  {
+    std::uint64_t hits{};
+    std::uint64_t misses{};
+    std::uint64_t evictions{};
+  };
+
+  constexpr std::uintmax_t default_compilation_cache_size{ 1ULL << 30 };
+
+  // An on-disk cache of generated assembly, keyed on a hash of the
+  // preprocessed text, the compiler identity and the options that produced
+  // it. Each entry is a .s file in the cache directory, written to a
+  // temporary file and renamed into place so that readers in other processes
+  // never see part of one. A hit refreshes the entry's modification time.
+  // The stats file keeps a running total of the entries' size, which each
+  // store adds to under the stats lock; only once the total exceeds the
+  // maximum size is the directory scanned and the least recently used
+  // entries evicted, down to 90% of it. A cache is safe to share between
+  // threads and between processes; failing to read or write an entry only
+  // costs a miss.
+  class CompilationCache
+  {
+    std::filesystem::path      directory{};
+    std::uintmax_t             max_size{};
+    std::string                key_prefix{};
+    std::atomic<std::uint64_t> hits{};
+    std::atomic<std::uint64_t> misses{};
+    std::atomic<std::uint64_t> evictions{};
+
+    // Scans the directory, reaping temporary files left by crashed writers
+    // and evicting entries if they do not fit, and returns the size of the
+    // entries left. The caller must hold the stats lock.
+    std::uintmax_t evict();
+
+    public:
+    explicit CompilationCache(
+      std::filesystem::path directory,
+      std::uintmax_t        max_size          = default_compilation_cache_size,
+      std::string_view      compiler_identity = getCompilerIdentity()
+    );
+
+    CompilationCache(CompilationCache const &)            = delete;
+    CompilationCache &operator=(CompilationCache const &) = delete;
+
+    // The options are the ones that change the generated assembly. sc2 has
+    // none yet: -S and linking an executable produce the same assembly, so
+    // they share entries.
+    [[nodiscard]] std::string
+    getKey(std::string_view program_text, std::string_view options = {}) const;
+
+    [[nodiscard]] std::optional<std::string> lookUp(std::string const &key);
+
+    void store(std::string const &key, std::string_view assembly);
+
+    // The hits, misses and evictions of this process since the cache was
+    // opened or its statistics were last saved.
+    [[nodiscard]] CompilationCacheStatistics getStatistics() const noexcept;
+
+    // Adds this process's statistics to the totals kept in the cache
+    // directory, under a lock shared with other processes, and starts
+    // counting again from zero.
+    void saveStatistics();
+
+    [[nodiscard]] static CompilationCacheStatistics
+    loadStatistics(std::filesystem::path const &directory);
+  };
+} // namespace SC2
+
+#endif
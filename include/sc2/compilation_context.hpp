@@ -0,0 +1,75 @@
+#ifndef SC2_COMPILATION_CONTEXT_HPP_INCLUDED
+#define SC2_COMPILATION_CONTEXT_HPP_INCLUDED
+
+#include <sc2/node_arena.hpp>
+#include <sc2/string_interner.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SC2 {
+  class ProgramASTNode;
+  class ProgramAssemblyASTNode;
+
+  // Everything one compilation owns: the interner its names live in, the
+  // arena its nodes are allocated from, the counter its unique variable names
+  // are numbered by and the diagnostics reported against it. Nothing is
+  // shared between contexts, so compilations on different threads do not
+  // interfere, and the output of one never depends on what the process
+  // compiled before it. Its arena is only current while parse() or compile()
+  // runs, so contexts can live side by side and be destroyed in any order,
+  // each after every node allocated from it.
+  class CompilationContext
+  {
+    std::shared_ptr<StringInterner> string_interner{
+      std::make_shared<StringInterner>()
+    };
+    NodeArena                       arena{};
+    std::size_t                     declaration_count{};
+    std::vector<std::string>        diagnostics{};
+
+    public:
+    CompilationContext() = default;
+
+    CompilationContext(CompilationContext const &)            = delete;
+    CompilationContext &operator=(CompilationContext const &) = delete;
+
+    // The interner to construct this compilation's Lexer with.
+    [[nodiscard]] std::shared_ptr<StringInterner> const &
+    getStringInterner() const noexcept
+    {
+      return string_interner;
+    }
+
+    [[nodiscard]] NodeArena &getArena() noexcept { return arena; }
+
+    [[nodiscard]] std::size_t &getDeclarationCount() noexcept
+    {
+      return declaration_count;
+    }
+
+    void report(std::string diagnostic)
+    {
+      diagnostics.push_back(std::move(diagnostic));
+    }
+
+    [[nodiscard]] std::span<std::string const> getDiagnostics() const noexcept
+    {
+      return diagnostics;
+    }
+
+    [[nodiscard]] std::shared_ptr<ProgramASTNode>
+    parse(std::string_view program_text);
+
+    // Runs the whole pipeline up to legalised assembly, ready to be emitted
+    // or encoded.
+    [[nodiscard]] std::shared_ptr<ProgramAssemblyASTNode>
+    compile(std::string_view program_text);
+  };
+} // namespace SC2
+
+#endif
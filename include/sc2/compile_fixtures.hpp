@@ -0,0 +1,32 @@
+#ifndef COMPILE_FIXTURES_HPP_INCLUDED
+#define COMPILE_FIXTURES_HPP_INCLUDED
+
+#include <sc2/assembly_ast.hpp>
+#include <sc2/lexer.hpp>
+#include <sc2/parser.hpp>
+#include <sc2/tacky_ast.hpp>
+#include <string_view>
+
+#include <memory>
+
+// Takes the program text all the way to legal assembly, like
+// CompilationContext::compile(), for tests and benchmarks. Nodes come from the
+// current arena, if there is one, rather than from a context that would have
+// to outlive them, and register allocation can be skipped to measure what it
+// gains.
+[[nodiscard]] inline std::shared_ptr<SC2::ProgramAssemblyASTNode>
+compileProgram(
+  std::string_view const program_text,
+  bool const             allocate_registers = true
+)
+{
+  SC2::Lexer  lexer{ program_text };
+  SC2::Parser parser{ lexer };
+  auto        assembly{ parser.parseProgram()->emitTACKY()->emitAssembly() };
+  if (allocate_registers) assembly = assembly->allocateRegisters();
+  auto const last_offset{ assembly->replacePseudoRegisters() };
+  assembly->fixUp(-last_offset);
+  return assembly;
+}
+
+#endif
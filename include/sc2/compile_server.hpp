@@ -0,0 +1,102 @@
+#ifndef SC2_COMPILE_SERVER_HPP_INCLUDED
+#define SC2_COMPILE_SERVER_HPP_INCLUDED
+
+#include <sc2/compiler_error.hpp>
+#include <sc2/thread_pool.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <string>
+
+namespace SC2 {
+  class CompileServerError: public CompilerError
+  {
+    std::string const message{};
+
+    public:
+    CompileServerError(std::string_view operation, int error_number)
+      : message{ std::format(
+          "Compile server: {} failed: {}",
+          operation,
+          std::strerror(error_number)
+        ) }
+    {}
+
+    explicit CompileServerError(std::string_view problem)
+      : message{ std::format("Compile server: {}", problem) }
+    {}
+
+    constexpr virtual char const *what() const noexcept final override
+    {
+      return message.c_str();
+    }
+  };
+
+  struct CompileResult
+  {
+    bool        succeeded{};
+    // The assembly, or the diagnostic if compilation failed. Empty for the
+    // options that stop before assembly is emitted.
+    std::string output{};
+  };
+
+  // Compiles the source of one request the way sc2 compiles a file with the
+  // option: the source is preprocessed, with quoted includes resolved against
+  // the source path, then taken as far as the option says. The empty option
+  // and -S produce assembly; --lex, --parse, --validate, --tacky and
+  // --codegen only check that the source gets that far.
+  [[nodiscard]] CompileResult compileRequest(
+    std::string_view             options,
+    std::filesystem::path const &source_path,
+    std::string_view             source
+  );
+
+  // Listens on a Unix domain socket and answers compile requests until
+  // stopped. One thread accepts connections and reads requests from them as
+  // their bytes arrive; each whole request is handed to a worker thread, which
+  // answers it with its own CompilationContext and hands the connection back.
+  // A client that stops reading its response is dropped after a timeout. A
+  // request is the options, the source path and the source, and a response
+  // is whether compilation succeeded and its output, each string preceded by
+  // its length as a 64-bit integer in host byte order.
+  class CompileServer
+  {
+    std::filesystem::path socket_path{};
+    int                   listening_socket{ -1 };
+    // Written to by stop(); never read, so that it stays readable.
+    int stop_pipe[2]{ -1, -1 };
+
+    public:
+    // Binds the socket, replacing a stale one left at the path.
+    explicit CompileServer(std::filesystem::path socket_path);
+
+    CompileServer(CompileServer const &)            = delete;
+    CompileServer &operator=(CompileServer const &) = delete;
+
+    ~CompileServer();
+
+    // Watches connections on the calling thread and answers requests on
+    // thread_count workers. Returns once stop() has been called, closing the
+    // connections still open; a request being read or answered then is
+    // dropped.
+    void run(std::size_t thread_count = getDefaultThreadCount());
+
+    // Makes run() return. Safe to call from any thread and from a signal
+    // handler.
+    void stop() noexcept;
+  };
+
+  // The thin client: sends one request to the server listening on the socket
+  // and waits for its response.
+  [[nodiscard]] CompileResult requestCompilation(
+    std::filesystem::path const &socket_path,
+    std::string_view             options,
+    std::filesystem::path const &source_path,
+    std::string_view             source
+  );
+} // namespace SC2
+
+#endif
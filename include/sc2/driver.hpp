@@ -0,0 +1,46 @@
+#ifndef SC2_DRIVER_HPP_INCLUDED
+#define SC2_DRIVER_HPP_INCLUDED
+
+#include <sc2/compiler_error.hpp>
+#include <string_view>
+
+#include <cstring>
+#include <format>
+#include <string>
+
+namespace SC2 {
+  class ProcessError: public CompilerError
+  {
+    std::string const message{};
+
+    public:
+    ProcessError(std::string_view program, std::string_view problem)
+      : message{ std::format("Cannot run {}: {}", program, problem) }
+    {}
+
+    ProcessError(std::string_view program, int error_number)
+      : ProcessError(program, std::strerror(error_number))
+    {}
+
+    constexpr virtual char const *what() const noexcept final override
+    {
+      return message.c_str();
+    }
+  };
+
+  // Runs the system C preprocessor on the source file and returns its output,
+  // read straight from a pipe. sc2 preprocesses in process with Preprocessor;
+  // this is kept as the baseline it is measured against.
+  [[nodiscard]] std::string preprocess(std::string const &source_path);
+
+  // Pipes the assembly into the system compiler, which assembles it and links
+  // the executable. No .i or .s file is written, but the assembler still
+  // writes the object file to a temporary file, which the compiler removes
+  // once it has linked.
+  void assembleAndLink(
+    std::string_view   assembly,
+    std::string const &executable_path
+  );
+} // namespace SC2
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef SC2_ELF_OBJECT_WRITER_HPP_INCLUDED
+#define SC2_ELF_OBJECT_WRITER_HPP_INCLUDED
+
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SC2 {
+  // An ELF64 relocatable object for x86-64. Functions are laid out one after
+  // another in .text, each under a global symbol, and an empty
+  // .note.GNU-stack section marks the stack as not executable. The code never
+  // refers to anything outside its own function, so there are no relocations.
+  class ElfObjectWriter
+  {
+    struct FunctionSymbol
+    {
+      std::string name{};
+      std::size_t offset{};
+      std::size_t size{};
+    };
+
+    std::vector<std::uint8_t>   text{};
+    std::vector<FunctionSymbol> functions{};
+
+    public:
+    void addFunction(std::string_view name, std::span<std::uint8_t const> code);
+
+    [[nodiscard]] std::span<std::uint8_t const> getText() const noexcept
+    {
+      return text;
+    }
+
+    [[nodiscard]] std::vector<std::uint8_t> write() const;
+
+    void writeToFile(std::string const &path) const;
+  };
+} // namespace SC2
+
+#endif
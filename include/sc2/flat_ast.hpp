@@ -0,0 +1,190 @@
+#ifndef SC2_FLAT_AST_HPP_INCLUDED
+#define SC2_FLAT_AST_HPP_INCLUDED
+
+#include <sc2/pretty_printer_mixin.hpp>
+#include <sc2/string_interner.hpp>
+#include <string_view>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SC2 {
+  enum class FlatASTNodeKind : std::uint8_t
+  {
+    IntType,
+    VoidType,
+    LiteralConstant,
+    Variable,
+    Unary,
+    Binary,
+    Assignment,
+    ReturnStatement,
+    ExpressionStatement,
+    NullStatement,
+    Declaration
+  };
+
+  enum class FlatASTOperator : std::uint8_t
+  {
+    None,
+    Complement,
+    Negate,
+    Not,
+    PrefixIncrement,
+    PrefixDecrement,
+    PostfixIncrement,
+    PostfixDecrement,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Modulo,
+    BitwiseAnd,
+    BitwiseOr,
+    BitwiseXor,
+    LeftShift,
+    RightShift,
+    And,
+    Or,
+    Equals,
+    NotEquals,
+    LessThan,
+    GreaterThan,
+    LessThanOrEqualTo,
+    GreaterThanOrEqualTo,
+    Assignment,
+    AddAssignment,
+    SubtractAssignment,
+    MultiplyAssignment,
+    DivideAssignment,
+    ModuloAssignment,
+    BitwiseAndAssignment,
+    BitwiseOrAssignment,
+    BitwiseXorAssignment,
+    LeftShiftAssignment,
+    RightShiftAssignment
+  };
+
+  inline constexpr std::array<std::string_view, 37> flat_ast_operator_symbols{
+    "",   "~",  "-",  "!",  "++", "--", "++", "--", "+",  "-",
+    "*",  "/",  "%",  "&",  "|",  "^",  "<<", ">>", "&&", "||",
+    "==", "!=", "<",  ">",  "<=", ">=", "=",  "+=", "-=", "*=",
+    "/=", "%=", "&=", "|=", "^=", "<<=", ">>="
+  };
+
+  [[nodiscard]] constexpr std::string_view
+  getFlatASTOperatorSymbol(FlatASTOperator const flat_ast_operator) noexcept
+  {
+    return flat_ast_operator_symbols[static_cast<std::size_t>(flat_ast_operator
+    )];
+  }
+
+  class ProgramTACKYASTNode;
+  class TACKYInstructionSink;
+  struct ValueTACKYASTNode;
+
+  // A flat alternative to the pointer-linked AST of a function. Nodes are
+  // stored in pre-order across parallel arrays and refer to their children
+  // and to the literal constant and identifier side tables by 32-bit index,
+  // so the pretty-printer and emitTACKY() walk the arrays front to back.
+  //
+  // Operands by node kind:
+  //   LiteralConstant, Variable: first = side table index
+  //   Unary, ReturnStatement, ExpressionStatement: first = operand node
+  //   Binary: first = left operand node, second = right operand node
+  //   Assignment: first = variable node, second = expression node
+  //   Declaration: first = identifier index, second = initializer node or
+  //                no_node; the declared type is the next node
+  //
+  // The function name and identifiers are views of interned names, which the
+  // flat AST keeps alive through its string interner.
+  class FlatAST final: public PrettyPrinterMixin
+  {
+    public:
+    static constexpr std::uint32_t no_node{
+      std::numeric_limits<std::uint32_t>::max()
+    };
+
+    private:
+    std::string_view                      function_name{};
+    std::shared_ptr<StringInterner const> string_interner{};
+    std::vector<FlatASTNodeKind>          kinds{};
+    std::vector<FlatASTOperator>          operators{};
+    std::vector<std::uint32_t>            first_operands{};
+    std::vector<std::uint32_t>            second_operands{};
+    std::vector<int>                      literal_constants{};
+    std::vector<std::string_view>         identifiers{};
+    std::vector<std::uint32_t>            block_items{};
+
+    void prettyPrintExpression(std::ostream &out, std::uint32_t node) const;
+
+    void prettyPrintBlockItem(
+      std::ostream &out,
+      std::size_t   indent_level,
+      std::uint32_t node
+    ) const;
+
+    [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
+    emitTACKYForExpression(TACKYInstructionSink &sink, std::uint32_t node)
+      const;
+
+    void
+    emitTACKYForBlockItem(TACKYInstructionSink &sink, std::uint32_t node) const;
+
+    public:
+    FlatAST(
+      std::string_view                      function_name,
+      std::shared_ptr<StringInterner const> string_interner
+    )
+      : function_name{ function_name }
+      , string_interner{ std::move(string_interner) }
+    {}
+
+    std::uint32_t appendNode(
+      FlatASTNodeKind kind,
+      FlatASTOperator flat_ast_operator = FlatASTOperator::None,
+      std::uint32_t   first_operand     = no_node,
+      std::uint32_t   second_operand    = no_node
+    );
+
+    void setFirstOperand(std::uint32_t node, std::uint32_t first_operand)
+    {
+      first_operands[node] = first_operand;
+    }
+
+    void setSecondOperand(std::uint32_t node, std::uint32_t second_operand)
+    {
+      second_operands[node] = second_operand;
+    }
+
+    [[nodiscard]] std::uint32_t addLiteralConstant(int literal_constant);
+    [[nodiscard]] std::uint32_t addIdentifier(std::string_view identifier);
+
+    void addBlockItem(std::uint32_t node) { block_items.push_back(node); }
+
+    [[nodiscard]] constexpr std::size_t getNodeCount() const noexcept
+    {
+      return kinds.size();
+    }
+
+    // Bytes held by the node arrays and side tables, excluding the interned
+    // characters of identifiers.
+    [[nodiscard]] std::size_t getMemoryFootprint() const noexcept;
+
+    [[nodiscard]] std::shared_ptr<ProgramTACKYASTNode> emitTACKY() const;
+
+    virtual void prettyPrintHelper(std::ostream &out, std::size_t indent_level)
+      final override;
+
+    virtual ~FlatAST() = default;
+  };
+} // namespace SC2
+
+#endif
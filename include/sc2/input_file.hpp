@@ -0,0 +1,63 @@
+#ifndef SC2_INPUT_FILE_HPP_INCLUDED
+#define SC2_INPUT_FILE_HPP_INCLUDED
+
+#include <sc2/compiler_error.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <string>
+
+namespace SC2 {
+  class InputFileError: public CompilerError
+  {
+    std::string const message{};
+
+    public:
+    InputFileError(std::string_view path, int error_number)
+      : message{ std::format(
+          "Cannot read {}: {}",
+          path,
+          std::strerror(error_number)
+        ) }
+    {}
+
+    constexpr virtual char const *what() const noexcept final override
+    {
+      return message.c_str();
+    }
+  };
+
+  // The contents of a file, read without copying them through a stream. A
+  // regular file is mapped read-only and advised for sequential access, so
+  // that the lexer reads the page cache directly; anything that cannot be
+  // mapped, such as a pipe or a terminal, is read into a single buffer that
+  // doubles as it fills. Truncating a mapped file while it is being read is
+  // not supported.
+  class InputFile
+  {
+    void       *mapping{};
+    std::size_t mapping_size{};
+    std::string buffer{};
+
+    public:
+    explicit InputFile(std::string const &path);
+
+    InputFile(InputFile const &)            = delete;
+    InputFile &operator=(InputFile const &) = delete;
+
+    ~InputFile();
+
+    [[nodiscard]] std::string_view getText() const noexcept
+    {
+      if (mapping)
+        return { static_cast<char const *>(mapping), mapping_size };
+      return buffer;
+    }
+
+    [[nodiscard]] bool isMapped() const noexcept { return mapping != nullptr; }
+  };
+} // namespace SC2
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SC2_JIT_HPP_INCLUDED
+#define SC2_JIT_HPP_INCLUDED
+
+#include <sc2/assembly_ast.hpp>
+#include <sc2/compiler_error.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <span>
+#include <string>
+
+namespace SC2 {
+  class JITError: public CompilerError
+  {
+    std::string const message{};
+
+    public:
+    JITError(std::string_view operation, int error_number)
+      : message{ std::format(
+          "Cannot run program in memory: {} failed: {}",
+          operation,
+          std::strerror(error_number)
+        ) }
+    {}
+
+    constexpr virtual char const *what() const noexcept final override
+    {
+      return message.c_str();
+    }
+  };
+
+  // Machine code copied into pages that are mapped writable, then remapped
+  // read-only and executable before anything can call into them.
+  class ExecutableMemory
+  {
+    void       *memory{};
+    std::size_t size{};
+
+    public:
+    explicit ExecutableMemory(std::span<std::uint8_t const> code);
+
+    ExecutableMemory(ExecutableMemory const &)            = delete;
+    ExecutableMemory &operator=(ExecutableMemory const &) = delete;
+
+    ~ExecutableMemory();
+
+    // Calls the code as a function taking no arguments and returning int.
+    [[nodiscard]] int call() const;
+  };
+
+  // Encodes the legalized program and calls its function in this process.
+  [[nodiscard]] int runProgram(ProgramAssemblyASTNode const &program);
+
+  // Like runProgram(), but in a forked child, so that a crashing program
+  // cannot take the compiler down with it. Returns the exit status the
+  // program would have had as a process: its result modulo 256, or 128 plus
+  // the number of the signal that killed it.
+  [[nodiscard]] int runProgramInChildProcess(
+    ProgramAssemblyASTNode const &program
+  );
+} // namespace SC2
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef SC2_MACHINE_CODE_BUFFER_HPP_INCLUDED
+#define SC2_MACHINE_CODE_BUFFER_HPP_INCLUDED
+
+#include <string_view>
+#include <unordered_map>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SC2 {
+  // An operand in the form the ModRM byte of an x86-64 instruction needs: a
+  // register, or a displacement from a base register. Register numbers run
+  // from 0 to 15, so that bit 3 goes into the REX prefix.
+  struct ModRMOperand
+  {
+    std::uint8_t number{};
+    bool         is_memory{};
+    std::int32_t displacement{};
+    // %spl, %bpl, %sil and %dil can only be named with a REX prefix.
+    bool         needs_rex{};
+  };
+
+  inline constexpr std::uint8_t rsp_register_number{ 4 };
+  inline constexpr std::uint8_t rbp_register_number{ 5 };
+
+  // Machine code for one function. Jumps are kept apart from the bytes until
+  // finish(), which gives each the short rel8 form where its target is in
+  // range and the rel32 form otherwise, as the GNU assembler does.
+  class MachineCodeBuffer
+  {
+    struct Jump
+    {
+      std::size_t                 position{};
+      std::optional<std::uint8_t> condition_code{};
+      std::uint32_t               label{};
+    };
+
+    std::vector<std::uint8_t>                      bytes{};
+    std::vector<Jump>                              jumps{};
+    std::unordered_map<std::string, std::uint32_t> label_ids{};
+    std::vector<std::optional<std::size_t>>        label_positions{};
+    std::vector<std::size_t>                       label_jump_counts{};
+
+    [[nodiscard]] std::uint32_t getLabel(std::string_view name);
+
+    public:
+    [[nodiscard]] static constexpr bool fitsInInt8(std::int64_t value) noexcept
+    {
+      return value >= -128 && value <= 127;
+    }
+
+    void emitByte(std::uint8_t byte) { bytes.push_back(byte); }
+
+    void emitInt8(std::int32_t value)
+    {
+      bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    void emitInt32(std::int32_t value);
+
+    // Emits an optional REX prefix, the opcode, the ModRM byte and any
+    // displacement. The reg field holds either a register or an opcode
+    // extension.
+    void emitInstruction(
+      std::initializer_list<std::uint8_t> opcode,
+      ModRMOperand const                 &reg,
+      ModRMOperand const                 &rm,
+      bool                                is_64_bit = false
+    );
+
+    // Emits an opcode that encodes its register in its low three bits.
+    void emitInstructionWithRegister(
+      std::uint8_t        opcode,
+      ModRMOperand const &reg
+    );
+
+    void defineLabel(std::string_view name);
+
+    void emitJump(
+      std::string_view            label,
+      std::optional<std::uint8_t> condition_code
+    );
+
+    [[nodiscard]] std::vector<std::uint8_t> finish() const;
+  };
+} // namespace SC2
+
+#endif
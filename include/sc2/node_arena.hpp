@@ -0,0 +1,100 @@
+#ifndef SC2_NODE_ARENA_HPP_INCLUDED
+#define SC2_NODE_ARENA_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace SC2 {
+  // Bump allocator for the AST, TACKY and assembly nodes of one compilation.
+  // While an arena is current on a thread, makeNode() places every node
+  // together with its control block in the arena, and the arena releases all
+  // of that memory at once when it is destroyed. It must therefore outlive
+  // every node that was allocated from it. An arena is only current inside a
+  // NodeArenaScope, so arenas can be created and destroyed in any order.
+  class NodeArena final: public std::pmr::memory_resource
+  {
+    static constexpr std::size_t initial_buffer_size{ 64 * 1024 };
+
+    friend class NodeArenaScope;
+
+    static inline thread_local NodeArena *current_arena{};
+
+    std::pmr::monotonic_buffer_resource resource{ initial_buffer_size };
+    std::size_t                         allocation_count{};
+    std::size_t                         allocated_bytes{};
+
+    [[nodiscard]] virtual void *
+    do_allocate(std::size_t bytes, std::size_t alignment) final override
+    {
+      ++allocation_count;
+      allocated_bytes += bytes;
+      return resource.allocate(bytes, alignment);
+    }
+
+    virtual void do_deallocate(void *, std::size_t, std::size_t) final override
+    {}
+
+    [[nodiscard]] virtual bool
+    do_is_equal(std::pmr::memory_resource const &other
+    ) const noexcept final override
+    {
+      return this == &other;
+    }
+
+    public:
+    NodeArena() = default;
+
+    NodeArena(NodeArena const &)            = delete;
+    NodeArena &operator=(NodeArena const &) = delete;
+
+    [[nodiscard]] static NodeArena *getCurrentArena() noexcept
+    {
+      return current_arena;
+    }
+
+    [[nodiscard]] constexpr std::size_t getAllocationCount() const noexcept
+    {
+      return allocation_count;
+    }
+
+    [[nodiscard]] constexpr std::size_t getAllocatedBytes() const noexcept
+    {
+      return allocated_bytes;
+    }
+
+    virtual ~NodeArena() final override = default;
+  };
+
+  // Makes an arena current on this thread for as long as the scope lives,
+  // and restores whichever arena was current before it. Scopes nest.
+  class NodeArenaScope
+  {
+    NodeArena *previous_arena{};
+
+    public:
+    explicit NodeArenaScope(NodeArena &arena) noexcept
+      : previous_arena{ std::exchange(NodeArena::current_arena, &arena) }
+    {}
+
+    NodeArenaScope(NodeArenaScope const &)            = delete;
+    NodeArenaScope &operator=(NodeArenaScope const &) = delete;
+
+    ~NodeArenaScope() { NodeArena::current_arena = previous_arena; }
+  };
+
+  template <typename Node, typename... Arguments>
+  [[nodiscard]] std::shared_ptr<Node> makeNode(Arguments &&...arguments)
+  {
+    if (NodeArena * const arena{ NodeArena::getCurrentArena() })
+      return std::allocate_shared<Node>(
+        std::pmr::polymorphic_allocator<Node>(arena),
+        std::forward<Arguments>(arguments)...
+      );
+    else
+      return std::make_shared<Node>(std::forward<Arguments>(arguments)...);
+  }
+} // namespace SC2
+
+#endif
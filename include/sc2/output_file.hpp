@@ -0,0 +1,41 @@
+#ifndef SC2_OUTPUT_FILE_HPP_INCLUDED
+#define SC2_OUTPUT_FILE_HPP_INCLUDED
+
+#include <sc2/compiler_error.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <span>
+#include <string>
+
+namespace SC2 {
+  class OutputFileError: public CompilerError
+  {
+    std::string const message{};
+
+    public:
+    OutputFileError(std::string_view path, int error_number)
+      : message{ std::format(
+          "Cannot write {}: {}",
+          path,
+          std::strerror(error_number)
+        ) }
+    {}
+
+    constexpr virtual char const *what() const noexcept final override
+    {
+      return message.c_str();
+    }
+  };
+
+  // Replaces the file at the path with the contents, using a single write(2)
+  // unless it is interrupted.
+  void writeOutputFile(
+    std::string const          &path,
+    std::span<std::byte const> contents
+  );
+} // namespace SC2
+
+#endif
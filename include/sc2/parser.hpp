@@ -2,16 +2,26 @@
 #define SC2_PARSER_HPP_INCLUDED
 
 #include <sc2/ast.hpp>
+#include <sc2/compilation_context.hpp>
 #include <sc2/compiler_error.hpp>
 #include <sc2/lexer.hpp>
 #include <sc2/semantic_analysis_error.hpp>
+#include <sc2/string_interner.hpp>
+#include <sc2/token_buffer.hpp>
 #include <sc2/tokens.hpp>
 #include <unordered_map>
 
 #include <concepts>
+#include <cstddef>
+#include <expected>
 #include <format>
+#include <memory>
+#include <optional>
+#include <ranges>
 #include <stdexcept>
+#include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -22,20 +32,81 @@ namespace SC2 {
     virtual ~ParserError() = default;
   };
 
+  // Why a program failed to parse: the error found and the non-terminals
+  // that were being parsed when it was found, innermost first. The parser
+  // returns failures rather than throwing them, so that rejecting a program
+  // costs no unwinding however deeply the error is nested.
+  class ParseFailure
+  {
+    struct Details
+    {
+      std::string                   message{};
+      std::vector<std::string_view> non_terminals{};
+    };
+
+    // Kept out of line, so that every token and node the parser returns on
+    // the way to a successful parse is not widened by the failure it might
+    // have been.
+    std::unique_ptr<Details> details{};
+
+    public:
+    explicit ParseFailure(ParserError const &error)
+      : details{ std::make_unique<Details>(error.what()) }
+    {}
+
+    // A moved-from failure has no details, and neither does its copy.
+    ParseFailure(ParseFailure const &other)
+      : details{ other.details ? std::make_unique<Details>(*other.details)
+                               : nullptr }
+    {}
+
+    ParseFailure(ParseFailure &&) noexcept = default;
+
+    ParseFailure &operator=(ParseFailure const &other)
+    {
+      details = other.details ? std::make_unique<Details>(*other.details)
+                              : nullptr;
+      return *this;
+    }
+
+    ParseFailure &operator=(ParseFailure &&) noexcept = default;
+
+    void addNonTerminal(std::string_view const non_terminal)
+    {
+      details->non_terminals.push_back(non_terminal);
+    }
+
+    // The message of the error, preceded by a line for each non-terminal
+    // from the outermost in.
+    [[nodiscard]] std::string getMessage() const
+    {
+      std::string message{};
+      for (auto const non_terminal:
+           details->non_terminals | std::views::reverse)
+        message += std::format(
+          "Parser error: invalid non-terminal <{}>:\n",
+          non_terminal
+        );
+      return message + details->message;
+    }
+  };
+
+  template <typename T>
+  using ParseResult = std::expected<T, ParseFailure>;
+
+  [[nodiscard]] inline std::unexpected<ParseFailure>
+  failParse(ParserError const &error)
+  {
+    return std::unexpected{ ParseFailure{ error } };
+  }
+
   class ParserNonTerminalError final: public ParserError
   {
     std::string const message{};
 
     public:
-    ParserNonTerminalError(
-      std::string_view   non_terminal,
-      ParserError const &childError
-    )
-      : message{ std::format(
-          "Parser error: invalid non-terminal <{}>:\n{}",
-          non_terminal,
-          childError.what()
-        ) }
+    explicit ParserNonTerminalError(ParseFailure const &failure)
+      : message{ failure.getMessage() }
     {}
 
     virtual constexpr char const *what() const noexcept final override
@@ -316,93 +387,124 @@ namespace SC2 {
 
   class TypeAliasToTypeMap
   {
-    std::unordered_map<std::string, std::shared_ptr<TypeASTNode>> map{};
+    StringInterner const                                      &string_interner;
+    std::unordered_map<SymbolID, std::shared_ptr<TypeASTNode>> map{};
 
     public:
-    constexpr TypeAliasToTypeMap() = default;
-
-    TypeAliasToTypeMap(
-      std::unordered_map<std::string, std::shared_ptr<TypeASTNode>> map
-    )
-      : map{ map }
+    explicit TypeAliasToTypeMap(StringInterner const &string_interner)
+      : string_interner{ string_interner }
     {}
 
-    [[nodiscard]] std::shared_ptr<TypeASTNode> getType(std::string_view alias
-    ) const
+    [[nodiscard]] ParseResult<std::shared_ptr<TypeASTNode>>
+    getType(SymbolID const alias) const
     {
-      try {
-        return map.at(std::string{ alias });
-      } catch (std::out_of_range const &) {
-        throw UnknownTypeNameError(alias);
-      }
+      if (auto const type{ map.find(alias) }; type != map.end())
+        return type->second;
+      else
+        return failParse(
+          UnknownTypeNameError(string_interner.getString(alias))
+        );
     }
 
-    void aliasType(std::shared_ptr<TypeASTNode> type, std::string_view alias)
+    void aliasType(std::shared_ptr<TypeASTNode> type, SymbolID const alias)
     {
-      map[std::string{ alias }] = type;
+      map[alias] = type;
     }
 
-    [[nodiscard]] bool contains(std::string_view name) const
+    [[nodiscard]] bool contains(SymbolID const name) const
     {
-      return map.contains(std::string{ name });
+      return map.contains(name);
     }
   };
 
   class VariableToTypeAndUniqueIdentifierMap
   {
+    StringInterner &string_interner;
+    // Numbers the declarations of one compilation, so that unique names do
+    // not depend on anything compiled before it in the same process.
+    std::size_t    &declaration_count;
+
     std::unordered_map<
-      std::string,
-      std::tuple<std::shared_ptr<TypeASTNode>, std::string>>
+      SymbolID,
+      std::tuple<std::shared_ptr<TypeASTNode>, SymbolID>>
       map{};
 
+    [[nodiscard]] ParseResult<
+      std::tuple<std::shared_ptr<TypeASTNode>, SymbolID> const *>
+    getTypeAndUniqueIdentifier(SymbolID const variable) const
+    {
+      if (auto const entry{ map.find(variable) }; entry != map.end())
+        return &entry->second;
+      else
+        return failParse(
+          UndefinedVariableError(string_interner.getString(variable))
+        );
+    }
+
     public:
-    constexpr VariableToTypeAndUniqueIdentifierMap() = default;
+    VariableToTypeAndUniqueIdentifierMap(
+      StringInterner &string_interner,
+      std::size_t    &declaration_count
+    )
+      : string_interner{ string_interner }
+      , declaration_count{ declaration_count }
+    {}
 
-    [[nodiscard]] bool contains(std::string_view identifier) const
+    [[nodiscard]] bool contains(SymbolID const identifier) const
     {
-      return map.contains(std::string{ identifier });
+      return map.contains(identifier);
     }
 
-    [[nodiscard]] std::shared_ptr<TypeASTNode> getType(std::string_view variable
-    ) const
-    try {
-      return std::get<0>(map.at(std::string{ variable }));
-    } catch (std::out_of_range const &) {
-      throw UndefinedVariableError(variable);
+    [[nodiscard]] ParseResult<std::shared_ptr<TypeASTNode>>
+    getType(SymbolID const variable) const
+    {
+      auto const entry{ getTypeAndUniqueIdentifier(variable) };
+      if (!entry) return std::unexpected{ entry.error() };
+      return std::get<0>(**entry);
     }
 
-    [[nodiscard]] std::string_view getUniqueIdentifier(std::string_view variable
-    ) const
-    try {
-      return std::get<1>(map.at(std::string{ variable }));
-    } catch (std::out_of_range const &) {
-      throw UndefinedVariableError(variable);
+    [[nodiscard]] ParseResult<std::string_view>
+    getUniqueIdentifier(SymbolID const variable) const
+    {
+      auto const entry{ getTypeAndUniqueIdentifier(variable) };
+      if (!entry) return std::unexpected{ entry.error() };
+      return string_interner.getString(std::get<1>(**entry));
     }
 
     void assignTypeAndUniqueIdentifier(
-      std::string_view             variable,
+      SymbolID const               variable,
       std::string_view             current_function_name,
       std::shared_ptr<TypeASTNode> type
     )
     {
-      std::string const identifier{ variable };
-      std::string const unique_identifier{ std::format(
-        "{}.{}",
-        Utility::generateFreshIdentifierWithPrefix(current_function_name),
-        identifier
-      ) };
-
-      map[identifier] = std::make_tuple(type, unique_identifier);
+      SymbolID const unique_identifier{
+        string_interner.intern(std::format(
+          "{}.{}.{}",
+          current_function_name,
+          declaration_count++,
+          string_interner.getString(variable)
+        ))
+      };
+      map[variable] = std::make_tuple(type, unique_identifier);
     }
   };
 
   class SemanticAnalysisIdentifierInfo
   {
     VariableToTypeAndUniqueIdentifierMap
-                       variable_to_type_and_unique_identifier_map{};
-    TypeAliasToTypeMap type_alias_to_type_map{};
+                       variable_to_type_and_unique_identifier_map;
+    TypeAliasToTypeMap type_alias_to_type_map;
 
     public:
+    SemanticAnalysisIdentifierInfo(
+      StringInterner &string_interner,
+      std::size_t    &declaration_count
+    )
+      : variable_to_type_and_unique_identifier_map{ string_interner,
+                                                    declaration_count }
+      , type_alias_to_type_map{ string_interner }
+    {}
+
     [[nodiscard]] constexpr auto
     getVariableToTypeAndUniqueIdentifierMap(this auto &self) noexcept
       -> decltype(auto)
@@ -419,448 +521,614 @@ namespace SC2 {
 
   class Parser
   {
-    std::exception_ptr current_exception{};
-    std::vector<Token> tokens{};
-    Lexer             &lexer;
-
-    [[nodiscard]] Token peekNextToken()
-    try {
-      return *lexer;
-    } catch (LexerEOFError const &) {
-      throw ParserEOFError{};
-    }
-
-    // We have to do some gymnastics here so that we don't get confusing error
-    // messages. We want a non-terminal to parse correctly even if the *next*
-    // token following the non-terminal is invalid.
-    [[nodiscard]] Token parseNextToken()
-    try {
-      if (current_exception) {
-        try {
-          std::rethrow_exception(current_exception);
-        } catch (LexerInvalidTokenError const &error) {
-          throw ParserInvalidTokenError(error);
-        }
-      }
-      Token next_token{ *lexer };
-      tokens.push_back(next_token);
-      try {
-        ++lexer;
-      } catch (...) {
-        current_exception = std::current_exception();
-      }
+    // A parser made from a lexer lexes into a buffer of its own.
+    std::optional<TokenBuffer>      own_token_buffer{};
+    TokenBuffer const              *token_buffer{};
+    std::size_t                     next_token_index{};
+    std::shared_ptr<StringInterner> string_interner{};
+    // Unique variable names are numbered by the compilation's context, or by
+    // the parser itself when it is used without one.
+    std::size_t                     own_declaration_count{};
+    std::size_t                    *declaration_count{ &own_declaration_count };
+
+    // Runs the body of a non-terminal, adding the non-terminal to the failure
+    // it returns, if any.
+    template <std::invocable Body>
+    [[nodiscard]] static std::invoke_result_t<Body>
+    parseNonTerminal(std::string_view const non_terminal, Body const &body)
+    {
+      auto result{ body() };
+      if (!result) result.error().addNonTerminal(non_terminal);
+      return result;
+    }
+
+    // The tokens before an invalid token parse as usual, so that a
+    // non-terminal still parses correctly when only the token *following*
+    // it is invalid; reaching the invalid token is an error.
+    [[nodiscard]] ParseResult<Token> peekNextToken() const
+    {
+      auto const tokens{ token_buffer->getTokens() };
+      if (next_token_index < tokens.size()) return tokens[next_token_index];
+      if (auto const * const error{ token_buffer->getInvalidTokenError() })
+        return failParse(ParserInvalidTokenError(*error));
+      return failParse(ParserEOFError{});
+    }
+
+    [[nodiscard]] ParseResult<Token> parseNextToken()
+    {
+      auto const next_token{ peekNextToken() };
+      if (next_token) ++next_token_index;
       return next_token;
-    } catch (LexerEOFError const &) {
-      throw ParserEOFError{};
     }
 
-    [[nodiscard]] std::shared_ptr<IdentifierToken> parseIdentifierToken()
-    try {
-      return parseNextToken().getIdentifier();
-    } catch (TokenConversionError const &error) {
-      throw ParserTokenCreationError(error);
+    [[nodiscard]] static ParseResult<SymbolID> getSymbol(Token const &token)
+    {
+      if (token.getKind() != TokenKind::Identifier)
+        return failParse(
+          ParserTokenCreationError(TokenConversionError(token, "identifier"))
+        );
+      return token.getSymbol();
+    }
+
+    [[nodiscard]] ParseResult<SymbolID> parseIdentifierToken()
+    {
+      auto const token{ parseNextToken() };
+      if (!token) return std::unexpected{ token.error() };
+      return getSymbol(*token);
     }
 
-    [[nodiscard]] std::shared_ptr<LiteralConstantToken>
-    parseLiteralConstantToken()
-    try {
-      return parseNextToken().getLiteralConstant();
-    } catch (TokenConversionError const &error) {
-      throw ParserTokenCreationError(error);
+    [[nodiscard]] ParseResult<int> parseLiteralConstantToken()
+    {
+      auto const token{ parseNextToken() };
+      if (!token) return std::unexpected{ token.error() };
+      if (token->getKind() != TokenKind::LiteralConstant)
+        return failParse(ParserTokenCreationError(
+          TokenConversionError(*token, "literal constant")
+        ));
+      return token->getLiteralConstant();
     }
 
-    void expect(Token const &expected_token)
+    [[nodiscard]] ParseResult<void> expect(TokenKind const expected_kind)
     {
-      if (auto const actual_token{ parseNextToken() };
-          expected_token != actual_token)
-        throw ParserTokenExpectationError(expected_token, actual_token);
+      auto const actual_token{ parseNextToken() };
+      if (!actual_token) return std::unexpected{ actual_token.error() };
+      if (actual_token->getKind() != expected_kind)
+        return failParse(
+          ParserTokenExpectationError(Token(expected_kind), *actual_token)
+        );
+      return {};
     }
 
-    constexpr void expectFinished()
+    [[nodiscard]] ParseResult<bool> accept(TokenKind const kind)
     {
-      if (lexer != lexer.end()) throw ParserExtraneousTokenError(*lexer);
+      auto const next_token{ peekNextToken() };
+      if (!next_token) return std::unexpected{ next_token.error() };
+      if (next_token->getKind() != kind) return false;
+      ++next_token_index;
+      return true;
     }
 
-    [[nodiscard]] std::shared_ptr<LiteralConstantASTNode>
+    [[nodiscard]] ParseResult<void> expectFinished() const
+    {
+      if (next_token_index == token_buffer->getTokens().size()
+          && !token_buffer->getInvalidTokenError())
+        return {};
+      auto const next_token{ peekNextToken() };
+      if (!next_token) return std::unexpected{ next_token.error() };
+      return failParse(ParserExtraneousTokenError(*next_token));
+    }
+
+    [[nodiscard]] ParseResult<std::shared_ptr<LiteralConstantASTNode>>
     parseLiteralConstantExpression()
     {
-      return std::make_shared<LiteralConstantASTNode>(
-        parseLiteralConstantToken()->getValue()
-      );
+      auto const literal_constant{ parseLiteralConstantToken() };
+      if (!literal_constant) return std::unexpected{ literal_constant.error() };
+      return makeNode<LiteralConstantASTNode>(*literal_constant);
     }
 
-    [[nodiscard]] std::shared_ptr<VariableASTNode>
+    [[nodiscard]] ParseResult<std::shared_ptr<VariableASTNode>>
     parseVariable(VariableToTypeAndUniqueIdentifierMap &map)
     {
-      std::string const variable{ parseIdentifierToken()->getName() };
-      return std::make_shared<VariableASTNode>(map.getUniqueIdentifier(variable)
-      );
+      auto const variable{ parseIdentifierToken() };
+      if (!variable) return std::unexpected{ variable.error() };
+      auto const unique_identifier{ map.getUniqueIdentifier(*variable) };
+      if (!unique_identifier)
+        return std::unexpected{ unique_identifier.error() };
+      return makeNode<VariableASTNode>(*unique_identifier);
     }
 
+    // The operator parsers are only called once the operator has been peeked.
     [[nodiscard]] std::shared_ptr<PrefixUnaryOperatorASTNode>
     parsePrefixUnaryOperator()
     {
-      if (Token const next_token{ parseNextToken() }; next_token.isTilde())
-        return std::make_shared<ComplementASTNode>();
-      else if (next_token.isHyphen())
-        return std::make_shared<NegateASTNode>();
-      else if (next_token.isExclamationPoint())
-        return std::make_shared<NotASTNode>();
-      else if (next_token.isIncrement())
-        return std::make_shared<PrefixIncrementASTNode>();
-      else if (next_token.isDecrement())
-        return std::make_shared<PrefixDecrementASTNode>();
-      else
+      switch (parseNextToken()->getKind()) {
+      case TokenKind::Tilde:
+        return makeNode<ComplementASTNode>();
+      case TokenKind::Hyphen:
+        return makeNode<NegateASTNode>();
+      case TokenKind::ExclamationPoint:
+        return makeNode<NotASTNode>();
+      case TokenKind::Increment:
+        return makeNode<PrefixIncrementASTNode>();
+      case TokenKind::Decrement:
+        return makeNode<PrefixDecrementASTNode>();
+      default:
         std::unreachable();
+      }
     }
 
-    [[nodiscard]] std::shared_ptr<ExpressionASTNode>
+    [[nodiscard]] ParseResult<std::shared_ptr<ExpressionASTNode>>
     parseFactor(VariableToTypeAndUniqueIdentifierMap &);
 
     [[nodiscard]] std::shared_ptr<PostfixUnaryOperatorASTNode>
     parsePostfixUnaryOperator()
     {
-      if (Token const next_token{ parseNextToken() }; next_token.isDecrement())
-        return std::make_shared<PostfixDecrementASTNode>();
-      else if (next_token.isIncrement())
-        return std::make_shared<PostfixIncrementASTNode>();
-      else
+      switch (parseNextToken()->getKind()) {
+      case TokenKind::Decrement:
+        return makeNode<PostfixDecrementASTNode>();
+      case TokenKind::Increment:
+        return makeNode<PostfixIncrementASTNode>();
+      default:
         std::unreachable();
+      }
     }
 
     [[nodiscard]] std::shared_ptr<BinaryOperatorASTNode> parseBinaryOperator()
     {
-      if (Token const next_token{ parseNextToken() }; next_token.isPlusSign())
-        return std::make_shared<AddASTNode>();
-      else if (next_token.isHyphen())
-        return std::make_shared<SubtractASTNode>();
-      else if (next_token.isAsterisk())
-        return std::make_shared<MultiplyASTNode>();
-      else if (next_token.isForwardSlash())
-        return std::make_shared<DivideASTNode>();
-      else if (next_token.isPercentSign())
-        return std::make_shared<ModuloASTNode>();
-      else if (next_token.isBitwiseAnd())
-        return std::make_shared<BitwiseAndASTNode>();
-      else if (next_token.isBitwiseOr())
-        return std::make_shared<BitwiseOrASTNode>();
-      else if (next_token.isBitwiseXor())
-        return std::make_shared<BitwiseXorASTNode>();
-      else if (next_token.isLeftShift())
-        return std::make_shared<LeftShiftASTNode>();
-      else if (next_token.isRightShift())
-        return std::make_shared<RightShiftASTNode>();
-      else if (next_token.isDoubleAmpersand())
-        return std::make_shared<AndASTNode>();
-      else if (next_token.isDoublePipe())
-        return std::make_shared<OrASTNode>();
-      else if (next_token.isEqualTo())
-        return std::make_shared<EqualsASTNode>();
-      else if (next_token.isNotEqualTo())
-        return std::make_shared<NotEqualsASTNode>();
-      else if (next_token.isLessThan())
-        return std::make_shared<LessThanASTNode>();
-      else if (next_token.isGreaterThan())
-        return std::make_shared<GreaterThanASTNode>();
-      else if (next_token.isLessThanOrEqualTo())
-        return std::make_shared<LessThanOrEqualToASTNode>();
-      else if (next_token.isGreaterThanOrEqualTo())
-        return std::make_shared<GreaterThanOrEqualToASTNode>();
-      else
+      switch (parseNextToken()->getKind()) {
+      case TokenKind::PlusSign:
+        return makeNode<AddASTNode>();
+      case TokenKind::Hyphen:
+        return makeNode<SubtractASTNode>();
+      case TokenKind::Asterisk:
+        return makeNode<MultiplyASTNode>();
+      case TokenKind::ForwardSlash:
+        return makeNode<DivideASTNode>();
+      case TokenKind::PercentSign:
+        return makeNode<ModuloASTNode>();
+      case TokenKind::BitwiseAnd:
+        return makeNode<BitwiseAndASTNode>();
+      case TokenKind::BitwiseOr:
+        return makeNode<BitwiseOrASTNode>();
+      case TokenKind::BitwiseXor:
+        return makeNode<BitwiseXorASTNode>();
+      case TokenKind::LeftShift:
+        return makeNode<LeftShiftASTNode>();
+      case TokenKind::RightShift:
+        return makeNode<RightShiftASTNode>();
+      case TokenKind::DoubleAmpersand:
+        return makeNode<AndASTNode>();
+      case TokenKind::DoublePipe:
+        return makeNode<OrASTNode>();
+      case TokenKind::EqualTo:
+        return makeNode<EqualsASTNode>();
+      case TokenKind::NotEqualTo:
+        return makeNode<NotEqualsASTNode>();
+      case TokenKind::LessThan:
+        return makeNode<LessThanASTNode>();
+      case TokenKind::GreaterThan:
+        return makeNode<GreaterThanASTNode>();
+      case TokenKind::LessThanOrEqualTo:
+        return makeNode<LessThanOrEqualToASTNode>();
+      case TokenKind::GreaterThanOrEqualTo:
+        return makeNode<GreaterThanOrEqualToASTNode>();
+      default:
         std::unreachable();
+      }
     }
 
     [[nodiscard]] std::shared_ptr<BasicAssignmentOperatorASTNode>
     parseAssignmentOperator()
     {
-      if (Token const next_token{ parseNextToken() }; next_token.isAssignment())
-        return std::make_shared<AssignmentOperatorASTNode>();
-      else if (next_token.isAddAssignment())
-        return std::make_shared<AddAssignmentOperatorASTNode>();
-      else if (next_token.isSubtractAssignment())
-        return std::make_shared<SubtractAssignmentOperatorASTNode>();
-      else if (next_token.isMultiplyAssignment())
-        return std::make_shared<MultiplyAssignmentOperatorASTNode>();
-      else if (next_token.isDivideAssignment())
-        return std::make_shared<DivideAssignmentOperatorASTNode>();
-      else if (next_token.isModuloAssignment())
-        return std::make_shared<ModuloAssignmentOperatorASTNode>();
-      else if (next_token.isBitwiseAndAssignment())
-        return std::make_shared<BitwiseAndAssignmentOperatorASTNode>();
-      else if (next_token.isBitwiseOrAssignment())
-        return std::make_shared<BitwiseOrAssignmentOperatorASTNode>();
-      else if (next_token.isBitwiseXorAssignment())
-        return std::make_shared<BitwiseXorAssignmentOperatorASTNode>();
-      else if (next_token.isLeftShiftAssignment())
-        return std::make_shared<LeftShiftAssignmentOperatorASTNode>();
-      else if (next_token.isRightShiftAssignment())
-        return std::make_shared<RightShiftAssignmentOperatorASTNode>();
-      else
+      switch (parseNextToken()->getKind()) {
+      case TokenKind::Assignment:
+        return makeNode<AssignmentOperatorASTNode>();
+      case TokenKind::AddAssignment:
+        return makeNode<AddAssignmentOperatorASTNode>();
+      case TokenKind::SubtractAssignment:
+        return makeNode<SubtractAssignmentOperatorASTNode>();
+      case TokenKind::MultiplyAssignment:
+        return makeNode<MultiplyAssignmentOperatorASTNode>();
+      case TokenKind::DivideAssignment:
+        return makeNode<DivideAssignmentOperatorASTNode>();
+      case TokenKind::ModuloAssignment:
+        return makeNode<ModuloAssignmentOperatorASTNode>();
+      case TokenKind::BitwiseAndAssignment:
+        return makeNode<BitwiseAndAssignmentOperatorASTNode>();
+      case TokenKind::BitwiseOrAssignment:
+        return makeNode<BitwiseOrAssignmentOperatorASTNode>();
+      case TokenKind::BitwiseXorAssignment:
+        return makeNode<BitwiseXorAssignmentOperatorASTNode>();
+      case TokenKind::LeftShiftAssignment:
+        return makeNode<LeftShiftAssignmentOperatorASTNode>();
+      case TokenKind::RightShiftAssignment:
+        return makeNode<RightShiftAssignmentOperatorASTNode>();
+      default:
         std::unreachable();
+      }
     }
 
-    [[nodiscard]] std::shared_ptr<ExpressionASTNode> parseExpression(
-      std::size_t                           min_precedence,
+    [[nodiscard]] ParseResult<std::shared_ptr<ExpressionASTNode>>
+    parseExpression(
+      std::size_t const                     min_precedence,
       VariableToTypeAndUniqueIdentifierMap &map
     )
-    try {
-      std::shared_ptr<ExpressionASTNode> left_operand{ parseFactor(map) };
-      Token                              next_token{ peekNextToken() };
-      while (next_token.isBinaryOperatorToken()
-             && next_token.getPrecedence() >= min_precedence) {
-        if (next_token.isBasicAssignment()) {
-          if (auto const &variable{
-                std::dynamic_pointer_cast<VariableASTNode>(left_operand) };
-              variable) {
+    {
+      return parseNonTerminal(
+        "expression",
+        [this, min_precedence, &map]()
+          -> ParseResult<std::shared_ptr<ExpressionASTNode>> {
+        auto left_operand{ parseFactor(map) };
+        if (!left_operand) return left_operand;
+        auto next_token{ peekNextToken() };
+        if (!next_token) return std::unexpected{ next_token.error() };
+        while (next_token->isBinaryOperatorToken()
+               && next_token->getPrecedence() >= min_precedence) {
+          if (next_token->isBasicAssignment()) {
+            auto const variable{
+              std::dynamic_pointer_cast<VariableASTNode>(*left_operand)
+            };
+            if (!variable) return failParse(InvalidLValueError(*left_operand));
             std::shared_ptr<BasicAssignmentOperatorASTNode> const
-              assign_operator{ parseAssignmentOperator() };
-            std::shared_ptr<ExpressionASTNode> const right_operand{
-              parseExpression(next_token.getPrecedence(), map)
+                       assign_operator{ parseAssignmentOperator() };
+            auto const right_operand{
+              parseExpression(next_token->getPrecedence(), map)
             };
-            left_operand = std::make_shared<AssignmentASTNode>(
+            if (!right_operand) return right_operand;
+            left_operand = makeNode<AssignmentASTNode>(
               assign_operator,
               variable,
-              right_operand
+              *right_operand
             );
-          } else
-            throw InvalidLValueError(left_operand);
-        } else {
-          std::shared_ptr<BinaryOperatorASTNode> const binary_operator{
-            parseBinaryOperator()
-          };
-          std::shared_ptr<ExpressionASTNode> const right_operand{
-            parseExpression(next_token.getPrecedence() + 1, map)
-          };
-          left_operand = std::make_shared<BinaryExpressionASTNode>(
-            binary_operator,
-            left_operand,
-            right_operand
-          );
+          } else {
+            std::shared_ptr<BinaryOperatorASTNode> const binary_operator{
+              parseBinaryOperator()
+            };
+            auto const right_operand{
+              parseExpression(next_token->getPrecedence() + 1, map)
+            };
+            if (!right_operand) return right_operand;
+            left_operand = makeNode<BinaryExpressionASTNode>(
+              binary_operator,
+              *left_operand,
+              *right_operand
+            );
+          }
+          next_token = peekNextToken();
+          if (!next_token) return std::unexpected{ next_token.error() };
         }
-        next_token = peekNextToken();
+        return left_operand;
       }
-      return left_operand;
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("expression", error);
+      );
     }
 
-    [[nodiscard]] std::shared_ptr<TypeASTNode>
+    [[nodiscard]] ParseResult<std::shared_ptr<TypeASTNode>>
     parseType(TypeAliasToTypeMap const &map)
-    try {
-      Token token{ parseNextToken() };
-      if (token.isIntKeyword())
-        return std::make_shared<IntTypeASTNode>();
-      else if (token.isVoidKeyword())
-        return std::make_shared<VoidTypeASTNode>();
-      else
-        return map.getType(token.getIdentifier()->getName());
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("type", error);
+    {
+      return parseNonTerminal(
+        "type",
+        [this, &map]() -> ParseResult<std::shared_ptr<TypeASTNode>> {
+        auto const token{ parseNextToken() };
+        if (!token) return std::unexpected{ token.error() };
+        if (token->getKind() == TokenKind::IntKeyword)
+          return makeNode<IntTypeASTNode>();
+        else if (token->getKind() == TokenKind::VoidKeyword)
+          return makeNode<VoidTypeASTNode>();
+        auto const alias{ getSymbol(*token) };
+        if (!alias) return std::unexpected{ alias.error() };
+        return map.getType(*alias);
+      }
+      );
     }
 
-    [[nodiscard]] std::shared_ptr<BlockItemASTNode> parseDeclaration(
+    [[nodiscard]] ParseResult<std::shared_ptr<BlockItemASTNode>>
+    parseDeclaration(
       std::string_view                current_function_name,
       SemanticAnalysisIdentifierInfo &info
     )
-    try {
-      std::shared_ptr<TypeASTNode> const type{
-        parseType(info.getTypeAliasToTypeMap())
-      };
-      std::string const variable{ parseIdentifierToken()->getName() };
-      if (info.getTypeAliasToTypeMap().contains(variable)) {
-        throw SymbolTypeRedefinitionError(variable, "type", "variable");
-      }
-      if (info.getVariableToTypeAndUniqueIdentifierMap().contains(variable)) {
-        throw VariableRedeclarationError(variable);
-      }
-      info.getVariableToTypeAndUniqueIdentifierMap()
-        .assignTypeAndUniqueIdentifier(variable, current_function_name, type);
-      std::shared_ptr<ExpressionASTNode> expression{};
-      if (Token const next_token{ peekNextToken() };
-          next_token.isAssignment()) {
-        expect(Token(std::make_shared<AssignmentToken>()));
-        expression
-          = parseExpression(0, info.getVariableToTypeAndUniqueIdentifierMap());
+    {
+      return parseNonTerminal(
+        "declaration",
+        [this, current_function_name, &info]()
+          -> ParseResult<std::shared_ptr<BlockItemASTNode>> {
+        auto &variables{ info.getVariableToTypeAndUniqueIdentifierMap() };
+        auto const type{ parseType(info.getTypeAliasToTypeMap()) };
+        if (!type) return std::unexpected{ type.error() };
+        auto const variable{ parseIdentifierToken() };
+        if (!variable) return std::unexpected{ variable.error() };
+        if (info.getTypeAliasToTypeMap().contains(*variable)) {
+          return failParse(SymbolTypeRedefinitionError(
+            string_interner->getString(*variable),
+            "type",
+            "variable"
+          ));
+        }
+        if (variables.contains(*variable)) {
+          return failParse(
+            VariableRedeclarationError(string_interner->getString(*variable))
+          );
+        }
+        variables.assignTypeAndUniqueIdentifier(
+          *variable,
+          current_function_name,
+          *type
+        );
+        std::shared_ptr<ExpressionASTNode> expression{};
+        auto const has_initializer{ accept(TokenKind::Assignment) };
+        if (!has_initializer) return std::unexpected{ has_initializer.error() };
+        if (*has_initializer) {
+          auto const initializer{ parseExpression(0, variables) };
+          if (!initializer) return std::unexpected{ initializer.error() };
+          expression = *initializer;
+        }
+        if (auto const semicolon{ expect(TokenKind::Semicolon) }; !semicolon)
+          return std::unexpected{ semicolon.error() };
+        auto const unique_identifier{ variables.getUniqueIdentifier(*variable
+        ) };
+        if (!unique_identifier)
+          return std::unexpected{ unique_identifier.error() };
+        return makeNode<DeclarationASTNode>(
+          *type,
+          *unique_identifier,
+          expression
+        );
       }
-      expect(Token(std::make_shared<SemicolonToken>()));
-      return std::make_shared<DeclarationASTNode>(
-        type,
-        info.getVariableToTypeAndUniqueIdentifierMap().getUniqueIdentifier(
-          variable
-        ),
-        expression
       );
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("declaration", error);
     }
 
-    [[nodiscard]] std::shared_ptr<BlockItemASTNode> parseNullStatement()
-    try {
-      expect(Token(std::make_shared<SemicolonToken>()));
-      return std::make_shared<NullStatementASTNode>();
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("null statement", error);
+    [[nodiscard]] ParseResult<std::shared_ptr<BlockItemASTNode>>
+    parseNullStatement()
+    {
+      return parseNonTerminal(
+        "null statement",
+        [this]() -> ParseResult<std::shared_ptr<BlockItemASTNode>> {
+        if (auto const semicolon{ expect(TokenKind::Semicolon) }; !semicolon)
+          return std::unexpected{ semicolon.error() };
+        return makeNode<NullStatementASTNode>();
+      }
+      );
     }
 
-    [[nodiscard]] std::shared_ptr<BlockItemASTNode>
+    [[nodiscard]] ParseResult<std::shared_ptr<BlockItemASTNode>>
     parseReturnStatement(VariableToTypeAndUniqueIdentifierMap &map)
-    try {
-      expect(Token(std::make_shared<ReturnKeywordToken>()));
-      std::shared_ptr<ExpressionASTNode> const expression{
-        parseExpression(0, map)
-      };
-      expect(Token(std::make_shared<SemicolonToken>()));
-      return std::make_shared<ReturnStatementASTNode>(expression);
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("return statement", error);
+    {
+      return parseNonTerminal(
+        "return statement",
+        [this, &map]() -> ParseResult<std::shared_ptr<BlockItemASTNode>> {
+        if (auto const keyword{ expect(TokenKind::ReturnKeyword) }; !keyword)
+          return std::unexpected{ keyword.error() };
+        auto const expression{ parseExpression(0, map) };
+        if (!expression) return std::unexpected{ expression.error() };
+        if (auto const semicolon{ expect(TokenKind::Semicolon) }; !semicolon)
+          return std::unexpected{ semicolon.error() };
+        return makeNode<ReturnStatementASTNode>(*expression);
+      }
+      );
     }
 
-    [[nodiscard]] std::shared_ptr<BlockItemASTNode>
+    [[nodiscard]] ParseResult<std::shared_ptr<BlockItemASTNode>>
     parseExpressionStatement(VariableToTypeAndUniqueIdentifierMap &map)
-    try {
-      std::shared_ptr<ExpressionASTNode> const expression{
-        parseExpression(0, map)
-      };
-      expect(Token(std::make_shared<SemicolonToken>()));
-      return std::make_shared<ExpressionStatementASTNode>(expression);
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("expression statement", error);
+    {
+      return parseNonTerminal(
+        "expression statement",
+        [this, &map]() -> ParseResult<std::shared_ptr<BlockItemASTNode>> {
+        auto const expression{ parseExpression(0, map) };
+        if (!expression) return std::unexpected{ expression.error() };
+        if (auto const semicolon{ expect(TokenKind::Semicolon) }; !semicolon)
+          return std::unexpected{ semicolon.error() };
+        return makeNode<ExpressionStatementASTNode>(*expression);
+      }
+      );
     }
 
-    void parseTypeAlias(
+    [[nodiscard]] ParseResult<void> parseTypeAlias(
       std::shared_ptr<TypeASTNode>    type,
       SemanticAnalysisIdentifierInfo &info
     )
     {
-      Token const token{ parseNextToken() };
-      if (token.isKeyword())
-        throw InvalidTypeAliasError(token.getKeyword()->toString());
-      std::string const identifier{ token.getIdentifier()->getName() };
-      if (info.getVariableToTypeAndUniqueIdentifierMap().contains(identifier)) {
-        throw SymbolTypeRedefinitionError(identifier, "variable", "type");
+      auto const token{ parseNextToken() };
+      if (!token) return std::unexpected{ token.error() };
+      if (token->isKeyword())
+        return failParse(InvalidTypeAliasError(token->toString()));
+      auto const identifier{ getSymbol(*token) };
+      if (!identifier) return std::unexpected{ identifier.error() };
+      if (info.getVariableToTypeAndUniqueIdentifierMap().contains(*identifier)
+      ) {
+        return failParse(SymbolTypeRedefinitionError(
+          token->getIdentifier(),
+          "variable",
+          "type"
+        ));
       }
-      if (info.getTypeAliasToTypeMap().contains(identifier)) {
-        if (*type != *info.getTypeAliasToTypeMap().getType(identifier)) {
-          throw TypeRedefinitionError(
-            identifier,
-            info.getTypeAliasToTypeMap().getType(identifier)->toString(),
+      if (info.getTypeAliasToTypeMap().contains(*identifier)) {
+        auto const aliased_type{
+          *info.getTypeAliasToTypeMap().getType(*identifier)
+        };
+        if (*type != *aliased_type) {
+          return failParse(TypeRedefinitionError(
+            token->getIdentifier(),
+            aliased_type->toString(),
             type->toString()
-          );
+          ));
         }
       }
-      info.getTypeAliasToTypeMap().aliasType(type, identifier);
+      info.getTypeAliasToTypeMap().aliasType(type, *identifier);
+      return {};
     }
 
-    void parseCommaAndTypeAlias(
+    [[nodiscard]] ParseResult<void> parseCommaAndTypeAlias(
       std::shared_ptr<TypeASTNode>    type,
       SemanticAnalysisIdentifierInfo &info
     )
     {
-      expect(Token(std::make_shared<CommaToken>()));
-      parseTypeAlias(type, info);
+      if (auto const comma{ expect(TokenKind::Comma) }; !comma) return comma;
+      return parseTypeAlias(type, info);
     }
 
-    void parseTypedefTail(
+    [[nodiscard]] ParseResult<void> parseTypedefTail(
       std::shared_ptr<TypeASTNode>    type,
       SemanticAnalysisIdentifierInfo &info
     )
     {
-      Token next_token{};
-      parseTypeAlias(type, info);
-      while (!(next_token = peekNextToken()).isSemicolon()) {
-        parseCommaAndTypeAlias(type, info);
-      }
-      expect(Token(std::make_shared<SemicolonToken>()));
-    }
-
-    void parseTypedef(SemanticAnalysisIdentifierInfo &info)
-    try {
-      expect(Token(std::make_shared<TypedefKeywordToken>()));
-      Token                        next_token{ peekNextToken() };
-      std::shared_ptr<TypeASTNode> aliased_type{};
-      if (next_token.isType())
-        aliased_type = parseType(info.getTypeAliasToTypeMap());
-      else {
-        std::string const aliased_aliased_type{ parseIdentifierToken()->getName(
-        ) };
-        if (!info.getTypeAliasToTypeMap().contains(aliased_aliased_type)) {
-          throw UnknownTypeNameError(aliased_aliased_type);
-        } else
-          aliased_type
-            = info.getTypeAliasToTypeMap().getType(aliased_aliased_type);
+      if (auto const alias{ parseTypeAlias(type, info) }; !alias) return alias;
+      while (true) {
+        auto const finished{ accept(TokenKind::Semicolon) };
+        if (!finished) return std::unexpected{ finished.error() };
+        if (*finished) return {};
+        if (auto const alias{ parseCommaAndTypeAlias(type, info) }; !alias)
+          return alias;
       }
-      parseTypedefTail(aliased_type, info);
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("typedef", error);
     }
 
-    [[nodiscard]] std::shared_ptr<BlockItemASTNode> parseBlockItem(
+    [[nodiscard]] ParseResult<void>
+    parseTypedef(SemanticAnalysisIdentifierInfo &info)
+    {
+      return parseNonTerminal("typedef", [this, &info]() -> ParseResult<void> {
+        if (auto const keyword{ expect(TokenKind::TypedefKeyword) }; !keyword)
+          return keyword;
+        auto const next_token{ peekNextToken() };
+        if (!next_token) return std::unexpected{ next_token.error() };
+        auto const aliased_type{
+          [this, &next_token, &info]()
+            -> ParseResult<std::shared_ptr<TypeASTNode>> {
+          if (next_token->isType())
+            return parseType(info.getTypeAliasToTypeMap());
+          auto const aliased_aliased_type{ parseIdentifierToken() };
+          if (!aliased_aliased_type)
+            return std::unexpected{ aliased_aliased_type.error() };
+          return info.getTypeAliasToTypeMap().getType(*aliased_aliased_type);
+        }()
+        };
+        if (!aliased_type) return std::unexpected{ aliased_type.error() };
+        return parseTypedefTail(*aliased_type, info);
+      });
+    }
+
+    [[nodiscard]] ParseResult<std::shared_ptr<BlockItemASTNode>> parseBlockItem(
       std::string_view                current_function_name,
       SemanticAnalysisIdentifierInfo &info
     )
-    try {
-      // Use nullptr for first member of return value to indicate no node parsed
-      if (Token next_token{ peekNextToken() }; next_token.isSemicolon()) {
-        return parseNullStatement();
-      } else if (next_token.isReturnKeyword()) {
-        return parseReturnStatement(
-          info.getVariableToTypeAndUniqueIdentifierMap()
-        );
-      } else if (next_token.isTypedefKeyword()) {
-        parseTypedef(info);
-        return nullptr;
-      } else if (next_token.isType() || (next_token.isIdentifier() && info.getTypeAliasToTypeMap().contains(next_token.getIdentifier()->getName()))) {
-        return parseDeclaration(current_function_name, info);
-      } else
-        return parseExpressionStatement(
-          info.getVariableToTypeAndUniqueIdentifierMap()
-        );
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("block item", error);
+    {
+      return parseNonTerminal(
+        "block item",
+        [this, current_function_name, &info]()
+          -> ParseResult<std::shared_ptr<BlockItemASTNode>> {
+        auto const next_token{ peekNextToken() };
+        if (!next_token) return std::unexpected{ next_token.error() };
+        // Use nullptr for first member of return value to indicate no node
+        // parsed
+        if (next_token->getKind() == TokenKind::Semicolon) {
+          return parseNullStatement();
+        } else if (next_token->getKind() == TokenKind::ReturnKeyword) {
+          return parseReturnStatement(
+            info.getVariableToTypeAndUniqueIdentifierMap()
+          );
+        } else if (next_token->getKind() == TokenKind::TypedefKeyword) {
+          if (auto const parsed_typedef{ parseTypedef(info) }; !parsed_typedef)
+            return std::unexpected{ parsed_typedef.error() };
+          return nullptr;
+        } else if (next_token->isType()
+                   || (next_token->getKind() == TokenKind::Identifier
+                       && info.getTypeAliasToTypeMap().contains(
+                         next_token->getSymbol()
+                       ))) {
+          return parseDeclaration(current_function_name, info);
+        } else
+          return parseExpressionStatement(
+            info.getVariableToTypeAndUniqueIdentifierMap()
+          );
+      }
+      );
     }
 
-    [[nodiscard]] std::shared_ptr<FunctionASTNode>
+    [[nodiscard]] ParseResult<std::shared_ptr<FunctionASTNode>>
     parseFunction(SemanticAnalysisIdentifierInfo &info)
-    try {
-      expect(Token(std::make_shared<IntKeywordToken>()));
-      std::string const function_name{ parseIdentifierToken()->getName() };
-      expect(Token(std::make_shared<LeftParenthesisToken>()));
-      expect(Token(std::make_shared<VoidKeywordToken>()));
-      expect(Token(std::make_shared<RightParenthesisToken>()));
-      expect(Token(std::make_shared<LeftCurlyBraceToken>()));
-      std::vector<std::shared_ptr<BlockItemASTNode>> const block_items{
-        [this, &function_name, &info]() {
+    {
+      return parseNonTerminal(
+        "function",
+        [this, &info]() -> ParseResult<std::shared_ptr<FunctionASTNode>> {
+        if (auto const keyword{ expect(TokenKind::IntKeyword) }; !keyword)
+          return std::unexpected{ keyword.error() };
+        auto const name{ parseIdentifierToken() };
+        if (!name) return std::unexpected{ name.error() };
+        std::string_view const function_name{
+          string_interner->getString(*name)
+        };
+        for (TokenKind const kind:
+             { TokenKind::LeftParenthesis,
+               TokenKind::VoidKeyword,
+               TokenKind::RightParenthesis,
+               TokenKind::LeftCurlyBrace })
+          if (auto const token{ expect(kind) }; !token)
+            return std::unexpected{ token.error() };
         std::vector<std::shared_ptr<BlockItemASTNode>> block_items{};
-        for (Token next_token{ peekNextToken() };
-             !next_token.isRightCurlyBrace();
-             next_token = peekNextToken()) {
+        while (true) {
+          auto const next_token{ peekNextToken() };
+          if (!next_token) return std::unexpected{ next_token.error() };
+          if (next_token->getKind() == TokenKind::RightCurlyBrace) break;
           auto block_item{ parseBlockItem(function_name, info) };
-          if (block_item) block_items.push_back(std::move(block_item));
+          if (!block_item) return std::unexpected{ block_item.error() };
+          if (*block_item) block_items.push_back(std::move(*block_item));
         }
-        return block_items;
-      }()
-      };
-      expect(Token(std::make_shared<RightCurlyBraceToken>()));
-      return std::make_shared<FunctionASTNode>(
-        function_name,
-        std::move(block_items)
+        if (auto const brace{ expect(TokenKind::RightCurlyBrace) }; !brace)
+          return std::unexpected{ brace.error() };
+        return makeNode<FunctionASTNode>(function_name, std::move(block_items));
+      }
       );
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("function", error);
     }
 
     public:
-    Parser(Lexer &lexer): lexer{ lexer } {}
+    Parser(Lexer &lexer)
+      : own_token_buffer{ std::in_place, lexer }
+      , token_buffer{ &*own_token_buffer }
+      , string_interner{ lexer.getStringInterner() }
+    {}
+
+    // The tokens must outlive the parser.
+    explicit Parser(TokenBuffer const &tokens)
+      : token_buffer{ &tokens }
+      , string_interner{ tokens.getStringInterner() }
+    {}
+
+    // The tokens must have been lexed with the context's interner.
+    Parser(TokenBuffer const &tokens, CompilationContext &context)
+      : token_buffer{ &tokens }
+      , string_interner{ context.getStringInterner() }
+      , declaration_count{ &context.getDeclarationCount() }
+    {}
+
+    Parser(TokenBuffer &&)                       = delete;
+    Parser(TokenBuffer &&, CompilationContext &) = delete;
+
+    Parser(Parser const &)            = delete;
+    Parser &operator=(Parser const &) = delete;
+
+    // Returns why the program is invalid instead of throwing it, for callers
+    // that reject many programs, such as linters and fuzzers.
+    [[nodiscard]] ParseResult<std::shared_ptr<ProgramASTNode>> tryParseProgram()
+    {
+      return parseNonTerminal(
+        "program",
+        [this]() -> ParseResult<std::shared_ptr<ProgramASTNode>> {
+        SemanticAnalysisIdentifierInfo info{ *string_interner,
+                                             *declaration_count };
+        auto const                     function{ parseFunction(info) };
+        if (!function) return std::unexpected{ function.error() };
+        auto const program{
+          makeNode<ProgramASTNode>(*function, string_interner)
+        };
+        if (auto const finished{ expectFinished() }; !finished)
+          return std::unexpected{ finished.error() };
+        return program;
+      }
+      );
+    }
 
     [[nodiscard]] std::shared_ptr<ProgramASTNode> parseProgram()
-    try {
-      SemanticAnalysisIdentifierInfo info{};
-      auto const program{ std::make_shared<ProgramASTNode>(parseFunction(info)
-      ) };
-      expectFinished();
-      return program;
-    } catch (ParserError const &error) {
-      throw ParserNonTerminalError("program", error);
+    {
+      auto program{ tryParseProgram() };
+      if (!program) throw ParserNonTerminalError(program.error());
+      return std::move(*program);
     }
   };
 } // namespace SC2
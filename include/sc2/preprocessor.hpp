@@ -0,0 +1,191 @@
+#ifndef SC2_PREPROCESSOR_HPP_INCLUDED
+#define SC2_PREPROCESSOR_HPP_INCLUDED
+
+#include <sc2/compiler_error.hpp>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SC2 {
+  class PreprocessorError: public CompilerError
+  {
+    std::string const message{};
+
+    public:
+    PreprocessorError(std::string_view problem)
+      : message{ std::format("Preprocessor error: {}", problem) }
+    {}
+
+    constexpr virtual char const *what() const noexcept final override
+    {
+      return message.c_str();
+    }
+  };
+
+  enum class PreprocessingTokenKind : std::uint8_t
+  {
+    Identifier,
+    Number,
+    CharacterConstant,
+    StringLiteral,
+    Punctuator,
+    Other,
+    // A ## operator in a macro body.
+    Paste,
+    // An empty macro argument next to a ## operator.
+    Placemarker,
+    // Marks where the expansion of a macro ends while it is rescanned.
+    EndOfExpansion
+  };
+
+  struct PreprocessingToken
+  {
+    std::string_view       spelling{};
+    PreprocessingTokenKind kind{};
+    bool                   has_leading_space{};
+    bool                   starts_line{};
+    // An identifier that named a macro while that macro was being expanded,
+    // which is never expanded again.
+    bool                   is_painted{};
+  };
+
+  // Preprocesses one translation unit in process. It splices lines, replaces
+  // comments, expands macros, evaluates conditional directives and pastes in
+  // included files, producing the text the lexer scans. A file wrapped in an
+  // include guard is not read again while its guard macro is defined.
+  class Preprocessor
+  {
+    struct Macro
+    {
+      std::vector<PreprocessingToken> body{};
+      std::vector<std::string_view>   parameters{};
+      bool                            is_function_like{};
+      bool                            is_variadic{};
+    };
+
+    struct Conditional
+    {
+      bool is_active{};
+      bool has_taken_branch{};
+      bool has_seen_else{};
+    };
+
+    // Whether the file read so far consists of #ifndef NAME ... #endif with
+    // nothing but blank lines around it.
+    struct IncludeGuard
+    {
+      std::optional<std::string_view> name{};
+      std::size_t                     depth{};
+      bool                            is_closed{};
+      bool                            is_possible{ true };
+    };
+
+    using Arguments = std::vector<std::vector<PreprocessingToken>>;
+
+    std::vector<std::filesystem::path>                include_directories{};
+    // The text that token spellings refer to.
+    std::deque<std::string>                           buffers{};
+    std::unordered_map<std::string_view, Macro>       macros{};
+    std::unordered_map<std::string, std::string_view> include_guards{};
+    std::unordered_set<std::string>                   once_only_files{};
+    std::vector<Conditional>                          conditionals{};
+    std::vector<PreprocessingToken>                   pending_text{};
+    std::string                                       output{};
+    std::filesystem::path                             current_file{};
+    std::size_t                                       current_line{};
+    std::size_t                                       include_depth{};
+    std::size_t                                       read_file_count{};
+
+    [[noreturn]] void fail(std::string_view problem) const;
+
+    [[nodiscard]] bool isActive() const noexcept
+    {
+      return conditionals.empty() || conditionals.back().is_active;
+    }
+
+    void processFile(std::filesystem::path const &path, std::string_view text);
+
+    void flushText();
+
+    void handleDirective(
+      std::span<PreprocessingToken const> tokens,
+      IncludeGuard                       &guard
+    );
+
+    void handleConditional(
+      std::string_view                    directive,
+      std::span<PreprocessingToken const> arguments,
+      IncludeGuard                       &guard
+    );
+
+    void defineMacro(std::span<PreprocessingToken const> tokens);
+
+    void includeFile(std::span<PreprocessingToken const> tokens);
+
+    [[nodiscard]] std::optional<std::filesystem::path>
+    findIncludeFile(std::string_view name, bool is_angled) const;
+
+    [[nodiscard]] bool
+    evaluateCondition(std::span<PreprocessingToken const> tokens);
+
+    [[nodiscard]] std::vector<PreprocessingToken> expand(
+      std::vector<PreprocessingToken> tokens,
+      std::vector<std::string_view>   active_macros
+    );
+
+    [[nodiscard]] Arguments collectArguments(
+      std::vector<PreprocessingToken> &pending,
+      std::vector<std::string_view>   &active_macros,
+      std::string_view                 name
+    );
+
+    [[nodiscard]] std::vector<PreprocessingToken> substitute(
+      Macro const                         &macro,
+      Arguments const                     &arguments,
+      std::vector<std::string_view> const &active_macros
+    );
+
+    [[nodiscard]] PreprocessingToken paste(
+      PreprocessingToken const &left,
+      PreprocessingToken const &right
+    );
+
+    [[nodiscard]] PreprocessingToken stringize(
+      std::span<PreprocessingToken const> argument,
+      bool                                has_leading_space
+    );
+
+    public:
+    explicit Preprocessor(
+      std::vector<std::filesystem::path> include_directories = {}
+    );
+
+    // Defines a macro as -D does, from NAME or NAME(PARAMETERS) and its
+    // replacement text.
+    void defineMacro(std::string_view name, std::string_view replacement);
+
+    [[nodiscard]] std::string preprocessFile(std::filesystem::path const &path);
+
+    // Preprocesses source text, resolving quoted includes against the
+    // directory of the path it is given.
+    [[nodiscard]] std::string
+    preprocess(std::string_view text, std::filesystem::path const &path);
+
+    [[nodiscard]] constexpr std::size_t getReadFileCount() const noexcept
+    {
+      return read_file_count;
+    }
+  };
+} // namespace SC2
+
+#endif
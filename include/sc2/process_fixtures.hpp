@@ -0,0 +1,95 @@
+#ifndef PROCESS_FIXTURES_HPP_INCLUDED
+#define PROCESS_FIXTURES_HPP_INCLUDED
+
+#include <string_view>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+
+extern char **environ;
+
+struct ProcessMeasurement
+{
+  // From spawning the process to reaping it.
+  std::chrono::nanoseconds elapsed{};
+  ::rusage                 usage{};
+};
+
+// Runs the executable with the arguments, its output discarded and, if there
+// is one, the standard input fed through a pipe. Returns how long it took and
+// the resources it used, or nothing if it failed.
+[[nodiscard]] inline std::optional<ProcessMeasurement> measureProcess(
+  char const * const                        executable,
+  std::initializer_list<char const *> const arguments,
+  std::optional<std::string_view> const     standard_input = std::nullopt
+)
+{
+  std::vector<char *> argv{ const_cast<char *>(executable) };
+  for (auto const *const argument: arguments)
+    argv.push_back(const_cast<char *>(argument));
+  argv.push_back(nullptr);
+  int input_pipe[2]{ -1, -1 };
+  if (standard_input && ::pipe2(input_pipe, O_CLOEXEC) < 0)
+    return std::nullopt;
+  ::posix_spawn_file_actions_t file_actions{};
+  ::posix_spawn_file_actions_init(&file_actions);
+  ::posix_spawn_file_actions_addopen(
+    &file_actions,
+    STDOUT_FILENO,
+    "/dev/null",
+    O_WRONLY,
+    0
+  );
+  if (standard_input)
+    ::posix_spawn_file_actions_adddup2(
+      &file_actions,
+      input_pipe[0],
+      STDIN_FILENO
+    );
+  auto const start{ std::chrono::steady_clock::now() };
+  ::pid_t    child{};
+  int const  spawn_error{ ::posix_spawn(
+    &child,
+    executable,
+    &file_actions,
+    nullptr,
+    argv.data(),
+    environ
+  ) };
+  ::posix_spawn_file_actions_destroy(&file_actions);
+  if (standard_input) {
+    ::close(input_pipe[0]);
+    std::string_view remaining{ spawn_error == 0 ? *standard_input : "" };
+    while (!remaining.empty()) {
+      ::ssize_t const written{
+        ::write(input_pipe[1], remaining.data(), remaining.size())
+      };
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        break;
+      }
+      remaining.remove_prefix(static_cast<std::size_t>(written));
+    }
+    ::close(input_pipe[1]);
+  }
+  if (spawn_error != 0) return std::nullopt;
+  int                status{};
+  ProcessMeasurement measurement{};
+  while (::wait4(child, &status, 0, &measurement.usage) < 0)
+    if (errno != EINTR) return std::nullopt;
+  measurement.elapsed = std::chrono::steady_clock::now() - start;
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return std::nullopt;
+  return measurement;
+}
+
+#endif
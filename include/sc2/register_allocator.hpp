@@ -0,0 +1,79 @@
+#ifndef SC2_REGISTER_ALLOCATOR_HPP_INCLUDED
+#define SC2_REGISTER_ALLOCATOR_HPP_INCLUDED
+
+#include <sc2/assembly_ast.hpp>
+#include <unordered_set>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace SC2 {
+  // Chaitin-Briggs graph-colouring register allocation over the instructions
+  // of one function, before its pseudo-registers are replaced. The hard
+  // registers are the first hard_register_count nodes of the interference
+  // graph and the pseudo-registers follow them. Moves are coalesced
+  // conservatively, and the nodes that cannot be coloured are the ones with the
+  // fewest occurrences per interference.
+  class RegisterAllocator
+  {
+    struct BasicBlock
+    {
+      std::size_t                first_instruction{};
+      std::size_t                last_instruction{};
+      std::vector<std::size_t>   successors{};
+      std::vector<std::uint32_t> uses{};
+      std::vector<std::uint32_t> definitions{};
+      std::vector<std::uint32_t> live_in{};
+      std::vector<std::uint32_t> live_out{};
+    };
+
+    struct Move
+    {
+      std::uint32_t source{};
+      std::uint32_t destination{};
+    };
+
+    std::vector<InstructionDataFlow>               data_flows{};
+    std::vector<BasicBlock>                        basic_blocks{};
+    std::uint32_t                                  node_count{};
+    std::vector<std::unordered_set<std::uint32_t>> interferences{};
+    std::vector<Move>                              moves{};
+    std::vector<std::uint32_t>                     occurrences{};
+    std::vector<std::uint32_t>                     aliases{};
+
+    [[nodiscard]] static constexpr bool isHardRegister(std::uint32_t node
+    ) noexcept
+    {
+      return node < hard_register_count;
+    }
+
+    [[nodiscard]] std::uint32_t getAlias(std::uint32_t node);
+
+    void buildBasicBlocks();
+
+    void computeLiveness();
+
+    void addInterference(std::uint32_t first, std::uint32_t second);
+
+    void buildInterferenceGraph();
+
+    [[nodiscard]] bool canCoalesce(std::uint32_t kept, std::uint32_t merged)
+      const;
+
+    void coalesce();
+
+    [[nodiscard]] RegisterAssignment colour();
+
+    public:
+    explicit RegisterAllocator(
+      std::span<std::shared_ptr<InstructionAssemblyASTNode> const> instructions
+    );
+
+    [[nodiscard]] RegisterAssignment allocate();
+  };
+} // namespace SC2
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef SC2_STRING_INTERNER_HPP_INCLUDED
+#define SC2_STRING_INTERNER_HPP_INCLUDED
+
+#include <string_view>
+#include <unordered_map>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+
+namespace SC2 {
+  enum class SymbolID : std::uint32_t
+  {
+  };
+
+  // Maps every distinct spelling seen during a compilation to a dense
+  // SymbolID, so that names can be compared and hashed as integers. The
+  // spellings live in a deque, which never relocates its elements, so the
+  // string_views handed out by getString() stay valid for the lifetime of the
+  // interner.
+  class StringInterner
+  {
+    std::deque<std::string>                        spellings{};
+    std::unordered_map<std::string_view, SymbolID> symbols{};
+
+    public:
+    StringInterner() = default;
+
+    StringInterner(StringInterner const &)            = delete;
+    StringInterner &operator=(StringInterner const &) = delete;
+
+    [[nodiscard]] SymbolID intern(std::string_view const spelling)
+    {
+      if (auto const symbol{ symbols.find(spelling) }; symbol != symbols.end())
+        return symbol->second;
+      SymbolID const symbol{ static_cast<SymbolID>(spellings.size()) };
+      symbols.emplace(spellings.emplace_back(spelling), symbol);
+      return symbol;
+    }
+
+    [[nodiscard]] std::string_view getString(SymbolID const symbol) const
+    {
+      return spellings[std::to_underlying(symbol)];
+    }
+
+    [[nodiscard]] std::size_t getSymbolCount() const noexcept
+    {
+      return spellings.size();
+    }
+  };
+} // namespace SC2
+
+#endif
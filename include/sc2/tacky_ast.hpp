@@ -4,7 +4,9 @@
 #include <sc2/assembly_ast.hpp>
 #include <sc2/ast.hpp>
 #include <sc2/pretty_printer_mixin.hpp>
+#include <sc2/string_interner.hpp>
 #include <sc2/utility.hpp>
+#include <sc2/virtual_register.hpp>
 #include <string_view>
 
 #include <cstdint>
@@ -56,25 +58,25 @@ namespace SC2 {
 
   class VariableTACKYASTNode final: public ValueTACKYASTNode
   {
-    std::string const identifier{};
+    VirtualRegister const virtual_register{};
 
     public:
-    explicit constexpr VariableTACKYASTNode(std::string_view identifier)
-      : identifier{ identifier }
+    explicit constexpr VariableTACKYASTNode(VirtualRegister virtual_register)
+      : virtual_register{ virtual_register }
     {}
 
     [[nodiscard]] std::shared_ptr<OperandAssemblyASTNode>
     emitAssembly() const final override;
 
-    [[nodiscard]] constexpr std::string_view getIdentifier() const noexcept
+    [[nodiscard]] constexpr VirtualRegister getVirtualRegister() const noexcept
     {
-      return identifier;
+      return virtual_register;
     }
 
-    virtual constexpr void
+    virtual void
     prettyPrintHelper(std::ostream &out, std::size_t) final override
     {
-      out << "Variable(\"" << getIdentifier() << "\")";
+      out << "Variable(\"" << getVirtualRegister().toString() << "\")";
     }
 
     virtual ~VariableTACKYASTNode() final override = default;
@@ -836,6 +838,7 @@ namespace SC2 {
   class ProgramTACKYASTNode final: public TACKYASTNode
   {
     std::shared_ptr<FunctionTACKYASTNode> function{};
+    std::shared_ptr<StringInterner const> string_interner{};
 
     [[nodiscard]] std::shared_ptr<FunctionTACKYASTNode>
     getFunction() const noexcept
@@ -844,8 +847,12 @@ namespace SC2 {
     }
 
     public:
-    explicit ProgramTACKYASTNode(std::shared_ptr<FunctionTACKYASTNode> function)
+    ProgramTACKYASTNode(
+      std::shared_ptr<FunctionTACKYASTNode> function,
+      std::shared_ptr<StringInterner const> string_interner
+    )
       : function{ function }
+      , string_interner{ std::move(string_interner) }
     {}
 
     [[nodiscard]] std::shared_ptr<ProgramAssemblyASTNode> emitAssembly() const;
@@ -0,0 +1,29 @@
+#ifndef SC2_THREAD_POOL_HPP_INCLUDED
+#define SC2_THREAD_POOL_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+
+namespace SC2 {
+  [[nodiscard]] inline std::size_t getDefaultThreadCount() noexcept
+  {
+    return std::max(std::thread::hardware_concurrency(), 1U);
+  }
+
+  // Runs task(0) through task(task_count - 1) on a work-stealing pool of
+  // threads and returns once every call has returned. The indices are dealt
+  // out to per-thread queues up front; a thread takes work from the front of
+  // its own queue and, once that is empty, steals from the back of the
+  // others', so that uneven tasks still keep every thread busy. Each task
+  // must catch its own exceptions.
+  void runOnThreadPool(
+    std::size_t                             task_count,
+    std::function<void(std::size_t)> const &task,
+    std::size_t                             thread_count
+    = getDefaultThreadCount()
+  );
+} // namespace SC2
+
+#endif
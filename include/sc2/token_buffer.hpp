@@ -0,0 +1,62 @@
+#ifndef SC2_TOKEN_BUFFER_HPP_INCLUDED
+#define SC2_TOKEN_BUFFER_HPP_INCLUDED
+
+#include <sc2/lexer.hpp>
+#include <sc2/string_interner.hpp>
+#include <sc2/tokens.hpp>
+#include <string_view>
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace SC2 {
+  // Every token of a program, lexed in a single pass into contiguous storage
+  // that the parser then walks with an index. Lexing stops at the first
+  // invalid token; the tokens before it are kept, so that the parser can
+  // still report what it made of them, and the error is kept for whoever
+  // reaches it first.
+  class TokenBuffer
+  {
+    std::shared_ptr<StringInterner>       string_interner{};
+    std::vector<Token>                    tokens{};
+    std::optional<LexerInvalidTokenError> invalid_token_error{};
+
+    public:
+    explicit TokenBuffer(
+      std::string_view                program_text,
+      std::shared_ptr<StringInterner> string_interner
+      = std::make_shared<StringInterner>()
+    );
+
+    // Takes the tokens the lexer has not produced yet.
+    explicit TokenBuffer(Lexer &lexer);
+
+    [[nodiscard]] std::shared_ptr<StringInterner> const &
+    getStringInterner() const noexcept
+    {
+      return string_interner;
+    }
+
+    [[nodiscard]] std::span<Token const> getTokens() const noexcept
+    {
+      return tokens;
+    }
+
+    // The error for the token after the last one, if lexing stopped at an
+    // invalid token rather than at the end of the program.
+    [[nodiscard]] LexerInvalidTokenError const *
+    getInvalidTokenError() const noexcept
+    {
+      return invalid_token_error ? &*invalid_token_error : nullptr;
+    }
+
+    void throwIfInvalid() const
+    {
+      if (invalid_token_error) throw *invalid_token_error;
+    }
+  };
+} // namespace SC2
+
+#endif
@@ -4,7 +4,6 @@
 #include <string_view>
 
 #include <cstddef>
-#include <format>
 #include <ostream>
 #include <string>
 
@@ -18,15 +17,15 @@ namespace SC2 {
       }
     }
 
-    static constexpr void
-    emitAssemblyEpilogue([[maybe_unused]] std::ostream &out)
+    template <typename Output>
+    static constexpr void emitAssemblyEpilogue([[maybe_unused]] Output &out)
     {
 #if defined(__linux__)
-      out << R"(.section .note.GNU-stack,"",@progbits)";
+      out << R"(.section .note.GNU-stack,"",@progbits)" << '\n';
 #endif
     }
 
-    [[nodiscard]] static constexpr std::string emitLocalLabelPrefix()
+    [[nodiscard]] static constexpr std::string_view emitLocalLabelPrefix()
     {
       return
 #if defined(__APPLE__) || defined(__MACH__)
@@ -44,17 +43,10 @@ namespace SC2 {
 #if defined(__APPLE__) || defined(__MACH__)
         "_" + std::string{ name }
 #else
-        name
+        std::string{ name }
 #endif
       ;
     }
-
-    [[nodiscard]] static std::string
-    generateFreshIdentifierWithPrefix(std::string_view identifier)
-    {
-      static std::size_t counter{};
-      return std::format("{}.{}", identifier, counter++);
-    }
   };
 } // namespace SC2
 
@@ -0,0 +1,31 @@
+#ifndef SC2_VIRTUAL_REGISTER_HPP_INCLUDED
+#define SC2_VIRTUAL_REGISTER_HPP_INCLUDED
+
+#include <string_view>
+
+#include <cstdint>
+#include <format>
+#include <string>
+
+namespace SC2 {
+  // A variable or temporary of a function, numbered densely from zero within
+  // that function. Variables carry a view of their interned unique name;
+  // temporaries carry the name of their function and are only given a name of
+  // their own, such as "main.3", when printed. The interned names are kept
+  // alive by the program node at the root of the TACKY or assembly AST.
+  struct VirtualRegister
+  {
+    std::uint32_t    index{};
+    std::string_view name{};
+    bool             is_temporary{};
+
+    [[nodiscard]] std::string toString() const
+    {
+      if (is_temporary)
+        return std::format("{}.{}", name, index);
+      return std::string{ name };
+    }
+  };
+} // namespace SC2
+
+#endif
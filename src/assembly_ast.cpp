@@ -1,218 +1,459 @@
 #include <sc2/assembly_ast.hpp>
+#include <sc2/elf_object_writer.hpp>
+#include <sc2/machine_code_buffer.hpp>
+#include <sc2/register_allocator.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace SC2 {
+  namespace {
+    [[nodiscard]] ModRMOperand
+    getModRMOperand(OperandAssemblyASTNode const &operand)
+    {
+      if (auto const modrm_operand{ operand.getModRMOperand() })
+        return *modrm_operand;
+      throw CodeEmissionError("operand that is neither a register nor memory");
+    }
+  } // namespace
+
   [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
   EAXRegisterAssemblyASTNode::toByteRegister()
   {
-    return std::make_shared<ALRegisterAssemblyASTNode>();
+    return makeNode<ALRegisterAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
   ALRegisterAssemblyASTNode::toLongWordRegister()
   {
-    return std::make_shared<EAXRegisterAssemblyASTNode>();
+    return makeNode<EAXRegisterAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
   EDXRegisterAssemblyASTNode::toByteRegister()
   {
-    return std::make_shared<DLRegisterAssemblyASTNode>();
+    return makeNode<DLRegisterAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
   DLRegisterAssemblyASTNode::toLongWordRegister()
   {
-    return std::make_shared<EDXRegisterAssemblyASTNode>();
+    return makeNode<EDXRegisterAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
   R10DRegisterAssemblyASTNode::toByteRegister()
   {
-    return std::make_shared<R10BRegisterAssemblyASTNode>();
+    return makeNode<R10BRegisterAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
   R10BRegisterAssemblyASTNode::toLongWordRegister()
   {
-    return std::make_shared<R10DRegisterAssemblyASTNode>();
+    return makeNode<R10DRegisterAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
   R11DRegisterAssemblyASTNode::toByteRegister()
   {
-    return std::make_shared<R11BRegisterAssemblyASTNode>();
+    return makeNode<R11BRegisterAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
   R11BRegisterAssemblyASTNode::toLongWordRegister()
   {
-    return std::make_shared<R11DRegisterAssemblyASTNode>();
+    return makeNode<R11DRegisterAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
   ECXRegisterAssemblyASTNode::toByteRegister()
   {
-    return std::make_shared<CLRegisterAssemblyASTNode>();
+    return makeNode<CLRegisterAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
   CLRegisterAssemblyASTNode::toLongWordRegister()
   {
-    return std::make_shared<ECXRegisterAssemblyASTNode>();
+    return makeNode<ECXRegisterAssemblyASTNode>();
   }
 
-  [[nodiscard]] std::vector<std::shared_ptr<InstructionAssemblyASTNode>>
-  BinaryOperatorAssemblyASTNode::fixUp(BinaryAssemblyASTNodeFixUpInput &&input)
+  [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
+  ESIRegisterAssemblyASTNode::toByteRegister()
   {
-    auto const &[source, destination]{ std::move(input) };
-    auto const &stack_source{
-      std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(source)
-    };
-    auto const &stack_destination{
-      std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(destination)
-    };
-    return (stack_source && stack_destination) ?
-             std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-               std::make_shared<MovlAssemblyASTNode>(
-                 std::move(source),
-                 std::make_shared<R10DRegisterAssemblyASTNode>()
-               ),
-               std::make_shared<BinaryAssemblyASTNode>(
-                 std::dynamic_pointer_cast<BinaryOperatorAssemblyASTNode>(
-                   shared_from_this()
-                 ),
-                 std::make_shared<R10DRegisterAssemblyASTNode>(),
-                 std::move(destination)
-               )
-             } :
-             std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-               std::make_shared<BinaryAssemblyASTNode>(
-                 std::dynamic_pointer_cast<BinaryOperatorAssemblyASTNode>(
-                   shared_from_this()
-                 ),
-                 std::move(source),
-                 std::move(destination)
-               )
-             };
-  }
-
-  [[nodiscard]] std::vector<std::shared_ptr<InstructionAssemblyASTNode>>
-  CmpAssemblyASTNode::fixUp()
-  {
-    auto const &stack_source{
-      std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(getLeftOperand())
-    };
-    auto const &stack_destination{
-      std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(getRightOperand())
-    };
-    if (stack_source && stack_destination) {
-      return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-        std::make_shared<MovlAssemblyASTNode>(
-          std::move(stack_source),
-          std::make_shared<R10DRegisterAssemblyASTNode>()
-        ),
-        std::make_shared<CmpAssemblyASTNode>(
-          std::make_shared<R10DRegisterAssemblyASTNode>(),
-          std::move(stack_destination)
-        )
-      };
-    } else if (auto const &literal_constant_destination{
-                 std::dynamic_pointer_cast<ImmediateValueAssemblyASTNode>(
-                   getRightOperand()
-                 ) }) {
-      return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-        std::make_shared<MovlAssemblyASTNode>(
-          std::move(literal_constant_destination),
-          std::make_shared<R11DRegisterAssemblyASTNode>()
-        ),
-        std::make_shared<CmpAssemblyASTNode>(
-          getLeftOperand(),
-          std::make_shared<R11DRegisterAssemblyASTNode>()
-        )
-      };
-    } else
-      return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-        std::dynamic_pointer_cast<InstructionAssemblyASTNode>(shared_from_this()
-        )
-      };
-  }
-
-  [[nodiscard]] std::vector<std::shared_ptr<InstructionAssemblyASTNode>>
-  SetCCAssemblyASTNode::fixUp()
+    return makeNode<SILRegisterAssemblyASTNode>();
+  }
+
+  [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+  SILRegisterAssemblyASTNode::toLongWordRegister()
+  {
+    return makeNode<ESIRegisterAssemblyASTNode>();
+  }
+
+  [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
+  EDIRegisterAssemblyASTNode::toByteRegister()
+  {
+    return makeNode<DILRegisterAssemblyASTNode>();
+  }
+
+  [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+  DILRegisterAssemblyASTNode::toLongWordRegister()
+  {
+    return makeNode<EDIRegisterAssemblyASTNode>();
+  }
+
+  [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
+  R8DRegisterAssemblyASTNode::toByteRegister()
+  {
+    return makeNode<R8BRegisterAssemblyASTNode>();
+  }
+
+  [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+  R8BRegisterAssemblyASTNode::toLongWordRegister()
+  {
+    return makeNode<R8DRegisterAssemblyASTNode>();
+  }
+
+  [[nodiscard]] std::shared_ptr<ByteRegisterAssemblyASTNode>
+  R9DRegisterAssemblyASTNode::toByteRegister()
+  {
+    return makeNode<R9BRegisterAssemblyASTNode>();
+  }
+
+  [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+  R9BRegisterAssemblyASTNode::toLongWordRegister()
+  {
+    return makeNode<R9DRegisterAssemblyASTNode>();
+  }
+
+  [[nodiscard]] std::shared_ptr<LongWordRegisterAssemblyASTNode>
+  makeHardRegister(HardRegister const hard_register)
+  {
+    switch (hard_register) {
+    case HardRegister::EAX:
+      return makeNode<EAXRegisterAssemblyASTNode>();
+    case HardRegister::ECX:
+      return makeNode<ECXRegisterAssemblyASTNode>();
+    case HardRegister::EDX:
+      return makeNode<EDXRegisterAssemblyASTNode>();
+    case HardRegister::ESI:
+      return makeNode<ESIRegisterAssemblyASTNode>();
+    case HardRegister::EDI:
+      return makeNode<EDIRegisterAssemblyASTNode>();
+    case HardRegister::R8D:
+      return makeNode<R8DRegisterAssemblyASTNode>();
+    case HardRegister::R9D:
+      return makeNode<R9DRegisterAssemblyASTNode>();
+    }
+    std::unreachable();
+  }
+
+  [[nodiscard]] std::shared_ptr<FunctionAssemblyASTNode>
+  FunctionAssemblyASTNode::allocateRegisters()
+  {
+    auto const assignment{ RegisterAllocator{ getInstructions() }.allocate() };
+    std::vector<std::shared_ptr<InstructionAssemblyASTNode>> new_instructions{};
+    new_instructions.reserve(getInstructions().size());
+    for (auto const &instruction: getInstructions()) {
+      auto new_instruction{ instruction->assignRegisters(assignment) };
+      if (!new_instruction->isRedundant())
+        new_instructions.push_back(std::move(new_instruction));
+    }
+    return makeNode<FunctionAssemblyASTNode>(
+      getIdentifier(),
+      std::move(new_instructions)
+    );
+  }
+
+  void BinaryOperatorAssemblyASTNode::fixUp(
+    BinaryAssemblyASTNodeFixUpInput const &input
+  )
+  {
+    auto const &[instruction, source, destination, instructions]{ input };
+    if (std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(source)
+        && std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(destination)) {
+      instructions.push_back(makeNode<MovlAssemblyASTNode>(
+        source,
+        makeNode<R10DRegisterAssemblyASTNode>()
+      ));
+      source = makeNode<R10DRegisterAssemblyASTNode>();
+    }
+    instructions.push_back(instruction);
+  }
+
+  void CmpAssemblyASTNode::fixUp(
+    std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions
+  )
+  {
+    if (std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(getLeftOperand())
+        && std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(
+          getRightOperand()
+        )) {
+      instructions.push_back(makeNode<MovlAssemblyASTNode>(
+        getLeftOperand(),
+        makeNode<R10DRegisterAssemblyASTNode>()
+      ));
+      left_operand = makeNode<R10DRegisterAssemblyASTNode>();
+    } else if (std::dynamic_pointer_cast<ImmediateValueAssemblyASTNode>(
+                 getRightOperand()
+               )) {
+      instructions.push_back(makeNode<MovlAssemblyASTNode>(
+        getRightOperand(),
+        makeNode<R11DRegisterAssemblyASTNode>()
+      ));
+      right_operand = makeNode<R11DRegisterAssemblyASTNode>();
+    }
+    InstructionAssemblyASTNode::fixUp(instructions);
+  }
+
+  void SetCCAssemblyASTNode::fixUp(
+    std::vector<std::shared_ptr<InstructionAssemblyASTNode>> &instructions
+  )
   {
     if (auto const &register_destination{
           std::dynamic_pointer_cast<RegisterAssemblyASTNode>(getDestination()
-          ) }) {
-      return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-        std::make_shared<SetCCAssemblyASTNode>(
-          getConditionCode(),
-          register_destination->toByteRegister()
-        )
-      };
-    } else {
-      return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-        std::dynamic_pointer_cast<InstructionAssemblyASTNode>(shared_from_this()
-        )
-      };
-    }
+          ) })
+      destination = register_destination->toByteRegister();
+    InstructionAssemblyASTNode::fixUp(instructions);
   }
 
-  [[nodiscard]] std::vector<std::shared_ptr<InstructionAssemblyASTNode>>
-  MultiplyAssemblyASTNode::fixUp(BinaryAssemblyASTNodeFixUpInput &&input)
+  void MultiplyAssemblyASTNode::fixUp(
+    BinaryAssemblyASTNodeFixUpInput const &input
+  )
   {
-    auto const &[source, destination]{ std::move(input) };
-    auto const &stack_destination{
+    auto const &[instruction, source, destination, instructions]{ input };
+    auto const stack_destination{
       std::dynamic_pointer_cast<StackOffsetAssemblyASTNode>(destination)
     };
-    return stack_destination ?
-             std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-               std::make_shared<MovlAssemblyASTNode>(
-                 destination,
-                 std::make_shared<R11DRegisterAssemblyASTNode>()
-               ),
-               std::make_shared<BinaryAssemblyASTNode>(
-                 std::make_shared<MultiplyAssemblyASTNode>(),
-                 std::move(source),
-                 std::make_shared<R11DRegisterAssemblyASTNode>()
-               ),
-               std::make_shared<MovlAssemblyASTNode>(
-                 std::make_shared<R11DRegisterAssemblyASTNode>(),
-                 destination
-               )
-             } :
-             std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-               std::make_shared<BinaryAssemblyASTNode>(
-                 std::make_shared<MultiplyAssemblyASTNode>(),
-                 std::move(source),
-                 std::move(destination)
-               )
-             };
-  }
-
-  [[nodiscard]] std::vector<std::shared_ptr<InstructionAssemblyASTNode>>
-  ShiftOperatorAssemblyASTNode::fixUp(BinaryAssemblyASTNodeFixUpInput &&input)
-  {
-    auto const &[source, destination]{ std::move(input) };
-    return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<MovbAssemblyASTNode>(
-        std::move(source),
-        std::make_shared<R11BRegisterAssemblyASTNode>()
-      ),
-      std::make_shared<MovbAssemblyASTNode>(
-        std::make_shared<R11BRegisterAssemblyASTNode>(),
-        std::make_shared<CLRegisterAssemblyASTNode>()
-      ),
-      std::make_shared<BinaryAssemblyASTNode>(
-        std::dynamic_pointer_cast<BinaryOperatorAssemblyASTNode>(
-          std::move(shared_from_this())
-        ),
-        std::make_shared<CLRegisterAssemblyASTNode>(),
-        std::move(destination)
-      )
+    if (!stack_destination) {
+      instructions.push_back(instruction);
+      return;
+    }
+    instructions.push_back(makeNode<MovlAssemblyASTNode>(
+      stack_destination,
+      makeNode<R11DRegisterAssemblyASTNode>()
+    ));
+    destination = makeNode<R11DRegisterAssemblyASTNode>();
+    instructions.push_back(instruction);
+    instructions.push_back(makeNode<MovlAssemblyASTNode>(
+      makeNode<R11DRegisterAssemblyASTNode>(),
+      stack_destination
+    ));
+  }
+
+  void ShiftOperatorAssemblyASTNode::fixUp(
+    BinaryAssemblyASTNodeFixUpInput const &input
+  )
+  {
+    auto const &[instruction, source, destination, instructions]{ input };
+    auto const &register_source{
+      std::dynamic_pointer_cast<RegisterAssemblyASTNode>(source)
     };
+    instructions.push_back(makeNode<MovbAssemblyASTNode>(
+      register_source ? register_source->toByteRegister() : source,
+      makeNode<R11BRegisterAssemblyASTNode>()
+    ));
+    instructions.push_back(makeNode<MovbAssemblyASTNode>(
+      makeNode<R11BRegisterAssemblyASTNode>(),
+      makeNode<CLRegisterAssemblyASTNode>()
+    ));
+    source = makeNode<CLRegisterAssemblyASTNode>();
+    instructions.push_back(instruction);
+  }
+
+  void MovlAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    auto const destination_operand{ getModRMOperand(*getDestination()) };
+    if (auto const value{ getSource()->getImmediateValue() }) {
+      if (destination_operand.is_memory)
+        out.emitInstruction({ 0xC7 }, {}, destination_operand);
+      else out.emitInstructionWithRegister(0xB8, destination_operand);
+      out.emitInt32(*value);
+      return;
+    }
+    auto const source_operand{ getModRMOperand(*getSource()) };
+    if (source_operand.is_memory)
+      out.emitInstruction({ 0x8B }, destination_operand, source_operand);
+    else out.emitInstruction({ 0x89 }, source_operand, destination_operand);
+  }
+
+  void MovbAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    auto const destination_operand{ getModRMOperand(*getDestination()) };
+    if (auto const value{ getSource()->getImmediateValue() }) {
+      if (destination_operand.is_memory)
+        out.emitInstruction({ 0xC6 }, {}, destination_operand);
+      else out.emitInstructionWithRegister(0xB0, destination_operand);
+      out.emitInt8(*value);
+      return;
+    }
+    auto const source_operand{ getModRMOperand(*getSource()) };
+    if (source_operand.is_memory)
+      out.emitInstruction({ 0x8A }, destination_operand, source_operand);
+    else out.emitInstruction({ 0x88 }, source_operand, destination_operand);
+  }
+
+  void UnaryAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    out.emitInstruction(
+      { 0xF7 },
+      { getUnaryOperator()->getOpcodeExtension() },
+      getModRMOperand(*getOperand())
+    );
+  }
+
+  // Like the GNU assembler, prefers a sign-extended 8-bit immediate, and then
+  // the short form that implies %eax.
+  void encodeArithmeticInstruction(
+    MachineCodeBuffer            &out,
+    std::uint8_t                  opcode_extension,
+    OperandAssemblyASTNode const &source,
+    OperandAssemblyASTNode const &destination
+  )
+  {
+    auto const destination_operand{ getModRMOperand(destination) };
+    if (auto const value{ source.getImmediateValue() }) {
+      if (MachineCodeBuffer::fitsInInt8(*value)) {
+        out.emitInstruction({ 0x83 }, { opcode_extension }, destination_operand);
+        out.emitInt8(*value);
+      } else if (!destination_operand.is_memory
+                 && destination_operand.number == 0) {
+        out.emitByte(static_cast<std::uint8_t>(opcode_extension << 3 | 0x05));
+        out.emitInt32(*value);
+      } else {
+        out.emitInstruction({ 0x81 }, { opcode_extension }, destination_operand);
+        out.emitInt32(*value);
+      }
+      return;
+    }
+    auto const   source_operand{ getModRMOperand(source) };
+    std::uint8_t opcode{ static_cast<std::uint8_t>(opcode_extension << 3) };
+    if (source_operand.is_memory)
+      out.emitInstruction(
+        { static_cast<std::uint8_t>(opcode | 0x03) },
+        destination_operand,
+        source_operand
+      );
+    else
+      out.emitInstruction(
+        { static_cast<std::uint8_t>(opcode | 0x01) },
+        source_operand,
+        destination_operand
+      );
+  }
+
+  // fixUp() always moves the shift count into %cl.
+  void encodeShiftInstruction(
+    MachineCodeBuffer            &out,
+    std::uint8_t                  opcode_extension,
+    OperandAssemblyASTNode const &,
+    OperandAssemblyASTNode const &destination
+  )
+  {
+    out.emitInstruction(
+      { 0xD3 },
+      { opcode_extension },
+      getModRMOperand(destination)
+    );
+  }
+
+  void MultiplyAssemblyASTNode::encode(
+    MachineCodeBuffer            &out,
+    OperandAssemblyASTNode const &source,
+    OperandAssemblyASTNode const &destination
+  ) const
+  {
+    auto const destination_operand{ getModRMOperand(destination) };
+    if (auto const value{ source.getImmediateValue() }) {
+      bool const is_short{ MachineCodeBuffer::fitsInInt8(*value) };
+      out.emitInstruction(
+        { static_cast<std::uint8_t>(is_short ? 0x6B : 0x69) },
+        destination_operand,
+        destination_operand
+      );
+      if (is_short) out.emitInt8(*value);
+      else out.emitInt32(*value);
+      return;
+    }
+    out.emitInstruction(
+      { 0x0F, 0xAF },
+      destination_operand,
+      getModRMOperand(source)
+    );
+  }
+
+  void BinaryAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    getBinaryOperator()->encode(out, *getSource(), *getDestination());
+  }
+
+  void CmpAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    encodeArithmeticInstruction(out, 7, *getLeftOperand(), *getRightOperand());
+  }
+
+  void SetCCAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    out.emitInstruction(
+      { 0x0F,
+        static_cast<std::uint8_t>(
+          0x90 | getConditionCode()->getConditionCodeNumber()
+        ) },
+      {},
+      getModRMOperand(*getDestination())
+    );
+  }
+
+  void AllocateStackAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    ModRMOperand const stack_pointer{ rsp_register_number };
+    if (MachineCodeBuffer::fitsInInt8(getSize())) {
+      out.emitInstruction({ 0x83 }, { 5 }, stack_pointer, true);
+      out.emitInt8(static_cast<std::int32_t>(getSize()));
+    } else {
+      out.emitInstruction({ 0x81 }, { 5 }, stack_pointer, true);
+      out.emitInt32(static_cast<std::int32_t>(getSize()));
+    }
+  }
+
+  void IdivAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    out.emitInstruction({ 0xF7 }, { 7 }, getModRMOperand(*getOperand()));
+  }
+
+  void ReturnAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    out.emitInstruction(
+      { 0x89 },
+      { rbp_register_number },
+      { rsp_register_number },
+      true
+    );
+    out.emitInstructionWithRegister(0x58, { rbp_register_number });
+    out.emitByte(0xC3);
+  }
+
+  void FunctionAssemblyASTNode::encode(MachineCodeBuffer &out) const
+  {
+    out.emitInstructionWithRegister(0x50, { rbp_register_number });
+    out.emitInstruction(
+      { 0x89 },
+      { rsp_register_number },
+      { rbp_register_number },
+      true
+    );
+    for (auto const &instruction: getInstructions()) instruction->encode(out);
+  }
+
+  void ProgramAssemblyASTNode::encode(ElfObjectWriter &out) const
+  {
+    MachineCodeBuffer code{};
+    getFunction()->encode(code);
+    out.addFunction(
+      Utility::specialiseFunctionNameForOS(getFunction()->getIdentifier()),
+      code.finish()
+    );
   }
 } // namespace SC2
@@ -0,0 +1,12 @@
+#include <sc2/assembly_buffer.hpp>
+#include <sc2/output_file.hpp>
+
+#include <span>
+#include <string>
+
+namespace SC2 {
+  void AssemblyBuffer::writeToFile(std::string const &path) const
+  {
+    writeOutputFile(path, std::as_bytes(std::span{ text }));
+  }
+} // namespace SC2
@@ -2,10 +2,10 @@
 #include <sc2/tacky_ast.hpp>
 #include <string_view>
 
-#include <format>
+#include <cstdint>
 #include <memory>
-#include <ranges>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -22,512 +22,424 @@ namespace SC2 {
       return false;
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
-  LiteralConstantASTNode::emitTACKY(ExpressionASTNodeEmitTACKYInput &&input
-  ) const
+  [[nodiscard]] std::shared_ptr<VariableTACKYASTNode>
+  TACKYInstructionSink::makeTemporary()
   {
-    auto const &[_, instructions]{ std::move(input) };
-    return ExpressionASTNodeEmitTACKYOutput{
-      std::make_shared<LiteralConstantTACKYASTNode>(getValue()),
-      std::move(instructions)
-    };
+    return makeNode<VariableTACKYASTNode>(
+      VirtualRegister{ register_count++, getIdentifier(), true }
+    );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
-  VariableASTNode::emitTACKY(ExpressionASTNodeEmitTACKYInput &&input) const
+  [[nodiscard]] std::shared_ptr<VariableTACKYASTNode>
+  TACKYInstructionSink::getVariable(std::string_view const name)
   {
-    auto const &[_, instructions]{ std::move(input) };
-    return ExpressionASTNodeEmitTACKYOutput{
-      std::make_shared<VariableTACKYASTNode>(getIdentifier()),
-      std::move(instructions)
+    auto const [variable, inserted]{
+      variables.try_emplace(name.data(), register_count)
     };
+    if (inserted) ++register_count;
+    return makeNode<VariableTACKYASTNode>(
+      VirtualRegister{ variable->second, name, false }
+    );
+  }
+
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
+  LiteralConstantASTNode::emitTACKY(TACKYInstructionSink &) const
+  {
+    return makeNode<LiteralConstantTACKYASTNode>(getValue());
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
+  VariableASTNode::emitTACKY(TACKYInstructionSink &sink) const
+  {
+    return sink.getVariable(getIdentifier());
+  }
+
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   emitDefaultTACKYForUnaryOperatorASTNode(
     std::shared_ptr<UnaryOperatorTACKYASTNode> unary_operator,
     UnaryOperatorASTNodeEmitTACKYInput       &&input
   )
   {
-    auto const &[identifier, expression, instructions]{ std::move(input) };
-    auto [source, new_instructions]{ expression->emitTACKY(
-      ExpressionASTNodeEmitTACKYInput{ identifier, std::move(instructions) }
-    ) };
-    auto destination{ std::make_shared<VariableTACKYASTNode>(
-      Utility::generateFreshIdentifierWithPrefix(identifier)
-    ) };
-    new_instructions.push_back(
-      std::make_shared<UnaryTACKYASTNode>(unary_operator, source, destination)
+    auto const &[sink, expression]{ input };
+    auto const source{ expression->emitTACKY(sink) };
+    auto destination{ sink.makeTemporary() };
+    sink.append(
+      makeNode<UnaryTACKYASTNode>(unary_operator, source, destination)
     );
-    return ExpressionASTNodeEmitTACKYOutput{ destination,
-                                             std::move(new_instructions) };
+    return destination;
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   ComplementASTNode::emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForUnaryOperatorASTNode(
-      std::make_shared<ComplementTACKYASTNode>(),
+      makeNode<ComplementTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   NegateASTNode::emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForUnaryOperatorASTNode(
-      std::make_shared<NegateTACKYASTNode>(),
+      makeNode<NegateTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   NotASTNode::emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForUnaryOperatorASTNode(
-      std::make_shared<NotTACKYASTNode>(),
+      makeNode<NotTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   PrefixAddSubtractASTNode::emitTACKY(UnaryOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
-    auto const &[identifier, source_ast, instructions]{ std::move(input) };
-    auto [source, new_instructions]{ source_ast->emitTACKY(
-      ExpressionASTNodeEmitTACKYInput{ identifier, std::move(instructions) }
-    ) };
+    auto const &[sink, source_ast]{ input };
+    auto const source{ source_ast->emitTACKY(sink) };
     auto const &source_tacky{
       std::dynamic_pointer_cast<VariableTACKYASTNode>(source)
     };
-    auto destination{ std::make_shared<VariableTACKYASTNode>(
-      Utility::generateFreshIdentifierWithPrefix(identifier)
-    ) };
-    new_instructions.push_back(std::make_shared<BinaryTACKYASTNode>(
+    sink.append(makeNode<BinaryTACKYASTNode>(
       emitBinaryOperatorTACKYASTNode(),
       source_tacky,
-      std::make_shared<LiteralConstantTACKYASTNode>(1),
+      makeNode<LiteralConstantTACKYASTNode>(1),
       source_tacky
     ));
-    return ExpressionASTNodeEmitTACKYOutput{ source_tacky,
-                                             std::move(new_instructions) };
+    return source_tacky;
   }
 
   [[nodiscard]] std::shared_ptr<BinaryOperatorTACKYASTNode>
   PrefixIncrementASTNode::emitBinaryOperatorTACKYASTNode() const
   {
-    return std::make_shared<AddTACKYASTNode>();
+    return makeNode<AddTACKYASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<BinaryOperatorTACKYASTNode>
   PrefixDecrementASTNode::emitBinaryOperatorTACKYASTNode() const
   {
-    return std::make_shared<SubtractTACKYASTNode>();
+    return makeNode<SubtractTACKYASTNode>();
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   PostfixAddSubtractASTNode::emitTACKY(
     UnaryOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
-    auto const &[identifier, expression, instructions]{ std::move(input) };
-    auto [source, new_instructions]{ expression->emitTACKY(
-      ExpressionASTNodeEmitTACKYInput{ identifier, std::move(instructions) }
-    ) };
+    auto const &[sink, expression]{ input };
+    auto const source{ expression->emitTACKY(sink) };
     auto const &source_tacky{
       std::dynamic_pointer_cast<VariableTACKYASTNode>(source)
     };
-    auto temporary{ std::make_shared<VariableTACKYASTNode>(
-      Utility::generateFreshIdentifierWithPrefix(identifier)
-    ) };
-    new_instructions.push_back(
-      std::make_shared<CopyTACKYASTNode>(source_tacky, temporary)
-    );
-    new_instructions.push_back(std::make_shared<BinaryTACKYASTNode>(
+    auto temporary{ sink.makeTemporary() };
+    sink.append(makeNode<CopyTACKYASTNode>(source_tacky, temporary));
+    sink.append(makeNode<BinaryTACKYASTNode>(
       emitBinaryOperatorTACKYASTNode(),
       source_tacky,
-      std::make_shared<LiteralConstantTACKYASTNode>(1),
+      makeNode<LiteralConstantTACKYASTNode>(1),
       source_tacky
     ));
-    return ExpressionASTNodeEmitTACKYOutput{ temporary,
-                                             std::move(new_instructions) };
+    return temporary;
   }
 
   [[nodiscard]] std::shared_ptr<BinaryOperatorTACKYASTNode>
   PostfixIncrementASTNode::emitBinaryOperatorTACKYASTNode() const
   {
-    return std::make_shared<AddTACKYASTNode>();
+    return makeNode<AddTACKYASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<BinaryOperatorTACKYASTNode>
   PostfixDecrementASTNode::emitBinaryOperatorTACKYASTNode() const
   {
-    return std::make_shared<SubtractTACKYASTNode>();
+    return makeNode<SubtractTACKYASTNode>();
   }
 
   struct EmitDefaultBinaryOperatorTACKYInput
   {
-    std::string                                           identifier{};
-    std::shared_ptr<BinaryOperatorTACKYASTNode>           binary_operator;
-    std::shared_ptr<ValueTACKYASTNode>                    left_operand{};
-    std::shared_ptr<ValueTACKYASTNode>                    right_operand{};
-    std::vector<std::shared_ptr<InstructionTACKYASTNode>> instructions{};
+    TACKYInstructionSink                       &sink;
+    std::shared_ptr<BinaryOperatorTACKYASTNode> binary_operator;
+    std::shared_ptr<ValueTACKYASTNode>          left_operand{};
+    std::shared_ptr<ValueTACKYASTNode>          right_operand{};
   };
 
-  [[nodiscard]] static ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] static std::shared_ptr<ValueTACKYASTNode>
   emitDefaultBinaryOperatorTACKY(EmitDefaultBinaryOperatorTACKYInput &&input)
   {
-    auto
-      [identifier, binary_operator, left_operand, right_operand, instructions]{
-        std::move(input)
-      };
-    auto destination{ std::make_shared<VariableTACKYASTNode>(
-      Utility::generateFreshIdentifierWithPrefix(identifier)
-    ) };
-    instructions.push_back(std::make_shared<BinaryTACKYASTNode>(
-      binary_operator,
-      left_operand,
-      right_operand,
+    auto &&[sink, binary_operator, left_operand, right_operand]{
+      std::move(input)
+    };
+    auto destination{ sink.makeTemporary() };
+    sink.append(makeNode<BinaryTACKYASTNode>(
+      std::move(binary_operator),
+      std::move(left_operand),
+      std::move(right_operand),
       destination
     ));
-    return ExpressionASTNodeEmitTACKYOutput{ destination,
-                                             std::move(instructions) };
+    return destination;
   }
 
-  [[nodiscard]] static ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] static std::shared_ptr<ValueTACKYASTNode>
   emitDefaultTACKYForBinaryOperatorASTNode(
     std::shared_ptr<BinaryOperatorTACKYASTNode> binary_operator,
     BinaryOperatorASTNodeEmitTACKYInput       &&input
   )
   {
-    auto const &[identifier, left_operand_ast, right_operand_ast, instructions]{
-      std::move(input)
-    };
-    auto [left_operand, left_operand_instructions]{ left_operand_ast->emitTACKY(
-      ExpressionASTNodeEmitTACKYInput{ identifier, std::move(instructions) }
-    ) };
-    auto [right_operand, right_operand_instructions]{
-      right_operand_ast->emitTACKY(ExpressionASTNodeEmitTACKYInput{
-        identifier,
-        std::move(left_operand_instructions) })
-    };
+    auto const &[sink, left_operand_ast, right_operand_ast]{ input };
+    auto left_operand{ left_operand_ast->emitTACKY(sink) };
+    auto right_operand{ right_operand_ast->emitTACKY(sink) };
     return emitDefaultBinaryOperatorTACKY(EmitDefaultBinaryOperatorTACKYInput{
-      identifier,
+      sink,
       std::move(binary_operator),
       std::move(left_operand),
-      std::move(right_operand),
-      std::move(right_operand_instructions) });
+      std::move(right_operand) });
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   AddASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<AddTACKYASTNode>(),
+      makeNode<AddTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   SubtractASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<SubtractTACKYASTNode>(),
+      makeNode<SubtractTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   MultiplyASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<MultiplyTACKYASTNode>(),
+      makeNode<MultiplyTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   DivideASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<DivideTACKYASTNode>(),
+      makeNode<DivideTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   ModuloASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<ModuloTACKYASTNode>(),
+      makeNode<ModuloTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   BitwiseAndASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<BitwiseAndTACKYASTNode>(),
+      makeNode<BitwiseAndTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   BitwiseOrASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<BitwiseOrTACKYASTNode>(),
+      makeNode<BitwiseOrTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   BitwiseXorASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<BitwiseXorTACKYASTNode>(),
+      makeNode<BitwiseXorTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   LeftShiftASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<LeftShiftTACKYASTNode>(),
+      makeNode<LeftShiftTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   RightShiftASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<RightShiftTACKYASTNode>(),
+      makeNode<RightShiftTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   AndASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
-    auto const &[identifier, left_operand_ast, right_operand_ast, instructions]{
-      std::move(input)
-    };
-    auto [left_operand, left_operand_instructions]{ left_operand_ast->emitTACKY(
-      ExpressionASTNodeEmitTACKYInput{ identifier, std::move(instructions) }
-    ) };
-    auto const &false_label{ std::format(
-      "{}_{}",
-      Utility::generateFreshIdentifierWithPrefix(identifier),
-      "false_label"
-    ) };
-    left_operand_instructions.push_back(
-      std::make_shared<JumpIfZeroTACKYASTNode>(left_operand, false_label)
-    );
-    auto [right_operand, right_operand_instructions]{
-      right_operand_ast->emitTACKY(ExpressionASTNodeEmitTACKYInput{
-        identifier,
-        std::move(left_operand_instructions) })
-    };
-    auto destination{ std::make_shared<VariableTACKYASTNode>(
-      Utility::generateFreshIdentifierWithPrefix(identifier)
-    ) };
-    right_operand_instructions.push_back(
-      std::make_shared<JumpIfZeroTACKYASTNode>(right_operand, false_label)
-    );
-    right_operand_instructions.push_back(std::make_shared<CopyTACKYASTNode>(
-      std::make_shared<LiteralConstantTACKYASTNode>(1),
+    auto const &[sink, left_operand_ast, right_operand_ast]{ input };
+    auto const left_operand{ left_operand_ast->emitTACKY(sink) };
+    auto const false_label{ sink.generateFreshLabel("false_label") };
+    sink.append(makeNode<JumpIfZeroTACKYASTNode>(left_operand, false_label));
+    auto const right_operand{ right_operand_ast->emitTACKY(sink) };
+    auto destination{ sink.makeTemporary() };
+    sink.append(makeNode<JumpIfZeroTACKYASTNode>(right_operand, false_label));
+    sink.append(makeNode<CopyTACKYASTNode>(
+      makeNode<LiteralConstantTACKYASTNode>(1),
       destination
     ));
-    auto const &end_label{ Utility::generateFreshIdentifierWithPrefix(identifier
-    ) };
-    right_operand_instructions.push_back(
-      std::make_shared<JumpTACKYASTNode>(end_label)
-    );
-    right_operand_instructions.push_back(
-      std::make_shared<LabelTACKYASTNode>(false_label)
-    );
-    right_operand_instructions.push_back(std::make_shared<CopyTACKYASTNode>(
-      std::make_shared<LiteralConstantTACKYASTNode>(0),
+    auto const &end_label{ sink.generateFreshLabel() };
+    sink.append(makeNode<JumpTACKYASTNode>(end_label));
+    sink.append(makeNode<LabelTACKYASTNode>(false_label));
+    sink.append(makeNode<CopyTACKYASTNode>(
+      makeNode<LiteralConstantTACKYASTNode>(0),
       destination
     ));
-    right_operand_instructions.push_back(
-      std::make_shared<LabelTACKYASTNode>(end_label)
-    );
-    return ExpressionASTNodeEmitTACKYOutput{
-      destination,
-      std::move(right_operand_instructions)
-    };
+    sink.append(makeNode<LabelTACKYASTNode>(end_label));
+    return destination;
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   OrASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
-    auto const &[identifier, left_operand_ast, right_operand_ast, instructions]{
-      std::move(input)
-    };
-    auto [left_operand, left_operand_instructions]{ left_operand_ast->emitTACKY(
-      ExpressionASTNodeEmitTACKYInput{ identifier, std::move(instructions) }
-    ) };
-    auto const &false_label{ std::format(
-      "{}_{}",
-      Utility::generateFreshIdentifierWithPrefix(identifier),
-      "false_label"
-    ) };
-    left_operand_instructions.push_back(
-      std::make_shared<JumpIfNotZeroTACKYASTNode>(left_operand, false_label)
-    );
-    auto [right_operand, right_operand_instructions]{
-      right_operand_ast->emitTACKY(ExpressionASTNodeEmitTACKYInput{
-        identifier,
-        std::move(left_operand_instructions) })
-    };
-    auto destination{ std::make_shared<VariableTACKYASTNode>(
-      Utility::generateFreshIdentifierWithPrefix(identifier)
-    ) };
-    right_operand_instructions.push_back(
-      std::make_shared<JumpIfNotZeroTACKYASTNode>(right_operand, false_label)
-    );
-    right_operand_instructions.push_back(std::make_shared<CopyTACKYASTNode>(
-      std::make_shared<LiteralConstantTACKYASTNode>(0),
+    auto const &[sink, left_operand_ast, right_operand_ast]{ input };
+    auto const left_operand{ left_operand_ast->emitTACKY(sink) };
+    auto const false_label{ sink.generateFreshLabel("false_label") };
+    sink.append(makeNode<JumpIfNotZeroTACKYASTNode>(left_operand, false_label));
+    auto const right_operand{ right_operand_ast->emitTACKY(sink) };
+    auto destination{ sink.makeTemporary() };
+    sink.append(
+      makeNode<JumpIfNotZeroTACKYASTNode>(right_operand, false_label)
+    );
+    sink.append(makeNode<CopyTACKYASTNode>(
+      makeNode<LiteralConstantTACKYASTNode>(0),
       destination
     ));
-    auto const &end_label{ Utility::generateFreshIdentifierWithPrefix(identifier
-    ) };
-    right_operand_instructions.push_back(
-      std::make_shared<JumpTACKYASTNode>(end_label)
-    );
-    right_operand_instructions.push_back(
-      std::make_shared<LabelTACKYASTNode>(false_label)
-    );
-    right_operand_instructions.push_back(std::make_shared<CopyTACKYASTNode>(
-      std::make_shared<LiteralConstantTACKYASTNode>(1),
+    auto const &end_label{ sink.generateFreshLabel() };
+    sink.append(makeNode<JumpTACKYASTNode>(end_label));
+    sink.append(makeNode<LabelTACKYASTNode>(false_label));
+    sink.append(makeNode<CopyTACKYASTNode>(
+      makeNode<LiteralConstantTACKYASTNode>(1),
       destination
     ));
-    right_operand_instructions.push_back(
-      std::make_shared<LabelTACKYASTNode>(end_label)
-    );
-    return ExpressionASTNodeEmitTACKYOutput{
-      destination,
-      std::move(right_operand_instructions)
-    };
+    sink.append(makeNode<LabelTACKYASTNode>(end_label));
+    return destination;
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   EqualsASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<EqualsTACKYASTNode>(),
+      makeNode<EqualsTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   NotEqualsASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<NotEqualsTACKYASTNode>(),
+      makeNode<NotEqualsTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   LessThanASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<LessThanTACKYASTNode>(),
+      makeNode<LessThanTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   GreaterThanASTNode::emitTACKY(BinaryOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<GreaterThanTACKYASTNode>(),
+      makeNode<GreaterThanTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   LessThanOrEqualToASTNode::emitTACKY(
     BinaryOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<LessThanOrEqualToTACKYASTNode>(),
+      makeNode<LessThanOrEqualToTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   GreaterThanOrEqualToASTNode::emitTACKY(
     BinaryOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForBinaryOperatorASTNode(
-      std::make_shared<GreaterThanOrEqualToTACKYASTNode>(),
+      makeNode<GreaterThanOrEqualToTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] static ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] static std::shared_ptr<ValueTACKYASTNode>
   emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
     std::shared_ptr<BinaryOperatorTACKYASTNode>    binary_operator,
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   )
   {
-    auto const &[identifier, variable, expression, instructions]{
-      std::move(input)
-    };
-    auto const &[source_tacky, new_instructions_zero]{
-      expression->emitTACKY({ identifier, std::move(instructions) })
-    };
-    auto [destination_tacky, new_instructions_one]{
-      variable->emitTACKY({ identifier, std::move(new_instructions_zero) })
-    };
-    auto [temp_destination_tacky, final_instructions]{
+    auto const &[sink, variable, expression]{ input };
+    auto source_tacky{ expression->emitTACKY(sink) };
+    auto const destination_tacky{ variable->emitTACKY(sink) };
+    auto const temp_destination_tacky{
       emitDefaultBinaryOperatorTACKY(EmitDefaultBinaryOperatorTACKYInput{
-        identifier,
+        sink,
         std::move(binary_operator),
         destination_tacky,
-        std::move(source_tacky),
-        std::move(new_instructions_one) })
+        std::move(source_tacky) })
     };
-    final_instructions.push_back(std::make_shared<CopyTACKYASTNode>(
+    sink.append(makeNode<CopyTACKYASTNode>(
       temp_destination_tacky,
       std::dynamic_pointer_cast<VariableTACKYASTNode>(destination_tacky)
     ));
-    return { destination_tacky, std::move(final_instructions) };
+    return destination_tacky;
   }
 
-  [[nodiscard]] static ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] static std::shared_ptr<ValueTACKYASTNode>
   emitTACKYForAssignment(BasicAssignmentOperatorASTNodeEmitTACKYInput &&input)
   {
-    auto const &[identifier, variable, expression, instructions]{
-      std::move(input)
-    };
-    auto const &[source_tacky, new_instructions_zero]{
-      expression->emitTACKY({ identifier, std::move(instructions) })
-    };
-    auto [destination_tacky, new_instructions_one]{
-      variable->emitTACKY({ identifier, std::move(new_instructions_zero) })
-    };
-    new_instructions_one.push_back(std::make_shared<CopyTACKYASTNode>(
+    auto const &[sink, variable, expression]{ input };
+    auto const source_tacky{ expression->emitTACKY(sink) };
+    auto const destination_tacky{ variable->emitTACKY(sink) };
+    sink.append(makeNode<CopyTACKYASTNode>(
       source_tacky,
       std::dynamic_pointer_cast<VariableTACKYASTNode>(destination_tacky)
     ));
-    return { destination_tacky, std::move(new_instructions_one) };
+    return destination_tacky;
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   AssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
@@ -535,178 +447,243 @@ namespace SC2 {
     return emitTACKYForAssignment(std::move(input));
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   AddAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<AddTACKYASTNode>(),
+      makeNode<AddTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   DivideAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<DivideTACKYASTNode>(),
+      makeNode<DivideTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   ModuloAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<ModuloTACKYASTNode>(),
+      makeNode<ModuloTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   MultiplyAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<MultiplyTACKYASTNode>(),
+      makeNode<MultiplyTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   SubtractAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<SubtractTACKYASTNode>(),
+      makeNode<SubtractTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   BitwiseOrAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<BitwiseOrTACKYASTNode>(),
+      makeNode<BitwiseOrTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   BitwiseAndAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<BitwiseAndTACKYASTNode>(),
+      makeNode<BitwiseAndTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   BitwiseXorAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<BitwiseXorTACKYASTNode>(),
+      makeNode<BitwiseXorTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   LeftShiftAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<LeftShiftTACKYASTNode>(),
+      makeNode<LeftShiftTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  [[nodiscard]] ExpressionASTNodeEmitTACKYOutput
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
   RightShiftAssignmentOperatorASTNode::emitTACKY(
     BasicAssignmentOperatorASTNodeEmitTACKYInput &&input
   ) const
   {
     return emitDefaultTACKYForCompoundAssignmentOperatorASTNode(
-      std::make_shared<RightShiftTACKYASTNode>(),
+      makeNode<RightShiftTACKYASTNode>(),
       std::move(input)
     );
   }
 
-  std::vector<std::shared_ptr<InstructionTACKYASTNode>>
-  ReturnStatementASTNode::emitTACKY(std::string_view identifier) const
+  void ReturnStatementASTNode::emitTACKY(TACKYInstructionSink &sink) const
   {
-    auto [value, instructions]{
-      getExpression()->emitTACKY(ExpressionASTNodeEmitTACKYInput{
-        std::string{ identifier },
-        std::vector<std::shared_ptr<InstructionTACKYASTNode>>{} })
-    };
-    instructions.push_back(std::make_shared<ReturnTACKYASTNode>(value));
-    return instructions;
+    sink.append(makeNode<ReturnTACKYASTNode>(getExpression()->emitTACKY(sink)));
   }
 
-  std::vector<std::shared_ptr<InstructionTACKYASTNode>>
-  ExpressionStatementASTNode::emitTACKY(std::string_view identifier) const
+  void ExpressionStatementASTNode::emitTACKY(TACKYInstructionSink &sink) const
   {
-    auto [_, instructions]{
-      getExpression()->emitTACKY(ExpressionASTNodeEmitTACKYInput{
-        std::string{ identifier },
-        std::vector<std::shared_ptr<InstructionTACKYASTNode>>{} })
-    };
-    return instructions;
+    std::ignore = getExpression()->emitTACKY(sink);
   }
 
-  [[nodiscard]] std::vector<std::shared_ptr<InstructionTACKYASTNode>>
-  DeclarationASTNode::emitTACKY(std::string_view identifier) const
+  void DeclarationASTNode::emitTACKY(TACKYInstructionSink &sink) const
   {
     if (initializer) {
-      auto [_, instructions]{
-        emitTACKYForAssignment(BasicAssignmentOperatorASTNodeEmitTACKYInput{
-          std::string{ identifier },
-          std::make_shared<VariableASTNode>(getIdentifier()),
-          getInitializer(),
-          std::vector<std::shared_ptr<InstructionTACKYASTNode>>() })
-      };
-      return instructions;
-    } else {
-      return std::vector<std::shared_ptr<InstructionTACKYASTNode>>();
+      std::ignore = emitTACKYForAssignment(
+        BasicAssignmentOperatorASTNodeEmitTACKYInput{
+          sink,
+          makeNode<VariableASTNode>(getIdentifier()),
+          getInitializer() }
+      );
     }
   }
 
-  std::shared_ptr<FunctionTACKYASTNode> FunctionASTNode::emitTACKY()
+  [[nodiscard]] std::uint32_t UnaryExpressionASTNode::flatten(FlatAST &flat_ast
+  ) const
   {
-    auto tacky_block_items{
-      getBlockItems()
-      | std::views::transform(
-        [this](std::shared_ptr<BlockItemASTNode> block_item) {
-      return block_item->emitTACKY(getIdentifier());
-    }
-      )
-      | std::views::join | std::ranges::to<std::vector>()
+    std::uint32_t const node{ flat_ast.appendNode(
+      FlatASTNodeKind::Unary,
+      getUnaryOperator()->getFlatASTOperator()
+    ) };
+    flat_ast.setFirstOperand(node, getExpression()->flatten(flat_ast));
+    return node;
+  }
+
+  [[nodiscard]] std::uint32_t AssignmentASTNode::flatten(FlatAST &flat_ast
+  ) const
+  {
+    std::uint32_t const node{ flat_ast.appendNode(
+      FlatASTNodeKind::Assignment,
+      getBasicAssignmentOperator()->getFlatASTOperator()
+    ) };
+    flat_ast.setFirstOperand(node, getVariable()->flatten(flat_ast));
+    flat_ast.setSecondOperand(node, getExpression()->flatten(flat_ast));
+    return node;
+  }
+
+  [[nodiscard]] std::uint32_t BinaryExpressionASTNode::flatten(
+    FlatAST &flat_ast
+  ) const
+  {
+    std::uint32_t const node{ flat_ast.appendNode(
+      FlatASTNodeKind::Binary,
+      getBinaryOperator()->getFlatASTOperator()
+    ) };
+    flat_ast.setFirstOperand(node, getLeftOperand()->flatten(flat_ast));
+    flat_ast.setSecondOperand(node, getRightOperand()->flatten(flat_ast));
+    return node;
+  }
+
+  [[nodiscard]] std::uint32_t ReturnStatementASTNode::flatten(
+    FlatAST &flat_ast
+  ) const
+  {
+    std::uint32_t const node{
+      flat_ast.appendNode(FlatASTNodeKind::ReturnStatement)
     };
-    tacky_block_items.push_back(std::make_shared<ReturnTACKYASTNode>(
-      std::make_shared<LiteralConstantTACKYASTNode>(0)
-    ));
-    return std::make_shared<FunctionTACKYASTNode>(
+    flat_ast.setFirstOperand(node, getExpression()->flatten(flat_ast));
+    return node;
+  }
+
+  [[nodiscard]] std::uint32_t ExpressionStatementASTNode::flatten(
+    FlatAST &flat_ast
+  ) const
+  {
+    std::uint32_t const node{
+      flat_ast.appendNode(FlatASTNodeKind::ExpressionStatement)
+    };
+    flat_ast.setFirstOperand(node, getExpression()->flatten(flat_ast));
+    return node;
+  }
+
+  [[nodiscard]] std::uint32_t DeclarationASTNode::flatten(FlatAST &flat_ast
+  ) const
+  {
+    std::uint32_t const node{ flat_ast.appendNode(
+      FlatASTNodeKind::Declaration,
+      FlatASTOperator::None,
+      flat_ast.addIdentifier(getIdentifier())
+    ) };
+    std::ignore = type->flatten(flat_ast);
+    if (initializer)
+      flat_ast.setSecondOperand(node, getInitializer()->flatten(flat_ast));
+    return node;
+  }
+
+  std::shared_ptr<FunctionTACKYASTNode> FunctionASTNode::emitTACKY()
+  {
+    TACKYInstructionSink sink{ getIdentifier() };
+    for (auto const &block_item: getBlockItems()) block_item->emitTACKY(sink);
+    sink.append(
+      makeNode<ReturnTACKYASTNode>(makeNode<LiteralConstantTACKYASTNode>(0))
+    );
+    return makeNode<FunctionTACKYASTNode>(
       getIdentifier(),
-      tacky_block_items
+      std::move(sink).takeInstructions()
     );
   }
 
   std::shared_ptr<ProgramTACKYASTNode> ProgramASTNode::emitTACKY() const
   {
-    return std::make_shared<ProgramTACKYASTNode>(getFunction()->emitTACKY());
+    return makeNode<ProgramTACKYASTNode>(
+      getFunction()->emitTACKY(),
+      string_interner
+    );
+  }
+
+  [[nodiscard]] FlatAST FunctionASTNode::flatten(
+    std::shared_ptr<StringInterner const> string_interner
+  ) const
+  {
+    FlatAST flat_ast{ getIdentifier(), std::move(string_interner) };
+    for (auto const &block_item: block_items)
+      flat_ast.addBlockItem(block_item->flatten(flat_ast));
+    return flat_ast;
+  }
+
+  [[nodiscard]] FlatAST ProgramASTNode::flatten() const
+  {
+    return getFunction()->flatten(string_interner);
   }
 } // namespace SC2
@@ -0,0 +1,126 @@
+#include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
+#include <sc2/batch.hpp>
+#include <sc2/compilation_cache.hpp>
+#include <sc2/compilation_context.hpp>
+#include <sc2/compiler_error.hpp>
+#include <sc2/input_file.hpp>
+#include <sc2/output_file.hpp>
+#include <sc2/preprocessor.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SC2 {
+  namespace {
+    class BatchInputError: public CompilerError
+    {
+      std::string const message{};
+
+      public:
+      explicit BatchInputError(std::string_view path)
+        : message{ std::format("Cannot read {}", path) }
+      {}
+
+      constexpr virtual char const *what() const noexcept final override
+      {
+        return message.c_str();
+      }
+    };
+
+    void compileFile(
+      std::string const  &source_path,
+      CompilationContext &context,
+      CompilationCache   *cache
+    )
+    {
+      // Preprocessed source is compiled straight from the input file.
+      std::string              preprocessed_text{};
+      std::optional<InputFile> input_file{};
+      if (source_path.ends_with(".c"))
+        preprocessed_text = Preprocessor{}.preprocessFile(source_path);
+      else
+        input_file.emplace(source_path);
+      std::string_view const program_text{ input_file ? input_file->getText()
+                                                      : preprocessed_text };
+      std::string const assembly_path{
+        source_path.substr(0, source_path.find_last_of('.')) + ".s"
+      };
+      std::string const cache_key{
+        cache ? cache->getKey(program_text) : std::string{}
+      };
+      if (cache)
+        if (auto const cached_assembly{ cache->lookUp(cache_key) }) {
+          writeOutputFile(
+            assembly_path,
+            std::as_bytes(std::span{ *cached_assembly })
+          );
+          return;
+        }
+      auto const     assembly{ context.compile(program_text) };
+      AssemblyBuffer assembly_buffer{};
+      assembly->emitCode(assembly_buffer);
+      if (cache) cache->store(cache_key, assembly_buffer.getText());
+      assembly_buffer.writeToFile(assembly_path);
+    }
+  } // namespace
+
+  std::vector<std::string>
+  expandResponseFiles(std::span<std::string const> const arguments)
+  {
+    std::vector<std::string> paths{};
+    for (auto const &argument: arguments) {
+      if (!argument.starts_with('@')) {
+        paths.push_back(argument);
+        continue;
+      }
+      std::ifstream response_file{ argument.substr(1) };
+      if (!response_file) throw BatchInputError(argument.substr(1));
+      paths.insert(
+        paths.end(),
+        std::istream_iterator<std::string>{ response_file },
+        std::istream_iterator<std::string>{}
+      );
+    }
+    return paths;
+  }
+
+  std::vector<BatchFailure> compileBatch(
+    std::span<std::string const> const source_paths,
+    std::size_t const                  thread_count,
+    CompilationCache * const           cache
+  )
+  {
+    // Each task writes only its own slot, so the threads need no lock.
+    std::vector<std::optional<std::string>> messages(source_paths.size());
+    runOnThreadPool(
+      source_paths.size(),
+      [&source_paths, &messages, cache](std::size_t const index) {
+        CompilationContext context{};
+        try {
+          compileFile(source_paths[index], context, cache);
+        } catch (std::exception const &exception) {
+          context.report(exception.what());
+        }
+        if (!context.getDiagnostics().empty())
+          messages[index] = context.getDiagnostics().front();
+      },
+      thread_count
+    );
+    std::vector<BatchFailure> failures{};
+    for (std::size_t index{}; index < source_paths.size(); ++index)
+      if (messages[index])
+        failures.push_back({ .source_path = source_paths[index],
+                             .message     = std::move(*messages[index]) });
+    return failures;
+  }
+} // namespace SC2
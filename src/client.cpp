@@ -0,0 +1,57 @@
+#include <sc2/compile_server.hpp>
+#include <sc2/compiler_error.hpp>
+#include <sc2/output_file.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <span>
+#include <sstream>
+#include <string>
+
+constexpr char const * const usage_error_message{
+  "Error: Usage: sc2-client /path/to/socket "
+  "[-(-(lex|parse|validate|codegen|tacky)|S)] /path/to/file.c\n"
+};
+
+// Sends a file to a server started with sc2 --serve and writes the assembly
+// it answers with next to the file, as sc2 -S would.
+int main(int argc, char const * const * const argv)
+{
+  if (argc < 3 || argc > 4) {
+    std::print(stderr, "{}", usage_error_message);
+    return EXIT_FAILURE;
+  }
+  std::string const source_path{ argv[argc - 1] };
+  std::string const options{ argc == 4 ? argv[2] : "" };
+  std::ifstream     source_file{ source_path };
+  if (!source_file) {
+    std::perror("File opening failed");
+    return EXIT_FAILURE;
+  }
+  std::ostringstream source{};
+  source << source_file.rdbuf();
+  try {
+    auto const [succeeded, output]{ SC2::requestCompilation(
+      argv[1],
+      options,
+      std::filesystem::absolute(source_path),
+      source.str()
+    ) };
+    if (!succeeded) {
+      std::print(stderr, "Compiler error:\n{}", output);
+      return EXIT_FAILURE;
+    }
+    if (options.empty() || options == "-S")
+      SC2::writeOutputFile(
+        source_path.substr(0, source_path.find_last_of('.')) + ".s",
+        std::as_bytes(std::span{ output })
+      );
+  } catch (SC2::CompilerError const &exception) {
+    std::println(stderr, "Compiler error:\n{}", exception.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
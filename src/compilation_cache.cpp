@@ -0,0 +1,384 @@
+#include <sc2/compilation_cache.hpp>
+#include <sc2/output_file.hpp>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace SC2 {
+  namespace {
+    // Bump whenever the layout of the cache directory changes.
+    constexpr std::string_view cache_format_version{ "1" };
+
+    // Eviction goes below the maximum size by this share of it, so that a
+    // full cache is not scanned again on the very next store.
+    constexpr std::uintmax_t eviction_slack_divisor{ 10 };
+
+    // Temporary files this old were left behind by a writer that crashed.
+    constexpr std::chrono::hours stale_temporary_age{ 1 };
+
+    constexpr std::uint64_t prime_1{ 0x9E37'79B1'85EB'CA87ULL };
+    constexpr std::uint64_t prime_2{ 0xC2B2'AE3D'27D4'EB4FULL };
+    constexpr std::uint64_t prime_3{ 0x1656'67B1'9E37'79F9ULL };
+    constexpr std::uint64_t prime_4{ 0x85EB'CA77'C2B2'AE63ULL };
+    constexpr std::uint64_t prime_5{ 0x27D4'EB2F'1656'67C5ULL };
+
+    template<typename T>
+    [[nodiscard]] T read(char const * const data) noexcept
+    {
+      T value{};
+      std::memcpy(&value, data, sizeof value);
+      return value;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t
+    round(std::uint64_t accumulator, std::uint64_t const input) noexcept
+    {
+      accumulator += input * prime_2;
+      return std::rotl(accumulator, 31) * prime_1;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t
+    mergeRound(std::uint64_t hash, std::uint64_t const accumulator) noexcept
+    {
+      hash ^= round(0, accumulator);
+      return hash * prime_1 + prime_4;
+    }
+
+    [[nodiscard]] std::string
+    getEntryPath(std::filesystem::path const &directory, std::string_view key)
+    {
+      return (directory / std::format("{}.s", key)).string();
+    }
+
+    // Holds an exclusive flock(2) on a file for as long as it lives.
+    class FileLock
+    {
+      int file_descriptor{ -1 };
+
+      public:
+      explicit FileLock(std::filesystem::path const &path)
+        : file_descriptor{
+          ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)
+        }
+      {
+        if (file_descriptor < 0)
+          throw CompilationCacheError(path, std::strerror(errno));
+        while (::flock(file_descriptor, LOCK_EX) < 0)
+          if (errno != EINTR) {
+            int const error_number{ errno };
+            ::close(file_descriptor);
+            throw CompilationCacheError(path, std::strerror(error_number));
+          }
+      }
+
+      FileLock(FileLock const &)            = delete;
+      FileLock &operator=(FileLock const &) = delete;
+
+      ~FileLock() { ::close(file_descriptor); }
+    };
+
+    // What the stats file records: the totals of every process that saved
+    // its statistics, and the total size of the entries, if it is known.
+    struct CacheState
+    {
+      CompilationCacheStatistics    statistics{};
+      std::optional<std::uintmax_t> size{};
+    };
+
+    [[nodiscard]] CacheState
+    readCacheState(std::filesystem::path const &directory)
+    {
+      CacheState    state{};
+      std::ifstream statistics_file{ directory / "stats" };
+      statistics_file >> state.statistics.hits >> state.statistics.misses
+        >> state.statistics.evictions;
+      if (!statistics_file) return {};
+      if (std::uintmax_t size{}; statistics_file >> size) state.size = size;
+      return state;
+    }
+
+    // The caller must hold the lock on stats.lock.
+    void writeCacheState(
+      std::filesystem::path const &directory,
+      CacheState const            &state
+    )
+    {
+      std::string statistics_text{ std::format(
+        "{} {} {}",
+        state.statistics.hits,
+        state.statistics.misses,
+        state.statistics.evictions
+      ) };
+      if (state.size) statistics_text += std::format(" {}", *state.size);
+      statistics_text += '\n';
+      std::string const statistics_path{ (directory / "stats").string() };
+      std::string const temporary_path{ statistics_path + ".tmp" };
+      writeOutputFile(
+        temporary_path,
+        std::as_bytes(std::span{ statistics_text })
+      );
+      std::error_code error{};
+      std::filesystem::rename(temporary_path, statistics_path, error);
+      if (error) throw CompilationCacheError(directory, error.message());
+    }
+  } // namespace
+
+  std::uint64_t
+  hashXXH64(std::string_view const data, std::uint64_t const seed) noexcept
+  {
+    char const       *position{ data.data() };
+    char const *const end{ position + data.size() };
+    std::uint64_t     hash{};
+    if (data.size() >= 32) {
+      std::uint64_t accumulator_1{ seed + prime_1 + prime_2 };
+      std::uint64_t accumulator_2{ seed + prime_2 };
+      std::uint64_t accumulator_3{ seed };
+      std::uint64_t accumulator_4{ seed - prime_1 };
+      for (; end - position >= 32; position += 32) {
+        accumulator_1 = round(accumulator_1, read<std::uint64_t>(position));
+        accumulator_2 = round(accumulator_2, read<std::uint64_t>(position + 8));
+        accumulator_3
+          = round(accumulator_3, read<std::uint64_t>(position + 16));
+        accumulator_4
+          = round(accumulator_4, read<std::uint64_t>(position + 24));
+      }
+      hash = std::rotl(accumulator_1, 1) + std::rotl(accumulator_2, 7)
+             + std::rotl(accumulator_3, 12) + std::rotl(accumulator_4, 18);
+      hash = mergeRound(hash, accumulator_1);
+      hash = mergeRound(hash, accumulator_2);
+      hash = mergeRound(hash, accumulator_3);
+      hash = mergeRound(hash, accumulator_4);
+    } else hash = seed + prime_5;
+    hash += data.size();
+    for (; end - position >= 8; position += 8) {
+      hash ^= round(0, read<std::uint64_t>(position));
+      hash  = std::rotl(hash, 27) * prime_1 + prime_4;
+    }
+    if (end - position >= 4) {
+      hash     ^= read<std::uint32_t>(position) * prime_1;
+      hash      = std::rotl(hash, 23) * prime_2 + prime_3;
+      position += 4;
+    }
+    for (; position != end; ++position) {
+      hash ^= static_cast<unsigned char>(*position) * prime_5;
+      hash  = std::rotl(hash, 11) * prime_1;
+    }
+    hash ^= hash >> 33;
+    hash *= prime_2;
+    hash ^= hash >> 29;
+    hash *= prime_3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+  std::string getCompilerIdentity()
+  {
+    std::error_code error{};
+    auto const      executable{
+      std::filesystem::read_symlink("/proc/self/exe", error)
+    };
+    if (error) return "unknown";
+    auto const size{ std::filesystem::file_size(executable, error) };
+    if (error) return "unknown";
+    auto const modification_time{
+      std::filesystem::last_write_time(executable, error)
+    };
+    if (error) return "unknown";
+    return std::format(
+      "{} {}",
+      size,
+      modification_time.time_since_epoch().count()
+    );
+  }
+
+  CompilationCache::CompilationCache(
+    std::filesystem::path  directory,
+    std::uintmax_t const   max_size,
+    std::string_view const compiler_identity
+  )
+    : directory{ std::move(directory) }
+    , max_size{ max_size }
+    , key_prefix{ std::format(
+        "{}\n{}\n",
+        cache_format_version,
+        compiler_identity
+      ) }
+  {
+    std::error_code error{};
+    std::filesystem::create_directories(this->directory, error);
+    if (error) throw CompilationCacheError(this->directory, error.message());
+  }
+
+  std::string CompilationCache::getKey(
+    std::string_view const program_text,
+    std::string_view const options
+  ) const
+  {
+    // Two 64-bit hashes of the text, seeded by the compiler identity and the
+    // options, keep accidental collisions out of reach even for a cache
+    // shared by many machines.
+    std::string const prefix{ std::format("{}{}\n", key_prefix, options) };
+    return std::format(
+      "{:016x}{:016x}",
+      hashXXH64(program_text, hashXXH64(prefix, 0)),
+      hashXXH64(program_text, hashXXH64(prefix, 1))
+    );
+  }
+
+  std::optional<std::string> CompilationCache::lookUp(std::string const &key)
+  {
+    std::string const entry_path{ getEntryPath(directory, key) };
+    std::ifstream     entry{ entry_path };
+    if (!entry) {
+      ++misses;
+      return std::nullopt;
+    }
+    std::ostringstream assembly{};
+    assembly << entry.rdbuf();
+    if (!assembly) {
+      ++misses;
+      return std::nullopt;
+    }
+    ++hits;
+    std::error_code error{};
+    std::filesystem::last_write_time(
+      entry_path,
+      std::filesystem::file_time_type::clock::now(),
+      error
+    );
+    return std::move(assembly).str();
+  }
+
+  void CompilationCache::store(
+    std::string const     &key,
+    std::string_view const assembly
+  )
+  {
+    std::string const entry_path{ getEntryPath(directory, key) };
+    std::string const temporary_path{ std::format(
+      "{}.{}.{}.tmp",
+      entry_path,
+      ::getpid(),
+      std::hash<std::thread::id>{}(std::this_thread::get_id())
+    ) };
+    try {
+      writeOutputFile(temporary_path, std::as_bytes(std::span{ assembly }));
+    } catch (OutputFileError const &) {
+      std::error_code error{};
+      std::filesystem::remove(temporary_path, error);
+      return;
+    }
+    std::error_code error{};
+    std::uintmax_t  replaced_size{
+      std::filesystem::file_size(entry_path, error)
+    };
+    if (error) replaced_size = 0;
+    std::filesystem::rename(temporary_path, entry_path, error);
+    if (error) {
+      std::filesystem::remove(temporary_path, error);
+      return;
+    }
+    try {
+      FileLock const lock{ directory / "stats.lock" };
+      auto           state{ readCacheState(directory) };
+      // A size that was never recorded is found by scanning.
+      if (state.size)
+        state.size = *state.size - std::min(*state.size, replaced_size)
+                     + assembly.size();
+      if (!state.size || *state.size > max_size) state.size = evict();
+      writeCacheState(directory, state);
+    } catch (CompilerError const &) {
+      // Losing track of the size only delays eviction until the next store
+      // that manages to record it.
+    }
+  }
+
+  std::uintmax_t CompilationCache::evict()
+  {
+    struct Entry
+    {
+      std::filesystem::path           path{};
+      std::uintmax_t                  size{};
+      std::filesystem::file_time_type last_use{};
+    };
+
+    auto const         now{ std::filesystem::file_time_type::clock::now() };
+    std::vector<Entry> entries{};
+    std::uintmax_t     total_size{};
+    std::error_code    error{};
+    for (std::filesystem::directory_iterator iterator{ directory, error };
+         !error && iterator != std::filesystem::directory_iterator{};
+         iterator.increment(error)) {
+      std::error_code size_error{};
+      std::error_code time_error{};
+      Entry           entry{
+        .path     = iterator->path(),
+        .size     = iterator->file_size(size_error),
+        .last_use = iterator->last_write_time(time_error)
+      };
+      if (size_error || time_error) continue;
+      if (entry.path.extension() == ".tmp") {
+        std::error_code remove_error{};
+        if (now - entry.last_use > stale_temporary_age)
+          std::filesystem::remove(entry.path, remove_error);
+        continue;
+      }
+      if (entry.path.extension() != ".s") continue;
+      total_size += entry.size;
+      entries.push_back(std::move(entry));
+    }
+    if (total_size <= max_size) return total_size;
+    std::uintmax_t const target_size{
+      max_size - max_size / eviction_slack_divisor
+    };
+    std::ranges::sort(entries, {}, &Entry::last_use);
+    for (auto const &entry: entries) {
+      if (total_size <= target_size) break;
+      // Another process may have evicted the entry already.
+      if (std::filesystem::remove(entry.path, error)) ++evictions;
+      total_size -= entry.size;
+    }
+    return total_size;
+  }
+
+  CompilationCacheStatistics CompilationCache::getStatistics() const noexcept
+  {
+    return { .hits = hits, .misses = misses, .evictions = evictions };
+  }
+
+  void CompilationCache::saveStatistics()
+  {
+    FileLock const lock{ directory / "stats.lock" };
+    auto           state{ readCacheState(directory) };
+    state.statistics.hits      += hits.exchange(0);
+    state.statistics.misses    += misses.exchange(0);
+    state.statistics.evictions += evictions.exchange(0);
+    writeCacheState(directory, state);
+  }
+
+  CompilationCacheStatistics
+  CompilationCache::loadStatistics(std::filesystem::path const &directory)
+  {
+    return readCacheState(directory).statistics;
+  }
+} // namespace SC2
@@ -0,0 +1,33 @@
+#include <sc2/assembly_ast.hpp>
+#include <sc2/ast.hpp>
+#include <sc2/compilation_context.hpp>
+#include <sc2/parser.hpp>
+#include <sc2/tacky_ast.hpp>
+#include <sc2/token_buffer.hpp>
+#include <string_view>
+
+#include <memory>
+
+namespace SC2 {
+  std::shared_ptr<ProgramASTNode>
+  CompilationContext::parse(std::string_view const program_text)
+  {
+    NodeArenaScope const arena_scope{ arena };
+    TokenBuffer const    tokens{ program_text, string_interner };
+    tokens.throwIfInvalid();
+    Parser parser{ tokens, *this };
+    return parser.parseProgram();
+  }
+
+  std::shared_ptr<ProgramAssemblyASTNode>
+  CompilationContext::compile(std::string_view const program_text)
+  {
+    NodeArenaScope const arena_scope{ arena };
+    auto const           assembly{
+      parse(program_text)->emitTACKY()->emitAssembly()->allocateRegisters()
+    };
+    auto const last_offset{ assembly->replacePseudoRegisters() };
+    assembly->fixUp(-last_offset);
+    return assembly;
+  }
+} // namespace SC2
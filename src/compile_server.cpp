@@ -0,0 +1,554 @@
+#include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
+#include <sc2/ast.hpp>
+#include <sc2/compilation_context.hpp>
+#include <sc2/compile_server.hpp>
+#include <sc2/preprocessor.hpp>
+#include <sc2/tacky_ast.hpp>
+#include <sc2/thread_pool.hpp>
+#include <sc2/token_buffer.hpp>
+#include <string_view>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace SC2 {
+  namespace {
+    // Guards the server against a length that could not be a real request.
+    constexpr std::uint64_t max_request_string_size{ 1ULL << 30 };
+    // How much of a request the watching thread reads from a connection each
+    // time it polls as readable.
+    constexpr std::size_t receive_chunk_size{ 1 << 16 };
+    // How long a worker waits for a client to make room for more of its
+    // response before dropping the connection.
+    constexpr int response_timeout_milliseconds{ 10'000 };
+
+    // Closes the socket or pipe when it goes out of scope.
+    class FileDescriptor
+    {
+      int descriptor{ -1 };
+
+      public:
+      explicit FileDescriptor(int const descriptor): descriptor{ descriptor }
+      {}
+
+      FileDescriptor(FileDescriptor const &)            = delete;
+      FileDescriptor &operator=(FileDescriptor const &) = delete;
+
+      ~FileDescriptor()
+      {
+        if (descriptor >= 0) ::close(descriptor);
+      }
+
+      [[nodiscard]] int get() const noexcept { return descriptor; }
+    };
+
+    [[nodiscard]] ::sockaddr_un
+    getSocketAddress(std::filesystem::path const &socket_path)
+    {
+      ::sockaddr_un address{};
+      address.sun_family = AF_UNIX;
+      std::string const &path{ socket_path.native() };
+      if (path.size() >= sizeof address.sun_path)
+        throw CompileServerError(
+          std::format("socket path {} is too long", path)
+        );
+      std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+      return address;
+    }
+
+    // Waits until the descriptor is ready for the events, and throws if the
+    // stop descriptor becomes readable first or the wait times out. Without
+    // a stop descriptor the socket is simply left to block.
+    void waitUntilReady(
+      int const   descriptor,
+      short const events,
+      int const   stop_descriptor,
+      int const   timeout_milliseconds = -1
+    )
+    {
+      if (stop_descriptor < 0) return;
+      ::pollfd descriptors[]{
+        { .fd = descriptor, .events = events, .revents = 0 },
+        { .fd = stop_descriptor, .events = POLLIN, .revents = 0 }
+      };
+      int ready_count{};
+      while ((ready_count = ::poll(descriptors, 2, timeout_milliseconds)) < 0)
+        if (errno != EINTR) throw CompileServerError("poll", errno);
+      if (descriptors[1].revents != 0)
+        throw CompileServerError("server is stopping");
+      if (ready_count == 0) throw CompileServerError("client stopped reading");
+    }
+
+    // Returns false if the peer closed the connection before sending
+    // anything, and throws if it closed it part way through.
+    [[nodiscard]] bool
+    readExactly(int const descriptor, void * const data, std::size_t size)
+    {
+      auto *position{ static_cast<char *>(data) };
+      while (size > 0) {
+        ::ssize_t const received{ ::recv(descriptor, position, size, 0) };
+        if (received < 0) {
+          if (errno == EINTR) continue;
+          throw CompileServerError("recv", errno);
+        }
+        if (received == 0) {
+          if (position == data) return false;
+          throw CompileServerError("connection closed part way through");
+        }
+        position += received;
+        size     -= static_cast<std::size_t>(received);
+      }
+      return true;
+    }
+
+    void writeAll(
+      int const          descriptor,
+      void const * const data,
+      std::size_t        size,
+      int const          stop_descriptor = -1
+    )
+    {
+      auto const *position{ static_cast<char const *>(data) };
+      // With a stop descriptor, a client that stops reading must not block
+      // the send past the point where the socket buffer is full, nor hold
+      // the worker sending to it for longer than the timeout.
+      int const flags{ stop_descriptor < 0 ? MSG_NOSIGNAL
+                                           : MSG_NOSIGNAL | MSG_DONTWAIT };
+      while (size > 0) {
+        waitUntilReady(
+          descriptor,
+          POLLOUT,
+          stop_descriptor,
+          response_timeout_milliseconds
+        );
+        // MSG_NOSIGNAL turns a vanished peer into EPIPE instead of SIGPIPE.
+        ::ssize_t const sent{ ::send(descriptor, position, size, flags) };
+        if (sent < 0) {
+          if (errno == EINTR || errno == EAGAIN) continue;
+          throw CompileServerError("send", errno);
+        }
+        position += sent;
+        size     -= static_cast<std::size_t>(sent);
+      }
+    }
+
+    void writeString(
+      int const              descriptor,
+      std::string_view const string,
+      int const              stop_descriptor = -1
+    )
+    {
+      std::uint64_t const size{ string.size() };
+      writeAll(descriptor, &size, sizeof size, stop_descriptor);
+      writeAll(descriptor, string.data(), string.size(), stop_descriptor);
+    }
+
+    [[nodiscard]] std::optional<std::string> readString(int const descriptor)
+    {
+      std::uint64_t size{};
+      if (!readExactly(descriptor, &size, sizeof size)) return std::nullopt;
+      if (size > max_request_string_size)
+        throw CompileServerError(std::format("{} bytes is too long", size));
+      std::string string(size, '\0');
+      if (size > 0 && !readExactly(descriptor, string.data(), size))
+        throw CompileServerError("connection closed part way through");
+      return string;
+    }
+
+    [[nodiscard]] std::string
+    readRequiredString(int const descriptor, std::string_view const field)
+    {
+      auto string{ readString(descriptor) };
+      if (!string)
+        throw CompileServerError(std::format("request has no {}", field));
+      return std::move(*string);
+    }
+
+    struct Request
+    {
+      std::string options{};
+      std::string source_path{};
+      std::string source{};
+    };
+
+    // An open connection, with the bytes received on it that do not yet make
+    // up a whole request.
+    struct Connection
+    {
+      int         descriptor{ -1 };
+      std::string received{};
+    };
+
+    struct ReadyRequest
+    {
+      Connection connection{};
+      Request    request{};
+    };
+
+    // Reads what the client has sent so far without blocking. Returns false
+    // once the connection is to be closed: the client closed it, part way
+    // through a request or not, or the read failed.
+    [[nodiscard]] bool receiveAvailable(Connection &connection)
+    {
+      std::size_t const size{ connection.received.size() };
+      connection.received.resize(size + receive_chunk_size);
+      ::ssize_t received{};
+      do
+        received = ::recv(
+          connection.descriptor,
+          connection.received.data() + size,
+          receive_chunk_size,
+          MSG_DONTWAIT
+        );
+      while (received < 0 && errno == EINTR);
+      int const error_number{ errno };
+      connection.received.resize(
+        size + static_cast<std::size_t>(std::max<::ssize_t>(received, 0))
+      );
+      return received > 0
+          || (received < 0
+              && (error_number == EAGAIN || error_number == EWOULDBLOCK));
+    }
+
+    // Takes the first whole request off the bytes received, or returns
+    // nullopt if they do not hold one yet. Throws if a string in it is longer
+    // than any real request's.
+    [[nodiscard]] std::optional<Request> takeRequest(std::string &received)
+    {
+      std::string_view const available{ received };
+      std::string_view       fields[3]{};
+      std::size_t            position{};
+      for (std::string_view &field: fields) {
+        std::uint64_t size{};
+        if (available.size() - position < sizeof size) return std::nullopt;
+        std::memcpy(&size, available.data() + position, sizeof size);
+        if (size > max_request_string_size)
+          throw CompileServerError(std::format("{} bytes is too long", size));
+        position += sizeof size;
+        if (available.size() - position < size) return std::nullopt;
+        field     = available.substr(position, size);
+        position += size;
+      }
+      Request request{ .options     = std::string{ fields[0] },
+                       .source_path = std::string{ fields[1] },
+                       .source      = std::string{ fields[2] } };
+      received.erase(0, position);
+      return request;
+    }
+
+    void answerRequest(
+      int const      connection,
+      Request const &request,
+      int const      stop_descriptor
+    )
+    {
+      auto const [succeeded, output]{
+        compileRequest(request.options, request.source_path, request.source)
+      };
+      char const status{ succeeded };
+      writeAll(connection, &status, sizeof status, stop_descriptor);
+      writeString(connection, output, stop_descriptor);
+    }
+
+    // Reads whatever is in a non-blocking pipe, so that it polls as empty.
+    void drainPipe(int const descriptor) noexcept
+    {
+      char buffer[64];
+      while (::read(descriptor, buffer, sizeof buffer) > 0) {}
+    }
+  } // namespace
+
+  CompileResult compileRequest(
+    std::string_view const       options,
+    std::filesystem::path const &source_path,
+    std::string_view const       source
+  )
+  {
+    if (!options.empty() && options != "-S" && options != "--lex"
+        && options != "--parse" && options != "--validate"
+        && options != "--tacky" && options != "--codegen")
+      return { .succeeded = false,
+               .output    = std::format("Invalid option: {}", options) };
+    try {
+      std::string const  program_text{
+        Preprocessor{}.preprocess(source, source_path)
+      };
+      CompilationContext context{};
+      if (options == "--lex") {
+        TokenBuffer{ program_text, context.getStringInterner() }
+          .throwIfInvalid();
+        return { .succeeded = true };
+      }
+      if (options == "--parse" || options == "--validate") {
+        static_cast<void>(context.parse(program_text));
+        return { .succeeded = true };
+      }
+      if (options == "--tacky") {
+        auto const           program{ context.parse(program_text) };
+        NodeArenaScope const arena_scope{ context.getArena() };
+        static_cast<void>(program->emitTACKY());
+        return { .succeeded = true };
+      }
+      auto const assembly{ context.compile(program_text) };
+      if (options == "--codegen") return { .succeeded = true };
+      AssemblyBuffer assembly_buffer{};
+      assembly->emitCode(assembly_buffer);
+      return { .succeeded = true,
+               .output    = std::string{ assembly_buffer.getText() } };
+    } catch (std::exception const &exception) {
+      return { .succeeded = false, .output = exception.what() };
+    }
+  }
+
+  CompileServer::CompileServer(std::filesystem::path socket_path)
+    : socket_path{ std::move(socket_path) }
+  {
+    ::sockaddr_un const address{ getSocketAddress(this->socket_path) };
+    // Non-blocking, so that accepting a connection its client has already
+    // given up on cannot block the thread watching every connection.
+    listening_socket
+      = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (listening_socket < 0) throw CompileServerError("socket", errno);
+    std::error_code error{};
+    if (std::filesystem::is_socket(this->socket_path, error))
+      std::filesystem::remove(this->socket_path, error);
+    auto const fail{ [this](char const * const operation) {
+      int const error_number{ errno };
+      ::close(listening_socket);
+      throw CompileServerError(operation, error_number);
+    } };
+    if (::bind(
+          listening_socket,
+          reinterpret_cast<::sockaddr const *>(&address),
+          sizeof address
+        )
+        < 0)
+      fail("bind");
+    if (::listen(listening_socket, SOMAXCONN) < 0) fail("listen");
+    if (::pipe2(stop_pipe, O_CLOEXEC | O_NONBLOCK) < 0) fail("pipe2");
+  }
+
+  CompileServer::~CompileServer()
+  {
+    ::close(listening_socket);
+    ::close(stop_pipe[0]);
+    ::close(stop_pipe[1]);
+    std::error_code error{};
+    std::filesystem::remove(socket_path, error);
+  }
+
+  void CompileServer::run(std::size_t const thread_count)
+  {
+    int wake_pipe[2]{};
+    if (::pipe2(wake_pipe, O_CLOEXEC | O_NONBLOCK) < 0)
+      throw CompileServerError("pipe2", errno);
+    FileDescriptor const wake_reader{ wake_pipe[0] };
+    FileDescriptor const wake_writer{ wake_pipe[1] };
+    // Whole requests waiting for a worker, and connections whose request a
+    // worker has answered, waiting to be watched for the next one.
+    std::mutex               mutex{};
+    std::condition_variable  ready_condition{};
+    std::deque<ReadyRequest> ready_requests{};
+    std::vector<Connection>  answered_connections{};
+    bool                     is_finished{};
+    std::exception_ptr       failure{};
+    // Connections waiting for their client to send the rest of a request,
+    // which only this thread touches.
+    std::vector<Connection> idle_connections{};
+    {
+      std::vector<std::jthread> workers{};
+      auto const work{ [&] {
+        while (true) {
+          std::optional<ReadyRequest> ready_request{};
+          {
+            std::unique_lock lock{ mutex };
+            ready_condition.wait(lock, [&] {
+              return is_finished || !ready_requests.empty();
+            });
+            if (is_finished) return;
+            ready_request = std::move(ready_requests.front());
+            ready_requests.pop_front();
+          }
+          auto &[connection, request]{ *ready_request };
+          try {
+            answerRequest(connection.descriptor, request, stop_pipe[0]);
+          } catch (std::exception const &) {
+            // The client went away or stopped reading, the response did not
+            // fit in memory or the server is stopping; only this connection
+            // is dropped.
+            ::close(connection.descriptor);
+            continue;
+          }
+          {
+            std::scoped_lock const lock{ mutex };
+            answered_connections.push_back(std::move(connection));
+          }
+          // A full pipe already wakes the watching thread.
+          char const byte{};
+          static_cast<void>(::write(wake_writer.get(), &byte, sizeof byte));
+        }
+      } };
+      try {
+        while (workers.size() < std::max<std::size_t>(thread_count, 1))
+          workers.emplace_back(work);
+        // This thread reads requests as their bytes arrive, and workers are
+        // only handed whole ones, so a client that keeps a connection open
+        // without finishing its request holds no worker.
+        std::vector<::pollfd>     descriptors{};
+        std::vector<Connection>   still_idle_connections{};
+        std::vector<ReadyRequest> new_ready_requests{};
+        // Queues the connection's request if it has received a whole one, and
+        // otherwise keeps watching it.
+        auto const watch{ [&](Connection connection) {
+          std::optional<Request> request{};
+          try {
+            request = takeRequest(connection.received);
+          } catch (CompileServerError const &) {
+            ::close(connection.descriptor);
+            return;
+          }
+          if (request)
+            new_ready_requests.push_back(
+              { std::move(connection), std::move(*request) }
+            );
+          else
+            still_idle_connections.push_back(std::move(connection));
+        } };
+        while (true) {
+          descriptors.clear();
+          for (int const descriptor:
+               { stop_pipe[0], wake_reader.get(), listening_socket })
+            descriptors.push_back(
+              { .fd = descriptor, .events = POLLIN, .revents = 0 }
+            );
+          for (Connection const &connection: idle_connections)
+            descriptors.push_back(
+              { .fd = connection.descriptor, .events = POLLIN, .revents = 0 }
+            );
+          if (::poll(descriptors.data(), descriptors.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            throw CompileServerError("poll", errno);
+          }
+          if (descriptors[0].revents != 0) break;
+          for (std::size_t index{}; index < idle_connections.size(); ++index) {
+            Connection &connection{ idle_connections[index] };
+            if (descriptors[index + 3].revents == 0)
+              still_idle_connections.push_back(std::move(connection));
+            else if (receiveAvailable(connection))
+              watch(std::move(connection));
+            else
+              ::close(connection.descriptor);
+          }
+          if (descriptors[1].revents != 0) {
+            drainPipe(wake_reader.get());
+            std::vector<Connection> connections{};
+            {
+              std::scoped_lock const lock{ mutex };
+              connections.swap(answered_connections);
+            }
+            // A client may have sent its next request before reading the
+            // response to the last one.
+            for (Connection &connection: connections)
+              watch(std::move(connection));
+          }
+          if (descriptors[2].revents != 0)
+            while (true) {
+              int const connection{
+                ::accept4(listening_socket, nullptr, nullptr, SOCK_CLOEXEC)
+              };
+              if (connection < 0) break;
+              still_idle_connections.push_back({ .descriptor = connection });
+            }
+          idle_connections.swap(still_idle_connections);
+          still_idle_connections.clear();
+          if (!new_ready_requests.empty()) {
+            {
+              std::scoped_lock const lock{ mutex };
+              for (ReadyRequest &ready_request: new_ready_requests)
+                ready_requests.push_back(std::move(ready_request));
+            }
+            new_ready_requests.clear();
+            ready_condition.notify_all();
+          }
+        }
+      } catch (...) {
+        failure = std::current_exception();
+      }
+      {
+        std::scoped_lock const lock{ mutex };
+        is_finished = true;
+      }
+      ready_condition.notify_all();
+    }
+    // Every worker has returned, so the connections still open are closed
+    // without waiting for their clients.
+    for (Connection const &connection: idle_connections)
+      ::close(connection.descriptor);
+    for (ReadyRequest const &ready_request: ready_requests)
+      ::close(ready_request.connection.descriptor);
+    for (Connection const &connection: answered_connections)
+      ::close(connection.descriptor);
+    if (failure) std::rethrow_exception(failure);
+  }
+
+  void CompileServer::stop() noexcept
+  {
+    // Called from signal handlers, so only async-signal-safe calls. The pipe
+    // is never read, so it stays readable for every thread that polls it.
+    int const  saved_errno{ errno };
+    char const byte{};
+    static_cast<void>(::write(stop_pipe[1], &byte, sizeof byte));
+    errno = saved_errno;
+  }
+
+  CompileResult requestCompilation(
+    std::filesystem::path const &socket_path,
+    std::string_view const       options,
+    std::filesystem::path const &source_path,
+    std::string_view const       source
+  )
+  {
+    ::sockaddr_un const  address{ getSocketAddress(socket_path) };
+    FileDescriptor const descriptor{
+      ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)
+    };
+    if (descriptor.get() < 0) throw CompileServerError("socket", errno);
+    if (::connect(
+          descriptor.get(),
+          reinterpret_cast<::sockaddr const *>(&address),
+          sizeof address
+        )
+        < 0)
+      throw CompileServerError("connect", errno);
+    writeString(descriptor.get(), options);
+    writeString(descriptor.get(), source_path.native());
+    writeString(descriptor.get(), source);
+    char status{};
+    if (!readExactly(descriptor.get(), &status, sizeof status))
+      throw CompileServerError("server closed the connection");
+    return { .succeeded = status != 0,
+             .output = readRequiredString(descriptor.get(), "response") };
+  }
+} // namespace SC2
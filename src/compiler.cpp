@@ -1,35 +1,141 @@
 #include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
 #include <sc2/ast.hpp>
+#include <sc2/batch.hpp>
+#include <sc2/compilation_cache.hpp>
+#include <sc2/compilation_context.hpp>
+#include <sc2/compile_server.hpp>
 #include <sc2/compiler_error.hpp>
-#include <sc2/lexer.hpp>
+#include <sc2/driver.hpp>
+#include <sc2/elf_object_writer.hpp>
+#include <sc2/input_file.hpp>
+#include <sc2/jit.hpp>
+#include <sc2/output_file.hpp>
 #include <sc2/parser.hpp>
+#include <sc2/preprocessor.hpp>
 #include <sc2/tacky_ast.hpp>
+#include <sc2/token_buffer.hpp>
+#include <string_view>
 
+#include <atomic>
+#include <charconv>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <format>
-#include <fstream>
-#include <iostream>
+#include <memory>
 #include <optional>
 #include <print>
-#include <regex>
-#include <sstream>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <utility>
+#include <vector>
 
 constexpr char const * const usage_error_message{
-  "Error: Usage: sc2 [-(-(lex|parse|codegen|tacky)|S)] /path/to/file.c\n"
+  "Error: Usage: sc2 [-(-(lex|parse|codegen|tacky|run|run-sandboxed)|S|c)] /path/to/file.c\n"
+  "       sc2 --batch (/path/to/file.c|@response-file)...\n"
+  "       sc2 --cache-stats\n"
+  "       sc2 --serve /path/to/socket\n"
 };
 
 void exit_with_usage_error_message()
 {
-  std::cerr << usage_error_message;
+  std::print(stderr, "{}", usage_error_message);
   std::exit(EXIT_FAILURE);
 }
 
+// Setting SC2_CACHE_DIR turns on the compilation cache, and SC2_CACHE_SIZE
+// bounds it to that many bytes.
+[[nodiscard]] std::unique_ptr<SC2::CompilationCache> openCompilationCache()
+{
+  char const * const cache_directory{ std::getenv("SC2_CACHE_DIR") };
+  if (!cache_directory) return nullptr;
+  std::uintmax_t cache_size{ SC2::default_compilation_cache_size };
+  if (char const * const cache_size_text{ std::getenv("SC2_CACHE_SIZE") }) {
+    std::string_view const text{ cache_size_text };
+    auto const [end, error]{
+      std::from_chars(text.data(), text.data() + text.size(), cache_size)
+    };
+    if (error != std::errc{} || end != text.data() + text.size())
+      throw SC2::CompilationCacheError(
+        cache_directory,
+        std::format("SC2_CACHE_SIZE is not a number of bytes: {}", text)
+      );
+  }
+  return std::make_unique<SC2::CompilationCache>(cache_directory, cache_size);
+}
+
+std::atomic<SC2::CompileServer *> running_server{};
+
+// Lets SIGINT and SIGTERM stop the server cleanly, so that it removes its
+// socket.
+extern "C" void stopRunningServer(int)
+{
+  if (auto * const server{ running_server.load() }) server->stop();
+}
+
 int main(int argc, char const * const * const argv)
 {
   using namespace std::literals::string_literals;
+  if (argc == 2 && argv[1] == "--cache-stats"s) {
+    char const * const cache_directory{ std::getenv("SC2_CACHE_DIR") };
+    if (!cache_directory) {
+      std::print(stderr, "Usage error:\nSC2_CACHE_DIR is not set\n");
+      return EXIT_FAILURE;
+    }
+    auto const [hits, misses, evictions]{
+      SC2::CompilationCache::loadStatistics(cache_directory)
+    };
+    std::println(
+      "hits: {}\nmisses: {}\nevictions: {}",
+      hits,
+      misses,
+      evictions
+    );
+    return EXIT_SUCCESS;
+  }
+  if (argc == 3 && argv[1] == "--serve"s) {
+    try {
+      SC2::CompileServer server{ argv[2] };
+      running_server = &server;
+      std::signal(SIGINT, stopRunningServer);
+      std::signal(SIGTERM, stopRunningServer);
+      server.run();
+      running_server = nullptr;
+      return EXIT_SUCCESS;
+    } catch (SC2::CompilerError const &exception) {
+      std::println(stderr, "Compiler error:\n{}", exception.what());
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  if (argc > 2 && argv[1] == "--batch"s) {
+    try {
+      auto const source_paths{ SC2::expandResponseFiles(
+        std::vector<std::string>(argv + 2, argv + argc)
+      ) };
+      auto const cache{ openCompilationCache() };
+      auto const failures{ SC2::compileBatch(
+        source_paths,
+        SC2::getDefaultThreadCount(),
+        cache.get()
+      ) };
+      if (cache) cache->saveStatistics();
+      for (auto const &[source_path, message]: failures)
+        std::println(
+          stderr,
+          "Compiler error:\n{}: {}",
+          source_path,
+          message
+        );
+      return failures.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (SC2::CompilerError const &exception) {
+      std::println(stderr, "Compiler error:\n{}", exception.what());
+      std::exit(EXIT_FAILURE);
+    }
+  }
   if (argc < 2 || argc > 3)
     throw std::runtime_error("Wrong number of arguments");
   try {
@@ -37,7 +143,9 @@ int main(int argc, char const * const * const argv)
       if (argc == 3) {
         if (argv[1] != "--lex"s && argv[1] != "--parse"s
             && argv[1] != "--codegen"s && argv[1] != "--tacky"s
-            && argv[1] != "--validate"s && argv[1] != "-S"s)
+            && argv[1] != "--validate"s && argv[1] != "-S"s
+            && argv[1] != "-c"s && argv[1] != "--run"s
+            && argv[1] != "--run-sandboxed"s)
           throw std::invalid_argument(
             std::format("Invalid long option: {}", argv[1])
           );
@@ -54,37 +162,75 @@ int main(int argc, char const * const * const argv)
     auto const &file_basename{
       preprocessed_file.substr(0, preprocessed_file.length() - 2)
     };
-    auto const &file_stream{ std::ifstream(preprocessed_file) };
-    if (!file_stream) {
-      std::perror("File opening failed");
-      return EXIT_FAILURE;
-    }
-    std::ostringstream program_buffer{};
-    program_buffer << file_stream.rdbuf();
-    std::string const program_text{ program_buffer.str() };
-    SC2::Lexer        dummy_lexer{ program_text };
-    for (auto const &token: dummy_lexer); // NOLINT
+    // Given C source rather than preprocessed source, sc2 is the whole
+    // driver: it preprocesses the source in process, and runs the assembler
+    // and linker itself.
+    bool const is_source_file{ preprocessed_file.ends_with(".c") };
+    // Preprocessed source is lexed straight from the input file.
+    std::string                   preprocessed_text{};
+    std::optional<SC2::InputFile> input_file{};
+    if (is_source_file)
+      preprocessed_text = SC2::Preprocessor{}.preprocessFile(preprocessed_file);
+    else
+      input_file.emplace(preprocessed_file);
+    std::string_view const program_text{ input_file ? input_file->getText()
+                                                    : preprocessed_text };
+    auto const emit_assembly{ [&](std::string_view const assembly_text) {
+      if (is_source_file && !option)
+        SC2::assembleAndLink(assembly_text, file_basename);
+      else
+        SC2::writeOutputFile(
+          file_basename + ".s",
+          std::as_bytes(std::span{ assembly_text })
+        );
+    } };
+    // Only the modes that end in assembly text can be answered from the
+    // cache, and a hit skips the whole pipeline.
+    auto const cache{ !option || *option == "-S" ? openCompilationCache()
+                                                 : nullptr };
+    auto const cache_key{ cache ? cache->getKey(program_text) : std::string{} };
+    if (cache)
+      if (auto const cached_assembly{ cache->lookUp(cache_key) }) {
+        emit_assembly(*cached_assembly);
+        cache->saveStatistics();
+        return EXIT_SUCCESS;
+      }
+    SC2::CompilationContext context{};
+    SC2::TokenBuffer const tokens{ program_text, context.getStringInterner() };
+    tokens.throwIfInvalid();
     if (option && *option == "--lex") return EXIT_SUCCESS;
-    SC2::Lexer  lexer{ program_text };
-    SC2::Parser parser{ lexer };
-    auto const  program{ parser.parseProgram() };
+    SC2::NodeArenaScope const arena_scope{ context.getArena() };
+    SC2::Parser               parser{ tokens, context };
+    auto const                program{ parser.parseProgram() };
     if (option && (*option == "--parse" || *option == "--validate"))
       return EXIT_SUCCESS;
     auto const tacky{ program->emitTACKY() };
     if (option && *option == "--tacky") return EXIT_SUCCESS;
-    auto const assembly{ tacky->emitAssembly() };
-    auto const [last_offset, _, cleaned_assembly]{
-      assembly->replacePseudoRegisters()
-    };
-    auto const fixed_assembly{ cleaned_assembly->fixUp(-last_offset) };
+    auto const assembly{ tacky->emitAssembly()->allocateRegisters() };
+    auto const last_offset{ assembly->replacePseudoRegisters() };
+    assembly->fixUp(-last_offset);
     if (option && *option == "--codegen") return EXIT_SUCCESS;
-    auto output_file_stream{ std::ofstream(file_basename + ".s") };
-    fixed_assembly->emitCode(output_file_stream);
+    if (option && *option == "--run") return SC2::runProgram(*assembly);
+    if (option && *option == "--run-sandboxed")
+      return SC2::runProgramInChildProcess(*assembly);
+    if (option && *option == "-c") {
+      SC2::ElfObjectWriter object_writer{};
+      assembly->encode(object_writer);
+      object_writer.writeToFile(file_basename + ".o");
+      return EXIT_SUCCESS;
+    }
+    SC2::AssemblyBuffer assembly_buffer{};
+    assembly->emitCode(assembly_buffer);
+    if (cache) {
+      cache->store(cache_key, assembly_buffer.getText());
+      cache->saveStatistics();
+    }
+    emit_assembly(assembly_buffer.getText());
   } catch (SC2::CompilerError const &exception) {
-    std::cerr << "Compiler error:\n" << exception.what();
+    std::print(stderr, "Compiler error:\n{}", exception.what());
     std::exit(EXIT_FAILURE);
   } catch (std::exception const &exception) {
-    std::cerr << "Usage error:\n" << exception.what() << '\n';
+    std::println(stderr, "Usage error:\n{}", exception.what());
     exit_with_usage_error_message();
   }
   return EXIT_SUCCESS;
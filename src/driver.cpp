@@ -0,0 +1,223 @@
+#include <sc2/driver.hpp>
+#include <string_view>
+
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <format>
+#include <string>
+#include <vector>
+
+extern char **environ;
+
+namespace SC2 {
+  namespace {
+    constexpr char const *compiler_program{ "gcc" };
+
+    // The two ends of a pipe, closed when it goes out of scope.
+    class Pipe
+    {
+      std::array<int, 2> file_descriptors{ -1, -1 };
+
+      public:
+      Pipe()
+      {
+        if (::pipe(file_descriptors.data()) < 0)
+          throw ProcessError(compiler_program, errno);
+      }
+
+      Pipe(Pipe const &)            = delete;
+      Pipe &operator=(Pipe const &) = delete;
+
+      ~Pipe()
+      {
+        closeReadEnd();
+        closeWriteEnd();
+      }
+
+      [[nodiscard]] int getReadEnd() const noexcept
+      {
+        return file_descriptors[0];
+      }
+
+      [[nodiscard]] int getWriteEnd() const noexcept
+      {
+        return file_descriptors[1];
+      }
+
+      void closeReadEnd() noexcept
+      {
+        if (file_descriptors[0] >= 0) ::close(file_descriptors[0]);
+        file_descriptors[0] = -1;
+      }
+
+      void closeWriteEnd() noexcept
+      {
+        if (file_descriptors[1] >= 0) ::close(file_descriptors[1]);
+        file_descriptors[1] = -1;
+      }
+    };
+
+    // Blocks SIGPIPE on the calling thread while it is in scope, so that
+    // writing to a pipe whose reader has exited fails with EPIPE instead of
+    // killing the process, without touching the process-wide disposition that
+    // a host program may rely on. A SIGPIPE raised meanwhile is consumed
+    // before the previous mask is restored, unless one was already pending.
+    class SigpipeBlocker
+    {
+      ::sigset_t sigpipe_set{};
+      ::sigset_t previous_mask{};
+      bool       was_pending{};
+
+      public:
+      SigpipeBlocker() noexcept
+      {
+        ::sigemptyset(&sigpipe_set);
+        ::sigaddset(&sigpipe_set, SIGPIPE);
+        ::sigset_t pending_set{};
+        ::sigpending(&pending_set);
+        was_pending = ::sigismember(&pending_set, SIGPIPE) == 1;
+        ::pthread_sigmask(SIG_BLOCK, &sigpipe_set, &previous_mask);
+      }
+
+      SigpipeBlocker(SigpipeBlocker const &)            = delete;
+      SigpipeBlocker &operator=(SigpipeBlocker const &) = delete;
+
+      ~SigpipeBlocker()
+      {
+        int const saved_errno{ errno };
+        if (!was_pending) {
+          ::timespec const no_wait{};
+          while (::sigtimedwait(&sigpipe_set, nullptr, &no_wait) < 0
+                 && errno == EINTR) {}
+        }
+        ::pthread_sigmask(SIG_SETMASK, &previous_mask, nullptr);
+        errno = saved_errno;
+      }
+    };
+
+    // Starts the system compiler with one end of the pipe as its standard
+    // input or output.
+    [[nodiscard]] ::pid_t spawnCompiler(
+      std::vector<std::string> const &arguments,
+      Pipe const                     &pipe,
+      int                             redirected_file_descriptor
+    )
+    {
+      ::posix_spawn_file_actions_t file_actions{};
+      ::posix_spawn_file_actions_init(&file_actions);
+      ::posix_spawn_file_actions_adddup2(
+        &file_actions,
+        redirected_file_descriptor == STDIN_FILENO ? pipe.getReadEnd() :
+                                                     pipe.getWriteEnd(),
+        redirected_file_descriptor
+      );
+      ::posix_spawn_file_actions_addclose(&file_actions, pipe.getReadEnd());
+      ::posix_spawn_file_actions_addclose(&file_actions, pipe.getWriteEnd());
+
+      std::vector<char *> argv{};
+      argv.reserve(arguments.size() + 1);
+      for (auto const &argument: arguments)
+        argv.push_back(const_cast<char *>(argument.c_str()));
+      argv.push_back(nullptr);
+
+      ::pid_t   process{};
+      int const error_number{ ::posix_spawnp(
+        &process,
+        compiler_program,
+        &file_actions,
+        nullptr,
+        argv.data(),
+        environ
+      ) };
+      ::posix_spawn_file_actions_destroy(&file_actions);
+      if (error_number != 0) throw ProcessError(compiler_program, error_number);
+      return process;
+    }
+
+    void waitForCompiler(::pid_t process)
+    {
+      int status{};
+      while (::waitpid(process, &status, 0) < 0)
+        if (errno != EINTR) throw ProcessError(compiler_program, errno);
+      if (!WIFEXITED(status))
+        throw ProcessError(
+          compiler_program,
+          std::format("killed by signal {}", WTERMSIG(status))
+        );
+      if (WEXITSTATUS(status) != 0)
+        throw ProcessError(
+          compiler_program,
+          std::format("exited with status {}", WEXITSTATUS(status))
+        );
+    }
+  } // namespace
+
+  [[nodiscard]] std::string preprocess(std::string const &source_path)
+  {
+    Pipe          pipe{};
+    ::pid_t const process{ spawnCompiler(
+      { compiler_program, "-E", "-P", source_path },
+      pipe,
+      STDOUT_FILENO
+    ) };
+    pipe.closeWriteEnd();
+    std::string             program_text{};
+    std::array<char, 65536> chunk{};
+    while (true) {
+      ::ssize_t const size{
+        ::read(pipe.getReadEnd(), chunk.data(), chunk.size())
+      };
+      if (size == 0) break;
+      if (size < 0) {
+        if (errno == EINTR) continue;
+        int const error_number{ errno };
+        pipe.closeReadEnd();
+        waitForCompiler(process);
+        throw ProcessError(compiler_program, error_number);
+      }
+      program_text.append(chunk.data(), static_cast<std::size_t>(size));
+    }
+    waitForCompiler(process);
+    return program_text;
+  }
+
+  void assembleAndLink(
+    std::string_view   assembly,
+    std::string const &executable_path
+  )
+  {
+    Pipe          pipe{};
+    ::pid_t const process{ spawnCompiler(
+      { compiler_program, "-x", "assembler", "-", "-o", executable_path },
+      pipe,
+      STDIN_FILENO
+    ) };
+    pipe.closeReadEnd();
+    {
+      // Report a compiler that exits early by its exit status rather than
+      // by dying of SIGPIPE. Blocked only after spawning, so that the
+      // compiler does not inherit the mask.
+      SigpipeBlocker const sigpipe_blocker{};
+      while (!assembly.empty()) {
+        ::ssize_t const written{
+          ::write(pipe.getWriteEnd(), assembly.data(), assembly.size())
+        };
+        if (written < 0) {
+          if (errno == EINTR) continue;
+          break;
+        }
+        assembly.remove_prefix(static_cast<std::size_t>(written));
+      }
+    }
+    pipe.closeWriteEnd();
+    waitForCompiler(process);
+    if (!assembly.empty())
+      throw ProcessError(compiler_program, "could not write assembly");
+  }
+} // namespace SC2
@@ -0,0 +1,215 @@
+#include <sc2/elf_object_writer.hpp>
+#include <sc2/output_file.hpp>
+#include <string_view>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SC2 {
+  namespace {
+    enum SectionIndex : std::uint16_t
+    {
+      null_section,
+      text_section,
+      note_gnu_stack_section,
+      symtab_section,
+      strtab_section,
+      shstrtab_section,
+      section_count
+    };
+
+    constexpr std::size_t elf_header_size{ 64 };
+    constexpr std::size_t section_header_size{ 64 };
+    constexpr std::size_t symbol_size{ 24 };
+
+    constexpr std::uint32_t sht_progbits{ 1 };
+    constexpr std::uint32_t sht_symtab{ 2 };
+    constexpr std::uint32_t sht_strtab{ 3 };
+    constexpr std::uint64_t shf_alloc{ 0x2 };
+    constexpr std::uint64_t shf_execinstr{ 0x4 };
+    constexpr std::uint8_t  stb_global_stt_func{ 0x12 };
+    constexpr std::uint16_t et_rel{ 1 };
+    constexpr std::uint16_t em_x86_64{ 62 };
+    constexpr std::uint32_t ev_current{ 1 };
+
+    [[nodiscard]] constexpr std::size_t
+    alignUp(std::size_t offset, std::size_t alignment) noexcept
+    {
+      return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    // The object file being built, appended to in little-endian fields.
+    class ObjectBytes
+    {
+      std::vector<std::uint8_t> bytes{};
+
+      public:
+      void reserve(std::size_t size) { bytes.reserve(size); }
+
+      template <std::size_t size>
+      void append(std::uint64_t value)
+      {
+        for (std::size_t byte{}; byte < size; ++byte)
+          bytes.push_back(static_cast<std::uint8_t>(value >> (8 * byte)));
+      }
+
+      void append(std::span<std::uint8_t const> data)
+      {
+        bytes.insert(bytes.end(), data.begin(), data.end());
+      }
+
+      void append(std::string_view data)
+      {
+        bytes.insert(bytes.end(), data.begin(), data.end());
+      }
+
+      // Pads with zeros up to the offset.
+      void padTo(std::size_t offset) { bytes.resize(offset); }
+
+      [[nodiscard]] std::vector<std::uint8_t> release() && noexcept
+      {
+        return std::move(bytes);
+      }
+    };
+
+    struct SectionHeader
+    {
+      std::uint32_t name{};
+      std::uint32_t type{};
+      std::uint64_t flags{};
+      std::uint64_t offset{};
+      std::uint64_t size{};
+      std::uint32_t link{};
+      std::uint32_t info{};
+      std::uint64_t alignment{};
+      std::uint64_t entry_size{};
+    };
+  } // namespace
+
+  void ElfObjectWriter::addFunction(
+    std::string_view              name,
+    std::span<std::uint8_t const> code
+  )
+  {
+    functions.push_back({ std::string{ name }, text.size(), code.size() });
+    text.insert(text.end(), code.begin(), code.end());
+  }
+
+  [[nodiscard]] std::vector<std::uint8_t> ElfObjectWriter::write() const
+  {
+    std::string section_names{ '\0' };
+    auto const  addSectionName{ [&section_names](std::string_view name) {
+      auto const offset{ static_cast<std::uint32_t>(section_names.size()) };
+      section_names.append(name);
+      section_names.push_back('\0');
+      return offset;
+    } };
+    std::string symbol_names{ '\0' };
+    for (auto const &function: functions) {
+      symbol_names.append(function.name);
+      symbol_names.push_back('\0');
+    }
+
+    // Lay the sections out after the ELF header, and the section headers
+    // after the sections.
+    std::array<SectionHeader, section_count> sections{};
+    std::size_t                              offset{ elf_header_size };
+    auto const                               placeSection{
+      [&offset](SectionHeader &section, std::size_t size, std::size_t alignment) {
+        offset            = alignUp(offset, alignment);
+        section.offset    = offset;
+        section.size      = size;
+        section.alignment = alignment;
+        offset           += size;
+      }
+    };
+    sections[text_section].name  = addSectionName(".text");
+    sections[text_section].type  = sht_progbits;
+    sections[text_section].flags = shf_alloc | shf_execinstr;
+    placeSection(sections[text_section], text.size(), 16);
+    sections[note_gnu_stack_section].name = addSectionName(".note.GNU-stack");
+    sections[note_gnu_stack_section].type = sht_progbits;
+    placeSection(sections[note_gnu_stack_section], 0, 1);
+    sections[symtab_section].name       = addSectionName(".symtab");
+    sections[symtab_section].type       = sht_symtab;
+    sections[symtab_section].link       = strtab_section;
+    // Every symbol after the null one is global.
+    sections[symtab_section].info       = 1;
+    sections[symtab_section].entry_size = symbol_size;
+    placeSection(
+      sections[symtab_section],
+      (functions.size() + 1) * symbol_size,
+      8
+    );
+    sections[strtab_section].name = addSectionName(".strtab");
+    sections[strtab_section].type = sht_strtab;
+    placeSection(sections[strtab_section], symbol_names.size(), 1);
+    sections[shstrtab_section].name = addSectionName(".shstrtab");
+    sections[shstrtab_section].type = sht_strtab;
+    placeSection(sections[shstrtab_section], section_names.size(), 1);
+    std::size_t const section_header_offset{ alignUp(offset, 8) };
+
+    ObjectBytes object{};
+    object.reserve(section_header_offset + section_count * section_header_size);
+    // ELFCLASS64, ELFDATA2LSB, EV_CURRENT and the System V ABI.
+    object.append(std::string_view{ "\x7f" "ELF\x02\x01\x01\x00", 8 });
+    object.append<8>(0);
+    object.append<2>(et_rel);
+    object.append<2>(em_x86_64);
+    object.append<4>(ev_current);
+    object.append<8>(0);
+    object.append<8>(0);
+    object.append<8>(section_header_offset);
+    object.append<4>(0);
+    object.append<2>(elf_header_size);
+    object.append<2>(0);
+    object.append<2>(0);
+    object.append<2>(section_header_size);
+    object.append<2>(section_count);
+    object.append<2>(shstrtab_section);
+
+    object.padTo(sections[text_section].offset);
+    object.append(text);
+
+    // The symbol table starts with a null symbol.
+    object.padTo(sections[symtab_section].offset + symbol_size);
+    std::uint32_t name_offset{ 1 };
+    for (auto const &function: functions) {
+      object.append<4>(name_offset);
+      object.append<1>(stb_global_stt_func);
+      object.append<1>(0);
+      object.append<2>(text_section);
+      object.append<8>(function.offset);
+      object.append<8>(function.size);
+      name_offset += static_cast<std::uint32_t>(function.name.size() + 1);
+    }
+    object.append(symbol_names);
+    object.append(section_names);
+
+    object.padTo(section_header_offset);
+    for (auto const &section: sections) {
+      object.append<4>(section.name);
+      object.append<4>(section.type);
+      object.append<8>(section.flags);
+      object.append<8>(0);
+      object.append<8>(section.offset);
+      object.append<8>(section.size);
+      object.append<4>(section.link);
+      object.append<4>(section.info);
+      object.append<8>(section.alignment);
+      object.append<8>(section.entry_size);
+    }
+    return std::move(object).release();
+  }
+
+  void ElfObjectWriter::writeToFile(std::string const &path) const
+  {
+    auto const bytes{ write() };
+    writeOutputFile(path, std::as_bytes(std::span{ bytes }));
+  }
+} // namespace SC2
@@ -0,0 +1,405 @@
+#include <sc2/ast.hpp>
+#include <sc2/flat_ast.hpp>
+#include <sc2/tacky_ast.hpp>
+#include <sc2/utility.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <tuple>
+#include <utility>
+
+namespace SC2 {
+  namespace {
+    [[nodiscard]] std::shared_ptr<BinaryOperatorTACKYASTNode>
+    makeBinaryOperatorTACKYASTNode(FlatASTOperator const flat_ast_operator)
+    {
+      switch (flat_ast_operator) {
+      case FlatASTOperator::PrefixIncrement:
+      case FlatASTOperator::PostfixIncrement:
+      case FlatASTOperator::Add:
+      case FlatASTOperator::AddAssignment:
+        return makeNode<AddTACKYASTNode>();
+      case FlatASTOperator::PrefixDecrement:
+      case FlatASTOperator::PostfixDecrement:
+      case FlatASTOperator::Subtract:
+      case FlatASTOperator::SubtractAssignment:
+        return makeNode<SubtractTACKYASTNode>();
+      case FlatASTOperator::Multiply:
+      case FlatASTOperator::MultiplyAssignment:
+        return makeNode<MultiplyTACKYASTNode>();
+      case FlatASTOperator::Divide:
+      case FlatASTOperator::DivideAssignment:
+        return makeNode<DivideTACKYASTNode>();
+      case FlatASTOperator::Modulo:
+      case FlatASTOperator::ModuloAssignment:
+        return makeNode<ModuloTACKYASTNode>();
+      case FlatASTOperator::BitwiseAnd:
+      case FlatASTOperator::BitwiseAndAssignment:
+        return makeNode<BitwiseAndTACKYASTNode>();
+      case FlatASTOperator::BitwiseOr:
+      case FlatASTOperator::BitwiseOrAssignment:
+        return makeNode<BitwiseOrTACKYASTNode>();
+      case FlatASTOperator::BitwiseXor:
+      case FlatASTOperator::BitwiseXorAssignment:
+        return makeNode<BitwiseXorTACKYASTNode>();
+      case FlatASTOperator::LeftShift:
+      case FlatASTOperator::LeftShiftAssignment:
+        return makeNode<LeftShiftTACKYASTNode>();
+      case FlatASTOperator::RightShift:
+      case FlatASTOperator::RightShiftAssignment:
+        return makeNode<RightShiftTACKYASTNode>();
+      case FlatASTOperator::Equals:
+        return makeNode<EqualsTACKYASTNode>();
+      case FlatASTOperator::NotEquals:
+        return makeNode<NotEqualsTACKYASTNode>();
+      case FlatASTOperator::LessThan:
+        return makeNode<LessThanTACKYASTNode>();
+      case FlatASTOperator::GreaterThan:
+        return makeNode<GreaterThanTACKYASTNode>();
+      case FlatASTOperator::LessThanOrEqualTo:
+        return makeNode<LessThanOrEqualToTACKYASTNode>();
+      case FlatASTOperator::GreaterThanOrEqualTo:
+        return makeNode<GreaterThanOrEqualToTACKYASTNode>();
+      default:
+        std::unreachable();
+      }
+    }
+
+    [[nodiscard]] std::shared_ptr<UnaryOperatorTACKYASTNode>
+    makeUnaryOperatorTACKYASTNode(FlatASTOperator const flat_ast_operator)
+    {
+      switch (flat_ast_operator) {
+      case FlatASTOperator::Complement:
+        return makeNode<ComplementTACKYASTNode>();
+      case FlatASTOperator::Negate:
+        return makeNode<NegateTACKYASTNode>();
+      case FlatASTOperator::Not:
+        return makeNode<NotTACKYASTNode>();
+      default:
+        std::unreachable();
+      }
+    }
+
+    [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
+    emitBinaryTACKY(
+      TACKYInstructionSink                       &sink,
+      std::shared_ptr<BinaryOperatorTACKYASTNode> binary_operator,
+      std::shared_ptr<ValueTACKYASTNode>          left_operand,
+      std::shared_ptr<ValueTACKYASTNode>          right_operand
+    )
+    {
+      auto destination{ sink.makeTemporary() };
+      sink.append(makeNode<BinaryTACKYASTNode>(
+        std::move(binary_operator),
+        std::move(left_operand),
+        std::move(right_operand),
+        destination
+      ));
+      return destination;
+    }
+  } // namespace
+
+  std::uint32_t FlatAST::appendNode(
+    FlatASTNodeKind const kind,
+    FlatASTOperator const flat_ast_operator,
+    std::uint32_t const   first_operand,
+    std::uint32_t const   second_operand
+  )
+  {
+    std::uint32_t const node{ static_cast<std::uint32_t>(kinds.size()) };
+    kinds.push_back(kind);
+    operators.push_back(flat_ast_operator);
+    first_operands.push_back(first_operand);
+    second_operands.push_back(second_operand);
+    return node;
+  }
+
+  [[nodiscard]] std::uint32_t
+  FlatAST::addLiteralConstant(int const literal_constant)
+  {
+    literal_constants.push_back(literal_constant);
+    return static_cast<std::uint32_t>(literal_constants.size() - 1);
+  }
+
+  [[nodiscard]] std::uint32_t
+  FlatAST::addIdentifier(std::string_view const identifier)
+  {
+    identifiers.push_back(identifier);
+    return static_cast<std::uint32_t>(identifiers.size() - 1);
+  }
+
+  [[nodiscard]] std::size_t FlatAST::getMemoryFootprint() const noexcept
+  {
+    return sizeof(*this) + kinds.capacity() * sizeof(FlatASTNodeKind)
+         + operators.capacity() * sizeof(FlatASTOperator)
+         + first_operands.capacity() * sizeof(std::uint32_t)
+         + second_operands.capacity() * sizeof(std::uint32_t)
+         + literal_constants.capacity() * sizeof(int)
+         + identifiers.capacity() * sizeof(std::string_view)
+         + block_items.capacity() * sizeof(std::uint32_t);
+  }
+
+  void FlatAST::prettyPrintExpression(
+    std::ostream       &out,
+    std::uint32_t const node
+  ) const
+  {
+    std::uint32_t const   first_operand{ first_operands[node] };
+    FlatASTOperator const flat_ast_operator{ operators[node] };
+    switch (kinds[node]) {
+    case FlatASTNodeKind::LiteralConstant:
+      out << literal_constants[first_operand];
+      break;
+    case FlatASTNodeKind::Variable:
+      out << identifiers[first_operand];
+      break;
+    case FlatASTNodeKind::Unary:
+      if (flat_ast_operator == FlatASTOperator::PostfixIncrement
+          || flat_ast_operator == FlatASTOperator::PostfixDecrement) {
+        prettyPrintExpression(out, first_operand);
+        out << getFlatASTOperatorSymbol(flat_ast_operator);
+      } else if (flat_ast_operator == FlatASTOperator::PrefixIncrement
+                 || flat_ast_operator == FlatASTOperator::PrefixDecrement) {
+        out << getFlatASTOperatorSymbol(flat_ast_operator);
+        prettyPrintExpression(out, first_operand);
+      } else {
+        out << getFlatASTOperatorSymbol(flat_ast_operator) << '(';
+        prettyPrintExpression(out, first_operand);
+        out << ')';
+      }
+      break;
+    case FlatASTNodeKind::Binary:
+    case FlatASTNodeKind::Assignment:
+      out << '(';
+      prettyPrintExpression(out, first_operand);
+      out << ' ' << getFlatASTOperatorSymbol(flat_ast_operator) << ' ';
+      prettyPrintExpression(out, second_operands[node]);
+      out << ')';
+      break;
+    default:
+      std::unreachable();
+    }
+  }
+
+  void FlatAST::prettyPrintBlockItem(
+    std::ostream       &out,
+    std::size_t const   indent_level,
+    std::uint32_t const node
+  ) const
+  {
+    Utility::indent(out, indent_level);
+    switch (kinds[node]) {
+    case FlatASTNodeKind::ReturnStatement:
+      out << "return ";
+      prettyPrintExpression(out, first_operands[node]);
+      break;
+    case FlatASTNodeKind::ExpressionStatement:
+      prettyPrintExpression(out, first_operands[node]);
+      break;
+    case FlatASTNodeKind::NullStatement:
+      break;
+    case FlatASTNodeKind::Declaration:
+      out << (kinds[node + 1] == FlatASTNodeKind::IntType ? "int" : "void")
+          << ' ' << identifiers[first_operands[node]];
+      if (second_operands[node] != no_node) {
+        out << " = ";
+        prettyPrintExpression(out, second_operands[node]);
+      }
+      break;
+    default:
+      std::unreachable();
+    }
+    out << ";\n";
+  }
+
+  void FlatAST::prettyPrintHelper(
+    std::ostream     &out,
+    std::size_t const indent_level
+  )
+  {
+    Utility::indent(out, indent_level);
+    out << "int " << function_name << "(void) {\n";
+    for (std::uint32_t const block_item: block_items)
+      prettyPrintBlockItem(out, indent_level + 2, block_item);
+    out << "}\n";
+  }
+
+  [[nodiscard]] std::shared_ptr<ValueTACKYASTNode>
+  FlatAST::emitTACKYForExpression(
+    TACKYInstructionSink &sink,
+    std::uint32_t const   node
+  ) const
+  {
+    std::uint32_t const   first_operand{ first_operands[node] };
+    std::uint32_t const   second_operand{ second_operands[node] };
+    FlatASTOperator const flat_ast_operator{ operators[node] };
+    switch (kinds[node]) {
+    case FlatASTNodeKind::LiteralConstant:
+      return makeNode<LiteralConstantTACKYASTNode>(
+        literal_constants[first_operand]
+      );
+    case FlatASTNodeKind::Variable:
+      return sink.getVariable(identifiers[first_operand]);
+    case FlatASTNodeKind::Unary: {
+      auto const source{ emitTACKYForExpression(sink, first_operand) };
+      switch (flat_ast_operator) {
+      case FlatASTOperator::PrefixIncrement:
+      case FlatASTOperator::PrefixDecrement: {
+        auto const source_tacky{
+          std::dynamic_pointer_cast<VariableTACKYASTNode>(source)
+        };
+        sink.append(makeNode<BinaryTACKYASTNode>(
+          makeBinaryOperatorTACKYASTNode(flat_ast_operator),
+          source_tacky,
+          makeNode<LiteralConstantTACKYASTNode>(1),
+          source_tacky
+        ));
+        return source_tacky;
+      }
+      case FlatASTOperator::PostfixIncrement:
+      case FlatASTOperator::PostfixDecrement: {
+        auto const source_tacky{
+          std::dynamic_pointer_cast<VariableTACKYASTNode>(source)
+        };
+        auto temporary{ sink.makeTemporary() };
+        sink.append(makeNode<CopyTACKYASTNode>(source_tacky, temporary));
+        sink.append(makeNode<BinaryTACKYASTNode>(
+          makeBinaryOperatorTACKYASTNode(flat_ast_operator),
+          source_tacky,
+          makeNode<LiteralConstantTACKYASTNode>(1),
+          source_tacky
+        ));
+        return temporary;
+      }
+      default: {
+        auto destination{ sink.makeTemporary() };
+        sink.append(makeNode<UnaryTACKYASTNode>(
+          makeUnaryOperatorTACKYASTNode(flat_ast_operator),
+          source,
+          destination
+        ));
+        return destination;
+      }
+      }
+    }
+    case FlatASTNodeKind::Binary: {
+      if (flat_ast_operator != FlatASTOperator::And
+          && flat_ast_operator != FlatASTOperator::Or) {
+        auto left_operand{ emitTACKYForExpression(sink, first_operand) };
+        auto right_operand{ emitTACKYForExpression(sink, second_operand) };
+        return emitBinaryTACKY(
+          sink,
+          makeBinaryOperatorTACKYASTNode(flat_ast_operator),
+          std::move(left_operand),
+          std::move(right_operand)
+        );
+      }
+      bool const is_and{ flat_ast_operator == FlatASTOperator::And };
+      auto const make_conditional_jump{
+        [is_and](
+          std::shared_ptr<ValueTACKYASTNode> condition,
+          std::string_view                   target
+        ) -> std::shared_ptr<InstructionTACKYASTNode> {
+        if (is_and)
+          return makeNode<JumpIfZeroTACKYASTNode>(std::move(condition), target);
+        else
+          return makeNode<JumpIfNotZeroTACKYASTNode>(
+            std::move(condition),
+            target
+          );
+      }
+      };
+      auto const left_operand{ emitTACKYForExpression(sink, first_operand) };
+      auto const false_label{ sink.generateFreshLabel("false_label") };
+      sink.append(make_conditional_jump(left_operand, false_label));
+      auto const right_operand{ emitTACKYForExpression(sink, second_operand) };
+      auto destination{ sink.makeTemporary() };
+      sink.append(make_conditional_jump(right_operand, false_label));
+      sink.append(makeNode<CopyTACKYASTNode>(
+        makeNode<LiteralConstantTACKYASTNode>(is_and ? 1 : 0),
+        destination
+      ));
+      auto const end_label{ sink.generateFreshLabel() };
+      sink.append(makeNode<JumpTACKYASTNode>(end_label));
+      sink.append(makeNode<LabelTACKYASTNode>(false_label));
+      sink.append(makeNode<CopyTACKYASTNode>(
+        makeNode<LiteralConstantTACKYASTNode>(is_and ? 0 : 1),
+        destination
+      ));
+      sink.append(makeNode<LabelTACKYASTNode>(end_label));
+      return destination;
+    }
+    case FlatASTNodeKind::Assignment: {
+      auto source_tacky{ emitTACKYForExpression(sink, second_operand) };
+      auto const destination_tacky{
+        emitTACKYForExpression(sink, first_operand)
+      };
+      if (flat_ast_operator != FlatASTOperator::Assignment)
+        source_tacky = emitBinaryTACKY(
+          sink,
+          makeBinaryOperatorTACKYASTNode(flat_ast_operator),
+          destination_tacky,
+          std::move(source_tacky)
+        );
+      sink.append(makeNode<CopyTACKYASTNode>(
+        std::move(source_tacky),
+        std::dynamic_pointer_cast<VariableTACKYASTNode>(destination_tacky)
+      ));
+      return destination_tacky;
+    }
+    default:
+      std::unreachable();
+    }
+  }
+
+  void FlatAST::emitTACKYForBlockItem(
+    TACKYInstructionSink &sink,
+    std::uint32_t const   node
+  ) const
+  {
+    switch (kinds[node]) {
+    case FlatASTNodeKind::ReturnStatement:
+      sink.append(makeNode<ReturnTACKYASTNode>(
+        emitTACKYForExpression(sink, first_operands[node])
+      ));
+      break;
+    case FlatASTNodeKind::ExpressionStatement:
+      std::ignore = emitTACKYForExpression(sink, first_operands[node]);
+      break;
+    case FlatASTNodeKind::NullStatement:
+      break;
+    case FlatASTNodeKind::Declaration:
+      if (std::uint32_t const initializer{ second_operands[node] };
+          initializer != no_node) {
+        auto const source_tacky{ emitTACKYForExpression(sink, initializer) };
+        sink.append(makeNode<CopyTACKYASTNode>(
+          source_tacky,
+          sink.getVariable(identifiers[first_operands[node]])
+        ));
+      }
+      break;
+    default:
+      std::unreachable();
+    }
+  }
+
+  [[nodiscard]] std::shared_ptr<ProgramTACKYASTNode> FlatAST::emitTACKY() const
+  {
+    TACKYInstructionSink sink{ function_name };
+    for (std::uint32_t const block_item: block_items)
+      emitTACKYForBlockItem(sink, block_item);
+    sink.append(
+      makeNode<ReturnTACKYASTNode>(makeNode<LiteralConstantTACKYASTNode>(0))
+    );
+    return makeNode<ProgramTACKYASTNode>(
+      makeNode<FunctionTACKYASTNode>(
+        function_name,
+        std::move(sink).takeInstructions()
+      ),
+      string_interner
+    );
+  }
+} // namespace SC2
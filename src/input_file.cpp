@@ -0,0 +1,84 @@
+#include <sc2/input_file.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+
+namespace SC2 {
+  namespace {
+    // Where the buffer of an input that cannot be mapped starts, unless the
+    // input says it is bigger.
+    constexpr std::size_t initial_buffer_size{ 64 * 1024 };
+
+    // Closes the file when it goes out of scope; a mapping outlives it.
+    class FileDescriptor
+    {
+      int descriptor{ -1 };
+
+      public:
+      explicit FileDescriptor(int const descriptor): descriptor{ descriptor }
+      {}
+
+      FileDescriptor(FileDescriptor const &)            = delete;
+      FileDescriptor &operator=(FileDescriptor const &) = delete;
+
+      ~FileDescriptor()
+      {
+        if (descriptor >= 0) ::close(descriptor);
+      }
+
+      [[nodiscard]] int get() const noexcept { return descriptor; }
+    };
+  } // namespace
+
+  InputFile::InputFile(std::string const &path)
+  {
+    FileDescriptor const file{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+    if (file.get() < 0) throw InputFileError(path, errno);
+    struct ::stat status{};
+    if (::fstat(file.get(), &status) < 0) throw InputFileError(path, errno);
+    auto const size{ static_cast<std::size_t>(status.st_size) };
+    if (S_ISREG(status.st_mode) && size > 0) {
+      void * const address{
+        ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.get(), 0)
+      };
+      if (address != MAP_FAILED) {
+        // Only a hint: without it the file is still read, just with less
+        // readahead.
+        ::madvise(address, size, MADV_SEQUENTIAL);
+        mapping      = address;
+        mapping_size = size;
+        return;
+      }
+    }
+    // Regular files whose size is unknown, such as those under /proc, end up
+    // here too. One byte past a known size lets a single read see the end.
+    buffer.resize(size >= initial_buffer_size ? size + 1 : initial_buffer_size);
+    std::size_t read_size{};
+    while (true) {
+      if (read_size == buffer.size()) buffer.resize(2 * buffer.size());
+      ::ssize_t const received{ ::read(
+        file.get(),
+        buffer.data() + read_size,
+        buffer.size() - read_size
+      ) };
+      if (received < 0) {
+        if (errno == EINTR) continue;
+        throw InputFileError(path, errno);
+      }
+      if (received == 0) break;
+      read_size += static_cast<std::size_t>(received);
+    }
+    buffer.resize(read_size);
+  }
+
+  InputFile::~InputFile()
+  {
+    if (mapping) ::munmap(mapping, mapping_size);
+  }
+} // namespace SC2
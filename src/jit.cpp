@@ -0,0 +1,81 @@
+#include <sc2/assembly_ast.hpp>
+#include <sc2/jit.hpp>
+#include <sc2/machine_code_buffer.hpp>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace SC2 {
+  namespace {
+    [[nodiscard]] std::vector<std::uint8_t>
+    encodeFunction(ProgramAssemblyASTNode const &program)
+    {
+      MachineCodeBuffer code{};
+      program.getFunction()->encode(code);
+      return code.finish();
+    }
+  } // namespace
+
+  ExecutableMemory::ExecutableMemory(std::span<std::uint8_t const> code)
+    : size{ code.size() }
+  {
+    memory = ::mmap(
+      nullptr,
+      size,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0
+    );
+    if (memory == MAP_FAILED) throw JITError("mmap", errno);
+    std::memcpy(memory, code.data(), size);
+    if (::mprotect(memory, size, PROT_READ | PROT_EXEC) < 0) {
+      int const error_number{ errno };
+      ::munmap(memory, size);
+      throw JITError("mprotect", error_number);
+    }
+  }
+
+  ExecutableMemory::~ExecutableMemory() { ::munmap(memory, size); }
+
+  [[nodiscard]] int ExecutableMemory::call() const
+  {
+    return reinterpret_cast<int (*)()>(memory)();
+  }
+
+  [[nodiscard]] int runProgram(ProgramAssemblyASTNode const &program)
+  {
+    ExecutableMemory const memory{ encodeFunction(program) };
+    return memory.call();
+  }
+
+  [[nodiscard]] int
+  runProgramInChildProcess(ProgramAssemblyASTNode const &program)
+  {
+    // Map the code before forking, so that encoding errors are reported by
+    // the parent as usual.
+    ExecutableMemory const memory{ encodeFunction(program) };
+    ::pid_t const          child{ ::fork() };
+    if (child < 0) throw JITError("fork", errno);
+    if (child == 0) {
+      // Crash as a separate process would, whatever handlers the parent has.
+      for (int const signal_number: { SIGBUS, SIGFPE, SIGILL, SIGSEGV })
+        std::signal(signal_number, SIG_DFL);
+      ::_exit(memory.call());
+    }
+    int status{};
+    while (::waitpid(child, &status, 0) < 0)
+      if (errno != EINTR) throw JITError("waitpid", errno);
+    if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+    return WEXITSTATUS(status);
+  }
+} // namespace SC2
@@ -1,193 +1,233 @@
 #include <sc2/lexer.hpp>
 
-#include <regex>
+#include <charconv>
+#include <cstddef>
+#include <expected>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace SC2 {
-  std::regex Lexer::whitespace_prefix_regex(
-    "^(\\s+)",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::identifier_regex(
-    "^[a-zA-Z_]\\w*\\b",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::literal_constant_regex(
-    "^[0-9]+\\b",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::parenthesis_regex(
-    "^(\\(|\\))",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::brace_regex(
-    "^(\\{|\\})",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex
-    Lexer::semicolon_regex("^;", std::regex::ECMAScript | std::regex::optimize);
-
-  std::regex
-    Lexer::tilde_regex("^~", std::regex::ECMAScript | std::regex::optimize);
-
-  std::regex
-    Lexer::hyphen_regex("^-", std::regex::ECMAScript | std::regex::optimize);
-
-  std::regex Lexer::decrement_regex(
-    "^--",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::plus_sign_regex(
-    "^\\+",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::asterisk_regex(
-    "^\\*",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::forward_slash_regex(
-    "^/",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::percent_sign_regex(
-    "^%",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::bitwise_and_regex(
-    "^&",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::bitwise_or_regex(
-    "^\\|",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::bitwise_xor_regex(
-    "^\\^",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::left_shift_regex(
-    "^<<",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::right_shift_regex(
-    "^>>",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::exclamation_point_regex(
-    "^!",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::double_ampersand_regex(
-    "^&&",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::double_pipe_regex(
-    "^\\|\\|",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex
-    Lexer::equal_to_regex("^==", std::regex::ECMAScript | std::regex::optimize);
-
-  std::regex Lexer::not_equal_to_regex(
-    "^!=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex
-    Lexer::less_than_regex("^<", std::regex::ECMAScript | std::regex::optimize);
-
-  std::regex Lexer::greater_than_regex(
-    "^>",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::less_than_or_equal_to_regex(
-    "^<=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::greater_than_or_equal_to_regex(
-    "^>=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::assignment_regex(
-    "^=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::add_assignment_regex(
-    "^\\+=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::subtract_assignment_regex(
-    "^-=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::multiply_assignment_regex(
-    "^\\*=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::divide_assignment_regex(
-    "^/=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::modulo_assignment_regex(
-    "^%=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::bitwise_and_assignment_regex(
-    "^&=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::bitwise_or_assignment_regex(
-    "^\\|=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::bitwise_xor_assignment_regex(
-    "^\\^=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::left_shift_assignment_regex(
-    "^<<=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::right_shift_assignment_regex(
-    "^>>=",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex Lexer::increment_regex(
-    "^\\+\\+",
-    std::regex::ECMAScript | std::regex::optimize
-  );
-
-  std::regex
-    Lexer::comma_regex("^,", std::regex::ECMAScript | std::regex::optimize);
+  namespace {
+    [[nodiscard]] constexpr bool isDigit(char const character) noexcept
+    {
+      return character >= '0' && character <= '9';
+    }
+
+    [[nodiscard]] constexpr bool isIdentifierStart(char const character
+    ) noexcept
+    {
+      return (character >= 'a' && character <= 'z')
+          || (character >= 'A' && character <= 'Z') || character == '_';
+    }
+
+    [[nodiscard]] constexpr bool isWordCharacter(char const character
+    ) noexcept
+    {
+      return isIdentifierStart(character) || isDigit(character);
+    }
+
+    [[nodiscard]] constexpr std::pair<Token, std::size_t> makeToken(
+      TokenKind const        kind,
+      std::string_view const program_text,
+      std::size_t const      token_size
+    ) noexcept
+    {
+      return { Token(kind, program_text.substr(0, token_size)), token_size };
+    }
+
+    using ScanResult
+      = std::expected<std::pair<Token, std::size_t>, LexerInvalidTokenError>;
+
+    [[nodiscard]] ScanResult scanIdentifierOrKeyword(
+      std::string_view const program_text,
+      StringInterner        &string_interner
+    )
+    {
+      std::size_t identifier_size{ 1 };
+      while (identifier_size < program_text.size()
+             && isWordCharacter(program_text[identifier_size]))
+        ++identifier_size;
+      if (identifier_size > Token::max_lexeme_size)
+        return std::unexpected{ LexerInvalidTokenError(program_text) };
+      std::string_view const identifier{ program_text.substr(
+        0,
+        identifier_size
+      ) };
+      TokenKind kind{ TokenKind::Identifier };
+      if (identifier == "int") kind = TokenKind::IntKeyword;
+      else if (identifier == "return") kind = TokenKind::ReturnKeyword;
+      else if (identifier == "void") kind = TokenKind::VoidKeyword;
+      else if (identifier == "typedef") kind = TokenKind::TypedefKeyword;
+      else
+        return std::pair{ Token(identifier, string_interner.intern(identifier)),
+                          identifier_size };
+      return makeToken(kind, program_text, identifier_size);
+    }
+
+    [[nodiscard]] ScanResult
+    scanLiteralConstant(std::string_view const program_text)
+    {
+      std::size_t literal_constant_size{ 1 };
+      while (literal_constant_size < program_text.size()
+             && isDigit(program_text[literal_constant_size]))
+        ++literal_constant_size;
+      // Leading zeros can make a literal constant that fits into an int
+      // longer than a token can record.
+      if ((literal_constant_size < program_text.size()
+           && isWordCharacter(program_text[literal_constant_size]))
+          || literal_constant_size > Token::max_lexeme_size)
+        return std::unexpected{ LexerInvalidTokenError(program_text) };
+      std::string_view const literal_constant_string{ program_text.substr(
+        0,
+        literal_constant_size
+      ) };
+      int literal_constant{};
+      // The digits were checked above, so the only way to fail is a value
+      // that does not fit into an int.
+      if (std::from_chars(
+            literal_constant_string.data(),
+            literal_constant_string.data() + literal_constant_string.size(),
+            literal_constant,
+            10
+          )
+            .ec
+          != std::errc{})
+        return std::unexpected{
+          LexerInvalidTokenError::literalConstantOutOfRange(
+            literal_constant_string
+          )
+        };
+      return std::pair{ Token(literal_constant_string, literal_constant),
+                        literal_constant_size };
+    }
+  } // namespace
+
+  Lexer::ScanResult Lexer::scanToken(
+    std::string_view const program_text,
+    StringInterner        &string_interner
+  )
+  {
+    auto const peek{ [&program_text](std::size_t const offset) noexcept {
+      return offset < program_text.size() ? program_text[offset] : '\0';
+    } };
+    switch (char const character{ program_text.front() }) {
+    case '(':
+      return makeToken(TokenKind::LeftParenthesis, program_text, 1);
+    case ')':
+      return makeToken(TokenKind::RightParenthesis, program_text, 1);
+    case '{':
+      return makeToken(TokenKind::LeftCurlyBrace, program_text, 1);
+    case '}':
+      return makeToken(TokenKind::RightCurlyBrace, program_text, 1);
+    case ';':
+      return makeToken(TokenKind::Semicolon, program_text, 1);
+    case '~':
+      return makeToken(TokenKind::Tilde, program_text, 1);
+    case ',':
+      return makeToken(TokenKind::Comma, program_text, 1);
+    case '-':
+      if (peek(1) == '-')
+        return makeToken(TokenKind::Decrement, program_text, 2);
+      if (peek(1) == '=')
+        return makeToken(TokenKind::SubtractAssignment, program_text, 2);
+      return makeToken(TokenKind::Hyphen, program_text, 1);
+    case '+':
+      if (peek(1) == '+')
+        return makeToken(TokenKind::Increment, program_text, 2);
+      if (peek(1) == '=')
+        return makeToken(TokenKind::AddAssignment, program_text, 2);
+      return makeToken(TokenKind::PlusSign, program_text, 1);
+    case '*':
+      if (peek(1) == '=')
+        return makeToken(TokenKind::MultiplyAssignment, program_text, 2);
+      return makeToken(TokenKind::Asterisk, program_text, 1);
+    case '/':
+      if (peek(1) == '=')
+        return makeToken(TokenKind::DivideAssignment, program_text, 2);
+      return makeToken(TokenKind::ForwardSlash, program_text, 1);
+    case '%':
+      if (peek(1) == '=')
+        return makeToken(TokenKind::ModuloAssignment, program_text, 2);
+      return makeToken(TokenKind::PercentSign, program_text, 1);
+    case '&':
+      if (peek(1) == '&')
+        return makeToken(TokenKind::DoubleAmpersand, program_text, 2);
+      if (peek(1) == '=')
+        return makeToken(TokenKind::BitwiseAndAssignment, program_text, 2);
+      return makeToken(TokenKind::BitwiseAnd, program_text, 1);
+    case '|':
+      if (peek(1) == '|')
+        return makeToken(TokenKind::DoublePipe, program_text, 2);
+      if (peek(1) == '=')
+        return makeToken(TokenKind::BitwiseOrAssignment, program_text, 2);
+      return makeToken(TokenKind::BitwiseOr, program_text, 1);
+    case '^':
+      if (peek(1) == '=')
+        return makeToken(TokenKind::BitwiseXorAssignment, program_text, 2);
+      return makeToken(TokenKind::BitwiseXor, program_text, 1);
+    case '!':
+      if (peek(1) == '=')
+        return makeToken(TokenKind::NotEqualTo, program_text, 2);
+      return makeToken(TokenKind::ExclamationPoint, program_text, 1);
+    case '=':
+      if (peek(1) == '=')
+        return makeToken(TokenKind::EqualTo, program_text, 2);
+      return makeToken(TokenKind::Assignment, program_text, 1);
+    case '<':
+      if (peek(1) == '<') {
+        if (peek(2) == '=')
+          return makeToken(TokenKind::LeftShiftAssignment, program_text, 3);
+        return makeToken(TokenKind::LeftShift, program_text, 2);
+      }
+      if (peek(1) == '=')
+        return makeToken(TokenKind::LessThanOrEqualTo, program_text, 2);
+      return makeToken(TokenKind::LessThan, program_text, 1);
+    case '>':
+      if (peek(1) == '>') {
+        if (peek(2) == '=')
+          return makeToken(TokenKind::RightShiftAssignment, program_text, 3);
+        return makeToken(TokenKind::RightShift, program_text, 2);
+      }
+      if (peek(1) == '=')
+        return makeToken(TokenKind::GreaterThanOrEqualTo, program_text, 2);
+      return makeToken(TokenKind::GreaterThan, program_text, 1);
+    default:
+      if (isIdentifierStart(character))
+        return scanIdentifierOrKeyword(program_text, string_interner);
+      else if (isDigit(character))
+        return scanLiteralConstant(program_text);
+      else
+        return std::unexpected{ LexerInvalidTokenError(program_text) };
+    }
+  }
+
+  std::expected<void, LexerInvalidTokenError> Lexer::tokenize(
+    std::string_view    program_text,
+    StringInterner     &string_interner,
+    std::vector<Token> &tokens
+  )
+  {
+    while (true) {
+      clearWhitespaceFromStartOf(program_text);
+      if (program_text.empty()) return {};
+      auto const scanned{ scanToken(program_text, string_interner) };
+      if (!scanned) return std::unexpected{ scanned.error() };
+      tokens.push_back(scanned->first);
+      program_text.remove_prefix(scanned->second);
+    }
+  }
+
+  std::expected<void, LexerInvalidTokenError>
+  Lexer::tokenizeRemaining(std::vector<Token> &tokens)
+  {
+    if (finished) return {};
+    tokens.push_back(current_token);
+    finished = true;
+    return tokenize(
+      std::exchange(program_text, std::string_view{}),
+      *string_interner,
+      tokens
+    );
+  }
 } // namespace SC2
@@ -0,0 +1,179 @@
+#include <sc2/compiler_error.hpp>
+#include <sc2/machine_code_buffer.hpp>
+#include <string_view>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SC2 {
+  namespace {
+    class UndefinedLabelError: public CompilerError
+    {
+      std::string const message{};
+
+      public:
+      UndefinedLabelError(std::string_view label)
+        : message{ std::format("Jump to undefined label: {}", label) }
+      {}
+
+      constexpr virtual char const *what() const noexcept final override
+      {
+        return message.c_str();
+      }
+    };
+
+    constexpr std::size_t short_jump_size{ 2 };
+    constexpr std::size_t long_jump_size{ 5 };
+    constexpr std::size_t long_conditional_jump_size{ 6 };
+  } // namespace
+
+  [[nodiscard]] std::uint32_t MachineCodeBuffer::getLabel(std::string_view name
+  )
+  {
+    auto const [entry, inserted]{ label_ids.try_emplace(
+      std::string{ name },
+      static_cast<std::uint32_t>(label_positions.size())
+    ) };
+    if (inserted) {
+      label_positions.emplace_back();
+      label_jump_counts.emplace_back();
+    }
+    return entry->second;
+  }
+
+  void MachineCodeBuffer::emitInt32(std::int32_t value)
+  {
+    auto const bits{ static_cast<std::uint32_t>(value) };
+    for (int shift{}; shift < 32; shift += 8)
+      bytes.push_back(static_cast<std::uint8_t>(bits >> shift));
+  }
+
+  void MachineCodeBuffer::emitInstruction(
+    std::initializer_list<std::uint8_t> opcode,
+    ModRMOperand const                 &reg,
+    ModRMOperand const                 &rm,
+    bool                                is_64_bit
+  )
+  {
+    std::uint8_t const rex{ static_cast<std::uint8_t>(
+      0x40 | (is_64_bit ? 0x08 : 0) | ((reg.number & 0x08) ? 0x04 : 0)
+      | ((rm.number & 0x08) ? 0x01 : 0)
+    ) };
+    if (rex != 0x40 || reg.needs_rex || rm.needs_rex) emitByte(rex);
+    for (auto const byte: opcode) emitByte(byte);
+    std::uint8_t const reg_bits{ static_cast<std::uint8_t>(
+      (reg.number & 0x07) << 3
+    ) };
+    std::uint8_t const rm_bits{ static_cast<std::uint8_t>(rm.number & 0x07) };
+    if (!rm.is_memory) {
+      emitByte(0xC0 | reg_bits | rm_bits);
+      return;
+    }
+    // Memory operands are only ever addressed from %rbp, which needs neither
+    // a SIB byte nor special casing beyond always having a displacement.
+    if (fitsInInt8(rm.displacement)) {
+      emitByte(0x40 | reg_bits | rm_bits);
+      emitInt8(rm.displacement);
+    } else {
+      emitByte(0x80 | reg_bits | rm_bits);
+      emitInt32(rm.displacement);
+    }
+  }
+
+  void MachineCodeBuffer::emitInstructionWithRegister(
+    std::uint8_t        opcode,
+    ModRMOperand const &reg
+  )
+  {
+    if ((reg.number & 0x08) || reg.needs_rex)
+      emitByte(0x40 | ((reg.number & 0x08) ? 0x01 : 0));
+    emitByte(opcode | (reg.number & 0x07));
+  }
+
+  void MachineCodeBuffer::defineLabel(std::string_view name)
+  {
+    std::uint32_t const label{ getLabel(name) };
+    label_positions[label]   = bytes.size();
+    label_jump_counts[label] = jumps.size();
+  }
+
+  void MachineCodeBuffer::emitJump(
+    std::string_view            label,
+    std::optional<std::uint8_t> condition_code
+  )
+  {
+    jumps.push_back({ bytes.size(), condition_code, getLabel(label) });
+  }
+
+  [[nodiscard]] std::vector<std::uint8_t> MachineCodeBuffer::finish() const
+  {
+    for (auto const &[name, label]: label_ids)
+      if (!label_positions[label]) throw UndefinedLabelError(name);
+
+    // Every jump starts short and is only ever lengthened, so the sizes reach
+    // a fixpoint. growth[jump] is the size of all the jumps before it.
+    std::vector<bool>        is_long(jumps.size());
+    std::vector<std::size_t> growth(jumps.size() + 1);
+    auto const               getJumpSize{ [&](std::size_t jump) {
+      if (!is_long[jump]) return short_jump_size;
+      return jumps[jump].condition_code ? long_conditional_jump_size :
+                                                        long_jump_size;
+    } };
+    auto const getDisplacement{ [&](std::size_t jump) {
+      auto const   label{ jumps[jump].label };
+      std::int64_t target{ static_cast<std::int64_t>(
+        *label_positions[label] + growth[label_jump_counts[label]]
+      ) };
+      return target
+           - static_cast<std::int64_t>(jumps[jump].position + growth[jump + 1]);
+    } };
+    for (bool changed{ true }; changed;) {
+      changed = false;
+      for (std::size_t jump{}; jump < jumps.size(); ++jump)
+        growth[jump + 1] = growth[jump] + getJumpSize(jump);
+      for (std::size_t jump{}; jump < jumps.size(); ++jump) {
+        if (is_long[jump] || fitsInInt8(getDisplacement(jump))) continue;
+        is_long[jump] = true;
+        changed       = true;
+      }
+    }
+
+    MachineCodeBuffer code{};
+    code.bytes.reserve(bytes.size() + growth.back());
+    std::size_t position{};
+    for (std::size_t jump{}; jump < jumps.size(); ++jump) {
+      auto const &[jump_position, condition_code, label]{ jumps[jump] };
+      code.bytes.insert(
+        code.bytes.end(),
+        bytes.begin() + static_cast<std::ptrdiff_t>(position),
+        bytes.begin() + static_cast<std::ptrdiff_t>(jump_position)
+      );
+      position = jump_position;
+      auto const displacement{ static_cast<std::int32_t>(getDisplacement(jump)
+      ) };
+      if (!is_long[jump]) {
+        code.emitByte(condition_code ? 0x70 | *condition_code : 0xEB);
+        code.emitInt8(displacement);
+      } else if (condition_code) {
+        code.emitByte(0x0F);
+        code.emitByte(0x80 | *condition_code);
+        code.emitInt32(displacement);
+      } else {
+        code.emitByte(0xE9);
+        code.emitInt32(displacement);
+      }
+    }
+    code.bytes.insert(
+      code.bytes.end(),
+      bytes.begin() + static_cast<std::ptrdiff_t>(position),
+      bytes.end()
+    );
+    return std::move(code.bytes);
+  }
+} // namespace SC2
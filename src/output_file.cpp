@@ -0,0 +1,38 @@
+#include <sc2/output_file.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace SC2 {
+  void writeOutputFile(
+    std::string const               &path,
+    std::span<std::byte const> const contents
+  )
+  {
+    int const file_descriptor{
+      ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)
+    };
+    if (file_descriptor < 0) throw OutputFileError(path, errno);
+    std::byte const *remaining{ contents.data() };
+    std::size_t      remaining_size{ contents.size() };
+    while (remaining_size > 0) {
+      ::ssize_t const written{
+        ::write(file_descriptor, remaining, remaining_size)
+      };
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        int const error_number{ errno };
+        ::close(file_descriptor);
+        throw OutputFileError(path, error_number);
+      }
+      remaining      += written;
+      remaining_size -= static_cast<std::size_t>(written);
+    }
+    if (::close(file_descriptor) < 0) throw OutputFileError(path, errno);
+  }
+} // namespace SC2
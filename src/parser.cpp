@@ -1,59 +1,63 @@
 #include <sc2/parser.hpp>
 
 namespace SC2 {
-  [[nodiscard]] std::shared_ptr<ExpressionASTNode>
+  [[nodiscard]] ParseResult<std::shared_ptr<ExpressionASTNode>>
   Parser::parseFactor(VariableToTypeAndUniqueIdentifierMap &map)
-  try {
-    std::shared_ptr<ExpressionASTNode> expression{
-      [this, &map]() -> std::shared_ptr<ExpressionASTNode> {
-      Token const next_token{ peekNextToken() };
-      if (next_token.isLiteralConstant()) {
-        return parseLiteralConstantExpression();
-      } else if (next_token.isPrefixUnaryOperatorToken()) {
-        std::shared_ptr<PrefixUnaryOperatorASTNode> const prefix_unary_operator{
-          parsePrefixUnaryOperator()
-        };
-        std::shared_ptr<ExpressionASTNode> const factor{ parseFactor(map) };
-        if ((std::dynamic_pointer_cast<PrefixDecrementASTNode>(
-               prefix_unary_operator
-             )
-             || std::dynamic_pointer_cast<PrefixIncrementASTNode>(
-               prefix_unary_operator
-             ))
-            && !std::dynamic_pointer_cast<VariableASTNode>(factor))
-          throw InvalidLValueError(factor);
-        else
-          return std::make_shared<UnaryExpressionASTNode>(
-            prefix_unary_operator,
-            factor
-          );
-      } else if (next_token.isIdentifier()) {
-        return parseVariable(map);
-      } else {
-        expect(Token(std::make_shared<LeftParenthesisToken>()));
-        std::shared_ptr<ExpressionASTNode> const expression{
-          parseExpression(0, map)
-        };
-        try {
-          expect(Token(std::make_shared<RightParenthesisToken>()));
-        } catch (...) {
-          throw ParserUnmatchedParenthesesError{};
+  {
+    return parseNonTerminal(
+      "factor",
+      [this, &map]() -> ParseResult<std::shared_ptr<ExpressionASTNode>> {
+      auto expression{
+        [this, &map]() -> ParseResult<std::shared_ptr<ExpressionASTNode>> {
+        auto const next_token{ peekNextToken() };
+        if (!next_token) return std::unexpected{ next_token.error() };
+        if (next_token->getKind() == TokenKind::LiteralConstant) {
+          return parseLiteralConstantExpression();
+        } else if (next_token->isPrefixUnaryOperatorToken()) {
+          std::shared_ptr<PrefixUnaryOperatorASTNode> const
+                     prefix_unary_operator{ parsePrefixUnaryOperator() };
+          auto const factor{ parseFactor(map) };
+          if (!factor) return factor;
+          if ((std::dynamic_pointer_cast<PrefixDecrementASTNode>(
+                 prefix_unary_operator
+               )
+               || std::dynamic_pointer_cast<PrefixIncrementASTNode>(
+                 prefix_unary_operator
+               ))
+              && !std::dynamic_pointer_cast<VariableASTNode>(*factor))
+            return failParse(InvalidLValueError(*factor));
+          else
+            return makeNode<UnaryExpressionASTNode>(
+              prefix_unary_operator,
+              *factor
+            );
+        } else if (next_token->getKind() == TokenKind::Identifier) {
+          return parseVariable(map);
+        } else {
+          if (auto const parenthesis{ expect(TokenKind::LeftParenthesis) };
+              !parenthesis)
+            return std::unexpected{ parenthesis.error() };
+          auto const expression{ parseExpression(0, map) };
+          if (!expression) return expression;
+          if (!expect(TokenKind::RightParenthesis))
+            return failParse(ParserUnmatchedParenthesesError{});
+          return expression;
         }
-        return expression;
+      }()
+      };
+      if (!expression) return expression;
+      auto const next_token{ peekNextToken() };
+      if (!next_token) return std::unexpected{ next_token.error() };
+      if (next_token->isPostfixUnaryOperatorToken()) {
+        if (!std::dynamic_pointer_cast<VariableASTNode>(*expression))
+          return failParse(InvalidLValueError(*expression));
+        expression = makeNode<UnaryExpressionASTNode>(
+          parsePostfixUnaryOperator(),
+          *expression
+        );
       }
-    }()
-    };
-    if (Token next_token{ peekNextToken() };
-        next_token.isPostfixUnaryOperatorToken()) {
-      if (!std::dynamic_pointer_cast<VariableASTNode>(expression))
-        throw InvalidLValueError(expression);
-      expression = std::make_shared<UnaryExpressionASTNode>(
-        parsePostfixUnaryOperator(),
-        expression
-      );
+      return expression;
     }
-    return expression;
-  } catch (ParserError const &error) {
-    throw ParserNonTerminalError("factor", error);
+    );
   }
 } // namespace SC2
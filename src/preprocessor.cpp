@@ -0,0 +1,1220 @@
+#include <sc2/preprocessor.hpp>
+#include <string_view>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace SC2 {
+  namespace {
+    constexpr std::size_t max_include_depth{ 200 };
+
+    [[nodiscard]] constexpr bool isDigit(char const character) noexcept
+    {
+      return character >= '0' && character <= '9';
+    }
+
+    [[nodiscard]] constexpr bool isIdentifierStart(char const character
+    ) noexcept
+    {
+      return (character >= 'a' && character <= 'z')
+          || (character >= 'A' && character <= 'Z') || character == '_';
+    }
+
+    [[nodiscard]] constexpr bool isWordCharacter(char const character
+    ) noexcept
+    {
+      return isIdentifierStart(character) || isDigit(character);
+    }
+
+    [[nodiscard]] constexpr bool isHorizontalWhitespace(char const character
+    ) noexcept
+    {
+      switch (character) {
+      case ' ':
+      case '\t':
+      case '\v':
+      case '\f':
+      case '\r':
+        return true;
+      default:
+        return false;
+      }
+    }
+
+    // Characters that could run together with a neighbouring punctuator into
+    // a different one.
+    [[nodiscard]] constexpr bool isJoiningPunctuation(char const character
+    ) noexcept
+    {
+      return std::string_view{ "+-*/%<>=!&|^#.:" }.contains(character);
+    }
+
+    [[nodiscard]] constexpr bool
+    isPunctuator(PreprocessingToken const &token, std::string_view spelling)
+    {
+      return token.kind == PreprocessingTokenKind::Punctuator
+          && token.spelling == spelling;
+    }
+
+    // Translation phases 2 and 3: deletes backslash-newlines and replaces
+    // each comment by a space. The newlines they swallow are put back at the
+    // end of the logical line so that line numbers stay right.
+    [[nodiscard]] std::optional<std::string>
+    spliceLinesAndReplaceComments(std::string_view const text)
+    {
+      std::string result{};
+      result.reserve(text.size());
+      std::size_t deferred_newline_count{};
+      std::size_t position{};
+      // Moves a position past any backslash-newlines that start there.
+      auto const skipSplices{ [&text,
+                               &deferred_newline_count](std::size_t position) {
+        while (position < text.size() && text[position] == '\\') {
+          std::size_t next{ position + 1 };
+          if (next < text.size() && text[next] == '\r') ++next;
+          if (next >= text.size() || text[next] != '\n') break;
+          ++deferred_newline_count;
+          position = next + 1;
+        }
+        return position;
+      } };
+      while ((position = skipSplices(position)) < text.size()) {
+        char const  character{ text[position] };
+        std::size_t next{ skipSplices(position + 1) };
+        if (character == '/' && next < text.size() && text[next] == '/') {
+          position = next + 1;
+          while ((position = skipSplices(position)) < text.size()
+                 && text[position] != '\n')
+            ++position;
+          result += ' ';
+        } else if (character == '/' && next < text.size()
+                   && text[next] == '*') {
+          position = next + 1;
+          while (true) {
+            position = skipSplices(position);
+            if (position >= text.size()) return std::nullopt;
+            if (text[position] == '\n') ++deferred_newline_count;
+            next = skipSplices(position + 1);
+            if (text[position] == '*' && next < text.size()
+                && text[next] == '/')
+              break;
+            position = next;
+          }
+          position = next + 1;
+          result += ' ';
+        } else if (character == '"' || character == '\'') {
+          result   += character;
+          position  = next;
+          while ((position = skipSplices(position)) < text.size()
+                 && text[position] != '\n') {
+            result += text[position];
+            if (text[position] == character) {
+              ++position;
+              break;
+            }
+            if (text[position] == '\\') {
+              position = skipSplices(position + 1);
+              if (position < text.size() && text[position] != '\n')
+                result += text[position++];
+            } else
+              ++position;
+          }
+        } else {
+          result += character;
+          if (character == '\n') {
+            result.append(deferred_newline_count, '\n');
+            deferred_newline_count = 0;
+          }
+          position = next;
+        }
+      }
+      return result;
+    }
+
+    [[nodiscard]] std::size_t
+    scanQuoted(std::string_view const text, char const quote) noexcept
+    {
+      std::size_t size{ 1 };
+      while (size < text.size() && text[size] != quote) {
+        if (text[size] == '\\') ++size;
+        ++size;
+      }
+      // An unterminated literal is a lone quote, which only matters if it
+      // ends up in the output.
+      if (size >= text.size()) return 0;
+      return size + 1;
+    }
+
+    [[nodiscard]] std::pair<PreprocessingTokenKind, std::size_t>
+    scanPreprocessingToken(std::string_view const text)
+    {
+      using enum PreprocessingTokenKind;
+      char const character{ text.front() };
+      if (isIdentifierStart(character)) {
+        std::size_t size{ 1 };
+        while (size < text.size() && isWordCharacter(text[size])) ++size;
+        return { Identifier, size };
+      }
+      if (isDigit(character)
+          || (character == '.' && text.size() > 1 && isDigit(text[1]))) {
+        std::size_t size{ 1 };
+        while (size < text.size()) {
+          if ((text[size] == '+' || text[size] == '-')
+              && std::string_view{ "eEpP" }.contains(text[size - 1]))
+            ++size;
+          else if (isWordCharacter(text[size]) || text[size] == '.')
+            ++size;
+          else
+            break;
+        }
+        return { Number, size };
+      }
+      if (character == '\'' || character == '"') {
+        if (std::size_t const size{ scanQuoted(text, character) }; size > 0)
+          return { character == '"' ? StringLiteral : CharacterConstant,
+                   size };
+        return { Other, 1 };
+      }
+      for (std::string_view const punctuator:
+           { "%:%:", "...", "<<=", ">>=", "->", "++", "--", "<<", ">>",
+             "<=",   ">=",  "==",  "!=",  "&&", "||", "*=", "/=", "%=",
+             "+=",   "-=",  "&=",  "^=",  "|=", "##", "<:", ":>", "<%",
+             "%>",   "%:" })
+        if (text.starts_with(punctuator))
+          return { Punctuator, punctuator.size() };
+      if (std::string_view{ "[](){}.&*+-~!/%<>^|?:;=,#" }.contains(character))
+        return { Punctuator, 1 };
+      return { Other, 1 };
+    }
+
+    // Splits one logical line into preprocessing tokens.
+    [[nodiscard]] std::vector<PreprocessingToken>
+    tokenizeLine(std::string_view line)
+    {
+      std::vector<PreprocessingToken> tokens{};
+      bool                            has_leading_space{};
+      while (!line.empty()) {
+        if (isHorizontalWhitespace(line.front())) {
+          has_leading_space = true;
+          line.remove_prefix(1);
+          continue;
+        }
+        auto const [kind, size]{ scanPreprocessingToken(line) };
+        tokens.push_back({ .spelling          = line.substr(0, size),
+                           .kind              = kind,
+                           .has_leading_space = has_leading_space,
+                           .starts_line       = tokens.empty() });
+        line.remove_prefix(size);
+        has_leading_space = false;
+      }
+      return tokens;
+    }
+
+    [[nodiscard]] std::optional<std::size_t> findParameter(
+      std::span<std::string_view const> const parameters,
+      PreprocessingToken const               &token
+    )
+    {
+      if (token.kind != PreprocessingTokenKind::Identifier) return std::nullopt;
+      auto const parameter{ std::ranges::find(parameters, token.spelling) };
+      if (parameter == parameters.end()) return std::nullopt;
+      return static_cast<std::size_t>(
+        std::distance(parameters.begin(), parameter)
+      );
+    }
+
+    // The file name of an #include directive and whether it was written in
+    // angle brackets.
+    [[nodiscard]] std::optional<std::pair<std::string, bool>>
+    parseHeaderName(std::span<PreprocessingToken const> const tokens)
+    {
+      if (tokens.size() == 1
+          && tokens.front().kind == PreprocessingTokenKind::StringLiteral) {
+        std::string_view const spelling{ tokens.front().spelling };
+        return std::pair{
+          std::string{ spelling.substr(1, spelling.size() - 2) },
+          false
+        };
+      }
+      if (tokens.size() < 3 || !isPunctuator(tokens.front(), "<")
+          || !isPunctuator(tokens.back(), ">"))
+        return std::nullopt;
+      std::string name{};
+      for (auto const &token: tokens.subspan(1, tokens.size() - 2)) {
+        if (token.has_leading_space && !name.empty()) name += ' ';
+        name += token.spelling;
+      }
+      return std::pair{ std::move(name), true };
+    }
+
+    [[nodiscard]] std::string
+    getFileKey(std::filesystem::path const &path)
+    {
+      std::error_code error{};
+      auto const      canonical_path{
+        std::filesystem::weakly_canonical(path, error)
+      };
+      return (error ? path : canonical_path).string();
+    }
+
+    [[nodiscard]] std::optional<std::string>
+    readFile(std::filesystem::path const &path)
+    {
+      std::ifstream file{ path, std::ios::binary | std::ios::ate };
+      if (!file) return std::nullopt;
+      std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+      file.seekg(0);
+      if (!file.read(text.data(), static_cast<std::streamsize>(text.size())))
+        return std::nullopt;
+      return text;
+    }
+
+    // A value in an #if expression, where every integer has the type intmax_t
+    // or uintmax_t. The bits are those of the value in its type.
+    struct ConditionValue
+    {
+      std::uint64_t bits{};
+      bool          is_unsigned{};
+
+      [[nodiscard]] constexpr std::int64_t getSigned() const noexcept
+      {
+        return static_cast<std::int64_t>(bits);
+      }
+
+      [[nodiscard]] constexpr bool isTrue() const noexcept { return bits != 0; }
+    };
+
+    [[nodiscard]] constexpr ConditionValue
+    makeTruthValue(bool const value) noexcept
+    {
+      return { .bits = value, .is_unsigned = false };
+    }
+
+    // Evaluates the controlling expression of #if or #elif once defined has
+    // been resolved and macros expanded. Operands that short-circuiting
+    // skips are parsed but not evaluated, so they cannot divide by zero or
+    // overflow a division. Arithmetic follows the usual arithmetic
+    // conversions: an operation with an unsigned operand is unsigned.
+    class ConditionEvaluator
+    {
+      std::span<PreprocessingToken const> tokens{};
+      std::size_t                         position{};
+      bool                                is_valid{ true };
+
+      [[nodiscard]] bool accept(std::string_view const spelling)
+      {
+        if (position < tokens.size()
+            && isPunctuator(tokens[position], spelling)) {
+          ++position;
+          return true;
+        }
+        return false;
+      }
+
+      ConditionValue invalidate() noexcept
+      {
+        is_valid = false;
+        return {};
+      }
+
+      [[nodiscard]] static constexpr int
+      getBinaryPrecedence(std::string_view const spelling) noexcept
+      {
+        if (spelling == "*" || spelling == "/" || spelling == "%") return 10;
+        if (spelling == "+" || spelling == "-") return 9;
+        if (spelling == "<<" || spelling == ">>") return 8;
+        if (spelling == "<" || spelling == ">" || spelling == "<="
+            || spelling == ">=")
+          return 7;
+        if (spelling == "==" || spelling == "!=") return 6;
+        if (spelling == "&") return 5;
+        if (spelling == "^") return 4;
+        if (spelling == "|") return 3;
+        if (spelling == "&&") return 2;
+        if (spelling == "||") return 1;
+        return 0;
+      }
+
+      // A constant with a u or U suffix is unsigned, and so is one too large
+      // for intmax_t.
+      [[nodiscard]] ConditionValue parseNumber(std::string_view spelling)
+      {
+        bool is_unsigned{};
+        while (!spelling.empty()
+               && std::string_view{ "uUlL" }.contains(spelling.back())) {
+          if (spelling.back() == 'u' || spelling.back() == 'U')
+            is_unsigned = true;
+          spelling.remove_suffix(1);
+        }
+        int base{ 10 };
+        if (spelling.size() > 2
+            && (spelling.starts_with("0x") || spelling.starts_with("0X"))) {
+          base = 16;
+          spelling.remove_prefix(2);
+        } else if (spelling.size() > 1 && spelling.front() == '0') {
+          base = 8;
+          spelling.remove_prefix(1);
+        }
+        std::uint64_t value{};
+        auto const [end, error]{ std::from_chars(
+          spelling.data(),
+          spelling.data() + spelling.size(),
+          value,
+          base
+        ) };
+        if (error != std::errc{} || end != spelling.data() + spelling.size())
+          return invalidate();
+        return { .bits        = value,
+                 .is_unsigned = is_unsigned
+                             || value > static_cast<std::uint64_t>(
+                                  std::numeric_limits<std::int64_t>::max()
+                                ) };
+      }
+
+      [[nodiscard]] ConditionValue
+      parseCharacterConstant(std::string_view spelling)
+      {
+        auto const character{ [](char const value) {
+          return ConditionValue{
+            .bits = static_cast<std::uint64_t>(std::int64_t{ value })
+          };
+        } };
+        spelling = spelling.substr(1, spelling.size() - 2);
+        if (spelling.size() == 1) return character(spelling.front());
+        if (spelling.size() < 2 || spelling.front() != '\\')
+          return invalidate();
+        switch (spelling[1]) {
+        case 'n':
+          return character('\n');
+        case 't':
+          return character('\t');
+        case 'r':
+          return character('\r');
+        case 'a':
+          return character('\a');
+        case 'b':
+          return character('\b');
+        case 'f':
+          return character('\f');
+        case 'v':
+          return character('\v');
+        case '\\':
+        case '\'':
+        case '"':
+        case '?':
+          return character(spelling[1]);
+        default:
+          break;
+        }
+        bool const    is_hexadecimal{ spelling[1] == 'x' };
+        std::uint8_t  value{};
+        char const   *first{ spelling.data() + (is_hexadecimal ? 2 : 1) };
+        char const   *last{ spelling.data() + spelling.size() };
+        auto const [end, error]{
+          std::from_chars(first, last, value, is_hexadecimal ? 16 : 8)
+        };
+        if (error != std::errc{} || end != last) return invalidate();
+        return character(static_cast<char>(value));
+      }
+
+      [[nodiscard]] ConditionValue parsePrimary(bool const is_evaluated)
+      {
+        if (accept("(")) {
+          ConditionValue const value{ parseConditional(is_evaluated) };
+          if (!accept(")")) return invalidate();
+          return value;
+        }
+        if (position >= tokens.size()) return invalidate();
+        auto const &token{ tokens[position++] };
+        switch (token.kind) {
+        case PreprocessingTokenKind::Number:
+          return parseNumber(token.spelling);
+        case PreprocessingTokenKind::CharacterConstant:
+          return parseCharacterConstant(token.spelling);
+        // Identifiers that are left after macro expansion stand for 0.
+        case PreprocessingTokenKind::Identifier:
+          return {};
+        default:
+          return invalidate();
+        }
+      }
+
+      [[nodiscard]] ConditionValue parseUnary(bool const is_evaluated)
+      {
+        if (accept("+")) return parseUnary(is_evaluated);
+        if (accept("-")) {
+          ConditionValue const operand{ parseUnary(is_evaluated) };
+          return { .bits = -operand.bits, .is_unsigned = operand.is_unsigned };
+        }
+        if (accept("~")) {
+          ConditionValue const operand{ parseUnary(is_evaluated) };
+          return { .bits = ~operand.bits, .is_unsigned = operand.is_unsigned };
+        }
+        if (accept("!"))
+          return makeTruthValue(!parseUnary(is_evaluated).isTrue());
+        return parsePrimary(is_evaluated);
+      }
+
+      [[nodiscard]] ConditionValue
+      parseBinary(int const minimum_precedence, bool const is_evaluated)
+      {
+        ConditionValue left{ parseUnary(is_evaluated) };
+        while (is_valid && position < tokens.size()
+               && tokens[position].kind == PreprocessingTokenKind::Punctuator) {
+          std::string_view const spelling{ tokens[position].spelling };
+          int const              precedence{ getBinaryPrecedence(spelling) };
+          if (precedence == 0 || precedence < minimum_precedence) break;
+          ++position;
+          if (spelling == "&&") {
+            ConditionValue const right{
+              parseBinary(precedence + 1, is_evaluated && left.isTrue())
+            };
+            left = makeTruthValue(left.isTrue() && right.isTrue());
+            continue;
+          }
+          if (spelling == "||") {
+            ConditionValue const right{
+              parseBinary(precedence + 1, is_evaluated && !left.isTrue())
+            };
+            left = makeTruthValue(left.isTrue() || right.isTrue());
+            continue;
+          }
+          ConditionValue const right{
+            parseBinary(precedence + 1, is_evaluated)
+          };
+          left = applyBinaryOperator(spelling, left, right, is_evaluated);
+        }
+        return left;
+      }
+
+      // A shift has the type of its left operand; every other operator
+      // converts both operands to unsigned if either is.
+      [[nodiscard]] ConditionValue applyBinaryOperator(
+        std::string_view const spelling,
+        ConditionValue const   left,
+        ConditionValue const   right,
+        bool const             is_evaluated
+      )
+      {
+        bool const is_unsigned{ left.is_unsigned || right.is_unsigned };
+        if (spelling == "<<" || spelling == ">>") {
+          // A negative count has its top bit set, so it is out of range too.
+          if (right.bits > 63)
+            return is_evaluated ? invalidate() : ConditionValue{};
+          if (spelling == "<<")
+            return { .bits        = left.bits << right.bits,
+                     .is_unsigned = left.is_unsigned };
+          return { .bits = left.is_unsigned
+                           ? left.bits >> right.bits
+                           : static_cast<std::uint64_t>(
+                               left.getSigned() >> right.bits
+                             ),
+                   .is_unsigned = left.is_unsigned };
+        }
+        if (spelling == "/" || spelling == "%") {
+          // The smallest value divided by -1 overflows, which traps on x86-64
+          // just like dividing by zero.
+          std::int64_t const minimum{
+            std::numeric_limits<std::int64_t>::min()
+          };
+          if (right.bits == 0
+              || (!is_unsigned && left.getSigned() == minimum
+                  && right.getSigned() == -1))
+            return is_evaluated ? invalidate() : ConditionValue{};
+          if (is_unsigned)
+            return { .bits        = spelling == "/" ? left.bits / right.bits
+                                                    : left.bits % right.bits,
+                     .is_unsigned = true };
+          return { .bits = static_cast<std::uint64_t>(
+                     spelling == "/" ? left.getSigned() / right.getSigned()
+                                     : left.getSigned() % right.getSigned()
+                   ) };
+        }
+        if (spelling == "<" || spelling == ">" || spelling == "<="
+            || spelling == ">=") {
+          // Compared as signed, the order of the values is the order of
+          // their bits with the sign bit flipped.
+          std::uint64_t const bias{ is_unsigned ? 0 : 1ULL << 63 };
+          std::uint64_t const left_key{ left.bits ^ bias };
+          std::uint64_t const right_key{ right.bits ^ bias };
+          if (spelling == "<") return makeTruthValue(left_key < right_key);
+          if (spelling == ">") return makeTruthValue(left_key > right_key);
+          if (spelling == "<=") return makeTruthValue(left_key <= right_key);
+          return makeTruthValue(left_key >= right_key);
+        }
+        if (spelling == "==") return makeTruthValue(left.bits == right.bits);
+        if (spelling == "!=") return makeTruthValue(left.bits != right.bits);
+        // Wrapping arithmetic on the bits gives the signed result too, since
+        // signed overflow in #if is left to the implementation.
+        std::uint64_t bits{};
+        if (spelling == "*")
+          bits = left.bits * right.bits;
+        else if (spelling == "+")
+          bits = left.bits + right.bits;
+        else if (spelling == "-")
+          bits = left.bits - right.bits;
+        else if (spelling == "&")
+          bits = left.bits & right.bits;
+        else if (spelling == "^")
+          bits = left.bits ^ right.bits;
+        else
+          bits = left.bits | right.bits;
+        return { .bits = bits, .is_unsigned = is_unsigned };
+      }
+
+      [[nodiscard]] ConditionValue parseConditional(bool const is_evaluated)
+      {
+        ConditionValue const condition{ parseBinary(1, is_evaluated) };
+        if (!accept("?")) return condition;
+        ConditionValue const if_true{
+          parseConditional(is_evaluated && condition.isTrue())
+        };
+        if (!accept(":")) return invalidate();
+        ConditionValue const if_false{
+          parseConditional(is_evaluated && !condition.isTrue())
+        };
+        ConditionValue const result{ condition.isTrue() ? if_true : if_false };
+        return { .bits        = result.bits,
+                 .is_unsigned = if_true.is_unsigned || if_false.is_unsigned };
+      }
+
+      public:
+      explicit ConditionEvaluator(std::span<PreprocessingToken const> tokens)
+        : tokens{ tokens }
+      {}
+
+      [[nodiscard]] std::optional<bool> evaluate()
+      {
+        ConditionValue const value{ parseConditional(true) };
+        if (!is_valid || position != tokens.size()) return std::nullopt;
+        return value.isTrue();
+      }
+    };
+  } // namespace
+
+  Preprocessor::Preprocessor(
+    std::vector<std::filesystem::path> include_directories
+  )
+    : include_directories{ std::move(include_directories) }
+  {
+    defineMacro("__STDC__", "1");
+    defineMacro("__STDC_HOSTED__", "1");
+    defineMacro("__STDC_VERSION__", "201710L");
+#if defined(__x86_64__)
+    defineMacro("__x86_64__", "1");
+#endif
+#if defined(__linux__)
+    defineMacro("__linux__", "1");
+#endif
+#if defined(__APPLE__) || defined(__MACH__)
+    defineMacro("__APPLE__", "1");
+#endif
+  }
+
+  void Preprocessor::fail(std::string_view const problem) const
+  {
+    throw PreprocessorError(
+      std::format("{}:{}: {}", current_file.string(), current_line, problem)
+    );
+  }
+
+  void Preprocessor::defineMacro(
+    std::string_view const name,
+    std::string_view const replacement
+  )
+  {
+    std::string_view const definition{
+      buffers.emplace_back(std::format("{} {}", name, replacement))
+    };
+    defineMacro(tokenizeLine(definition));
+  }
+
+  std::string
+  Preprocessor::preprocessFile(std::filesystem::path const &path)
+  {
+    auto const text{ readFile(path) };
+    if (!text)
+      throw PreprocessorError(std::format("cannot read {}", path.string()));
+    ++read_file_count;
+    return preprocess(*text, path);
+  }
+
+  std::string Preprocessor::preprocess(
+    std::string_view const       text,
+    std::filesystem::path const &path
+  )
+  {
+    output.clear();
+    pending_text.clear();
+    conditionals.clear();
+    include_depth = 0;
+    processFile(path, text);
+    if (!output.empty()) output += '\n';
+    return std::exchange(output, {});
+  }
+
+  void Preprocessor::processFile(
+    std::filesystem::path const &path,
+    std::string_view const       text
+  )
+  {
+    current_file = path;
+    current_line = 0;
+    auto cleaned_text{ spliceLinesAndReplaceComments(text) };
+    if (!cleaned_text) fail("unterminated comment");
+    std::string_view remaining_text{ buffers.emplace_back(
+      std::move(*cleaned_text)
+    ) };
+    std::size_t const conditional_depth{ conditionals.size() };
+    IncludeGuard      guard{};
+    while (!remaining_text.empty()) {
+      ++current_line;
+      std::size_t const line_size{
+        std::min(remaining_text.find('\n'), remaining_text.size())
+      };
+      auto const tokens{ tokenizeLine(remaining_text.substr(0, line_size)) };
+      remaining_text.remove_prefix(
+        std::min(line_size + 1, remaining_text.size())
+      );
+      if (tokens.empty()) continue;
+      if (isPunctuator(tokens.front(), "#")
+          || isPunctuator(tokens.front(), "%:")) {
+        handleDirective(std::span{ tokens }.subspan(1), guard);
+        continue;
+      }
+      if (!guard.name || guard.is_closed) guard.is_possible = false;
+      if (isActive())
+        pending_text.insert(pending_text.end(), tokens.begin(), tokens.end());
+    }
+    if (conditionals.size() != conditional_depth)
+      fail("unterminated conditional directive");
+    flushText();
+    if (guard.name && guard.is_closed && guard.is_possible)
+      include_guards.insert_or_assign(getFileKey(path), *guard.name);
+  }
+
+  void Preprocessor::flushText()
+  {
+    if (pending_text.empty()) return;
+    bool is_newline_pending{};
+    bool is_space_pending{};
+    for (auto const &token: expand(std::exchange(pending_text, {}), {})) {
+      is_newline_pending = is_newline_pending || token.starts_line;
+      is_space_pending   = is_space_pending || token.has_leading_space;
+      if (token.kind == PreprocessingTokenKind::Placemarker
+          || token.kind == PreprocessingTokenKind::EndOfExpansion)
+        continue;
+      if (!output.empty()) {
+        char const previous{ output.back() };
+        char const next{ token.spelling.front() };
+        if (is_newline_pending) output += '\n';
+        else if (is_space_pending
+                 || (isWordCharacter(previous) && isWordCharacter(next))
+                 || (isJoiningPunctuation(previous)
+                     && isJoiningPunctuation(next)))
+          output += ' ';
+      }
+      output             += token.spelling;
+      is_newline_pending  = false;
+      is_space_pending    = false;
+    }
+  }
+
+  void Preprocessor::handleDirective(
+    std::span<PreprocessingToken const> const tokens,
+    IncludeGuard                             &guard
+  )
+  {
+    if (tokens.empty()) return;
+    std::string_view const directive{ tokens.front().spelling };
+    auto const             arguments{ tokens.subspan(1) };
+    if (guard.is_closed || (!guard.name && directive != "ifndef"))
+      guard.is_possible = false;
+    if (directive == "if" || directive == "ifdef" || directive == "ifndef"
+        || directive == "elif" || directive == "else" || directive == "endif") {
+      handleConditional(directive, arguments, guard);
+      return;
+    }
+    if (!isActive()) return;
+    flushText();
+    if (directive == "define") defineMacro(arguments);
+    else if (directive == "undef") {
+      if (arguments.size() != 1
+          || arguments.front().kind != PreprocessingTokenKind::Identifier)
+        fail("#undef expects a macro name");
+      macros.erase(arguments.front().spelling);
+    } else if (directive == "include")
+      includeFile(arguments);
+    else if (directive == "error") {
+      std::string message{};
+      for (auto const &token: arguments) {
+        if (token.has_leading_space && !message.empty()) message += ' ';
+        message += token.spelling;
+      }
+      fail(std::format("#error {}", message));
+    } else if (directive == "pragma") {
+      if (arguments.size() == 1 && arguments.front().spelling == "once")
+        once_only_files.insert(getFileKey(current_file));
+    } else if (directive != "line" && directive != "warning")
+      fail(std::format("invalid directive #{}", directive));
+  }
+
+  void Preprocessor::handleConditional(
+    std::string_view const                    directive,
+    std::span<PreprocessingToken const> const arguments,
+    IncludeGuard                             &guard
+  )
+  {
+    if (directive == "if" || directive == "ifdef" || directive == "ifndef") {
+      if (!isActive()) {
+        conditionals.push_back({ .is_active        = false,
+                                 .has_taken_branch = true });
+        return;
+      }
+      bool is_taken{};
+      if (directive == "if") is_taken = evaluateCondition(arguments);
+      else {
+        if (arguments.size() != 1
+            || arguments.front().kind != PreprocessingTokenKind::Identifier)
+          fail(std::format("#{} expects a macro name", directive));
+        is_taken = macros.contains(arguments.front().spelling)
+                == (directive == "ifdef");
+        if (directive == "ifndef" && !guard.name && guard.is_possible) {
+          guard.name  = arguments.front().spelling;
+          guard.depth = conditionals.size();
+        }
+      }
+      conditionals.push_back({ .is_active        = is_taken,
+                               .has_taken_branch = is_taken });
+      return;
+    }
+    if (conditionals.empty()) fail(std::format("#{} without #if", directive));
+    if (guard.name && !guard.is_closed
+        && conditionals.size() - 1 == guard.depth) {
+      if (directive == "endif") guard.is_closed = true;
+      else guard.is_possible = false;
+    }
+    if (directive == "endif") {
+      conditionals.pop_back();
+      return;
+    }
+    Conditional &conditional{ conditionals.back() };
+    if (conditional.has_seen_else)
+      fail(std::format("#{} after #else", directive));
+    if (directive == "else") {
+      conditional.is_active        = !conditional.has_taken_branch;
+      conditional.has_taken_branch = true;
+      conditional.has_seen_else    = true;
+      return;
+    }
+    conditional.is_active = !conditional.has_taken_branch
+                         && evaluateCondition(arguments);
+    conditional.has_taken_branch = conditional.has_taken_branch
+                                || conditional.is_active;
+  }
+
+  void Preprocessor::defineMacro(
+    std::span<PreprocessingToken const> const tokens
+  )
+  {
+    if (tokens.empty()
+        || tokens.front().kind != PreprocessingTokenKind::Identifier)
+      fail("macro names must be identifiers");
+    std::string_view const name{ tokens.front().spelling };
+    if (name == "defined") fail("\"defined\" cannot be used as a macro name");
+    Macro       macro{};
+    std::size_t position{ 1 };
+    if (position < tokens.size() && isPunctuator(tokens[position], "(")
+        && !tokens[position].has_leading_space) {
+      macro.is_function_like = true;
+      ++position;
+      if (position < tokens.size() && isPunctuator(tokens[position], ")"))
+        ++position;
+      else
+        while (true) {
+          if (position >= tokens.size())
+            fail(std::format("unterminated parameter list of macro {}", name));
+          auto const &parameter{ tokens[position++] };
+          if (isPunctuator(parameter, "...")) {
+            macro.is_variadic = true;
+            macro.parameters.push_back("__VA_ARGS__");
+          } else if (parameter.kind == PreprocessingTokenKind::Identifier
+                     && !findParameter(macro.parameters, parameter))
+            macro.parameters.push_back(parameter.spelling);
+          else
+            fail(std::format(
+              "invalid parameter {} of macro {}",
+              parameter.spelling,
+              name
+            ));
+          if (position >= tokens.size())
+            fail(std::format("unterminated parameter list of macro {}", name));
+          auto const &separator{ tokens[position++] };
+          if (isPunctuator(separator, ")")) break;
+          if (!isPunctuator(separator, ",") || macro.is_variadic)
+            fail(std::format("invalid parameter list of macro {}", name));
+        }
+    }
+    macro.body.assign(tokens.begin() + position, tokens.end());
+    for (auto &token: macro.body) {
+      token.starts_line = false;
+      if (isPunctuator(token, "##")) token.kind = PreprocessingTokenKind::Paste;
+    }
+    if (!macro.body.empty()) {
+      macro.body.front().has_leading_space = false;
+      if (macro.body.front().kind == PreprocessingTokenKind::Paste
+          || macro.body.back().kind == PreprocessingTokenKind::Paste)
+        fail("'##' cannot appear at either end of a macro expansion");
+    }
+    if (macro.is_function_like)
+      for (std::size_t index{}; index < macro.body.size(); ++index)
+        if (isPunctuator(macro.body[index], "#")
+            && (index + 1 == macro.body.size()
+                || !findParameter(macro.parameters, macro.body[index + 1])))
+          fail("'#' is not followed by a macro parameter");
+    macros.insert_or_assign(name, std::move(macro));
+  }
+
+  void
+  Preprocessor::includeFile(std::span<PreprocessingToken const> const tokens)
+  {
+    auto header_name{ parseHeaderName(tokens) };
+    if (!header_name)
+      header_name = parseHeaderName(
+        expand({ tokens.begin(), tokens.end() }, {})
+      );
+    if (!header_name) fail("#include expects \"FILENAME\" or <FILENAME>");
+    auto const &[name, is_angled]{ *header_name };
+    auto const path{ findIncludeFile(name, is_angled) };
+    if (!path) fail(std::format("cannot find include file {}", name));
+    if (include_depth >= max_include_depth) fail("#include nested too deeply");
+    std::string const key{ getFileKey(*path) };
+    if (once_only_files.contains(key)) return;
+    if (auto const guard{ include_guards.find(key) };
+        guard != include_guards.end() && macros.contains(guard->second))
+      return;
+    auto const text{ readFile(*path) };
+    if (!text) fail(std::format("cannot read {}", path->string()));
+    ++read_file_count;
+    auto const        including_file{ current_file };
+    std::size_t const including_line{ current_line };
+    ++include_depth;
+    processFile(*path, *text);
+    --include_depth;
+    current_file = including_file;
+    current_line = including_line;
+  }
+
+  std::optional<std::filesystem::path> Preprocessor::findIncludeFile(
+    std::string_view const name,
+    bool const             is_angled
+  ) const
+  {
+    std::error_code error{};
+    if (!is_angled) {
+      auto const path{ current_file.parent_path() / name };
+      if (std::filesystem::is_regular_file(path, error)) return path;
+    }
+    for (auto const &directory: include_directories) {
+      auto const path{ directory / name };
+      if (std::filesystem::is_regular_file(path, error)) return path;
+    }
+    return std::nullopt;
+  }
+
+  bool Preprocessor::evaluateCondition(
+    std::span<PreprocessingToken const> const tokens
+  )
+  {
+    std::vector<PreprocessingToken> resolved_tokens{};
+    resolved_tokens.reserve(tokens.size());
+    for (std::size_t position{}; position < tokens.size(); ++position) {
+      auto const &token{ tokens[position] };
+      if (token.kind != PreprocessingTokenKind::Identifier
+          || token.spelling != "defined") {
+        resolved_tokens.push_back(token);
+        continue;
+      }
+      bool const has_parentheses{ position + 1 < tokens.size()
+                                  && isPunctuator(tokens[position + 1], "(") };
+      position += has_parentheses ? 2 : 1;
+      if (position >= tokens.size()
+          || tokens[position].kind != PreprocessingTokenKind::Identifier)
+        fail("\"defined\" expects a macro name");
+      bool const is_defined{ macros.contains(tokens[position].spelling) };
+      if (has_parentheses
+          && (++position >= tokens.size()
+              || !isPunctuator(tokens[position], ")")))
+        fail("missing ')' after \"defined\"");
+      resolved_tokens.push_back(
+        { .spelling          = is_defined ? "1" : "0",
+          .kind              = PreprocessingTokenKind::Number,
+          .has_leading_space = token.has_leading_space }
+      );
+    }
+    auto expanded_tokens{ expand(std::move(resolved_tokens), {}) };
+    std::erase_if(expanded_tokens, [](PreprocessingToken const &token) {
+      return token.kind == PreprocessingTokenKind::Placemarker
+          || token.kind == PreprocessingTokenKind::EndOfExpansion;
+    });
+    if (expanded_tokens.empty()) fail("#if with no expression");
+    auto const value{ ConditionEvaluator{ expanded_tokens }.evaluate() };
+    if (!value) fail("invalid expression in #if");
+    return *value;
+  }
+
+  std::vector<PreprocessingToken> Preprocessor::expand(
+    std::vector<PreprocessingToken> tokens,
+    std::vector<std::string_view>   active_macros
+  )
+  {
+    // The tokens still to be scanned, next token last, so that a macro's
+    // replacement can be pushed in front of the rest in place.
+    std::vector<PreprocessingToken> pending{ std::move(tokens) };
+    std::ranges::reverse(pending);
+    std::vector<PreprocessingToken> result{};
+    result.reserve(pending.size());
+    while (!pending.empty()) {
+      PreprocessingToken token{ pending.back() };
+      pending.pop_back();
+      if (token.kind == PreprocessingTokenKind::EndOfExpansion) {
+        active_macros.pop_back();
+        continue;
+      }
+      if (token.kind != PreprocessingTokenKind::Identifier
+          || token.is_painted) {
+        result.push_back(token);
+        continue;
+      }
+      auto const macro{ macros.find(token.spelling) };
+      if (macro == macros.end()) {
+        result.push_back(token);
+        continue;
+      }
+      if (std::ranges::find(active_macros, token.spelling)
+          != active_macros.end()) {
+        token.is_painted = true;
+        result.push_back(token);
+        continue;
+      }
+      Arguments arguments{};
+      if (macro->second.is_function_like) {
+        auto const next{ std::ranges::find_if(
+          pending.rbegin(),
+          pending.rend(),
+          [](PreprocessingToken const &next_token) {
+            return next_token.kind != PreprocessingTokenKind::EndOfExpansion;
+          }
+        ) };
+        if (next == pending.rend() || !isPunctuator(*next, "(")) {
+          result.push_back(token);
+          continue;
+        }
+        arguments = collectArguments(pending, active_macros, token.spelling);
+      }
+      auto replacement{ substitute(macro->second, arguments, active_macros) };
+      if (replacement.empty())
+        replacement.push_back({ .kind = PreprocessingTokenKind::Placemarker });
+      replacement.front().has_leading_space = token.has_leading_space;
+      replacement.front().starts_line       = token.starts_line;
+      pending.push_back({ .spelling = token.spelling,
+                          .kind     = PreprocessingTokenKind::EndOfExpansion });
+      pending.insert(
+        pending.end(),
+        std::make_move_iterator(replacement.rbegin()),
+        std::make_move_iterator(replacement.rend())
+      );
+      active_macros.push_back(token.spelling);
+    }
+    return result;
+  }
+
+  Preprocessor::Arguments Preprocessor::collectArguments(
+    std::vector<PreprocessingToken> &pending,
+    std::vector<std::string_view>   &active_macros,
+    std::string_view const           name
+  )
+  {
+    Macro const &macro{ macros.at(name) };
+    Arguments    arguments(1);
+    std::size_t  depth{};
+    bool         has_seen_left_parenthesis{};
+    while (true) {
+      if (pending.empty())
+        fail(std::format("unterminated argument list invoking macro {}", name));
+      PreprocessingToken token{ pending.back() };
+      pending.pop_back();
+      if (token.kind == PreprocessingTokenKind::EndOfExpansion) {
+        active_macros.pop_back();
+        continue;
+      }
+      if (!has_seen_left_parenthesis) {
+        has_seen_left_parenthesis = true;
+        continue;
+      }
+      if (isPunctuator(token, "(")) ++depth;
+      else if (isPunctuator(token, ")")) {
+        if (depth == 0) break;
+        --depth;
+      } else if (isPunctuator(token, ",") && depth == 0
+                 && !(macro.is_variadic
+                      && arguments.size() == macro.parameters.size())) {
+        arguments.emplace_back();
+        continue;
+      }
+      // An invocation can span lines, but its arguments are joined onto one.
+      if (token.starts_line) {
+        token.starts_line       = false;
+        token.has_leading_space = true;
+      }
+      arguments.back().push_back(token);
+    }
+    if (macro.parameters.empty() && arguments.size() == 1
+        && arguments.front().empty())
+      arguments.clear();
+    if (macro.is_variadic && arguments.size() + 1 == macro.parameters.size())
+      arguments.emplace_back();
+    if (arguments.size() != macro.parameters.size())
+      fail(std::format(
+        "macro {} expects {} arguments but was given {}",
+        name,
+        macro.parameters.size(),
+        arguments.size()
+      ));
+    return arguments;
+  }
+
+  std::vector<PreprocessingToken> Preprocessor::substitute(
+    Macro const                         &macro,
+    Arguments const                     &arguments,
+    std::vector<std::string_view> const &active_macros
+  )
+  {
+    auto const &body{ macro.body };
+    // The tokens the body token at an index stands for when it is an operand
+    // of ## or #, which are not macro-expanded. Advances past a # operator.
+    auto const getUnexpandedOperand{
+      [this, &macro, &body, &arguments](std::size_t &index) {
+      std::vector<PreprocessingToken> operand{};
+      if (!macro.is_function_like) {
+        operand.push_back(body[index]);
+        return operand;
+      }
+      if (isPunctuator(body[index], "#")) {
+        bool const has_leading_space{ body[index].has_leading_space };
+        ++index;
+        operand.push_back(stringize(
+          arguments[*findParameter(macro.parameters, body[index])],
+          has_leading_space
+        ));
+      } else if (auto const parameter{
+                   findParameter(macro.parameters, body[index]) }) {
+        operand = arguments[*parameter];
+        if (operand.empty())
+          operand.push_back({ .kind = PreprocessingTokenKind::Placemarker });
+        operand.front().has_leading_space = body[index].has_leading_space;
+      } else
+        operand.push_back(body[index]);
+      return operand;
+    }
+    };
+    std::vector<PreprocessingToken> result{};
+    for (std::size_t index{}; index < body.size(); ++index) {
+      auto const &token{ body[index] };
+      bool const  is_pasted_to_next{
+        index + 1 < body.size()
+        && body[index + 1].kind == PreprocessingTokenKind::Paste
+      };
+      if (token.kind == PreprocessingTokenKind::Paste) {
+        ++index;
+        auto const operand{ getUnexpandedOperand(index) };
+        result.back() = paste(result.back(), operand.front());
+        result.insert(result.end(), operand.begin() + 1, operand.end());
+        continue;
+      }
+      auto const parameter{
+        macro.is_function_like ? findParameter(macro.parameters, token)
+                               : std::nullopt
+      };
+      if (is_pasted_to_next || !parameter) {
+        auto const operand{ getUnexpandedOperand(index) };
+        result.insert(result.end(), operand.begin(), operand.end());
+        continue;
+      }
+      auto expanded_argument{ expand(arguments[*parameter], active_macros) };
+      if (expanded_argument.empty()) continue;
+      expanded_argument.front().has_leading_space = token.has_leading_space;
+      result.insert(
+        result.end(),
+        expanded_argument.begin(),
+        expanded_argument.end()
+      );
+    }
+    std::erase_if(result, [](PreprocessingToken const &token) {
+      return token.kind == PreprocessingTokenKind::Placemarker;
+    });
+    return result;
+  }
+
+  PreprocessingToken Preprocessor::paste(
+    PreprocessingToken const &left,
+    PreprocessingToken const &right
+  )
+  {
+    if (left.kind == PreprocessingTokenKind::Placemarker) {
+      PreprocessingToken result{ right };
+      result.has_leading_space = left.has_leading_space;
+      return result;
+    }
+    if (right.kind == PreprocessingTokenKind::Placemarker) return left;
+    auto const tokens{ tokenizeLine(
+      buffers.emplace_back(std::format("{}{}", left.spelling, right.spelling))
+    ) };
+    if (tokens.size() != 1)
+      fail(std::format(
+        "pasting \"{}\" and \"{}\" does not give a valid preprocessing token",
+        left.spelling,
+        right.spelling
+      ));
+    PreprocessingToken result{ tokens.front() };
+    result.has_leading_space = left.has_leading_space;
+    result.starts_line       = left.starts_line;
+    return result;
+  }
+
+  PreprocessingToken Preprocessor::stringize(
+    std::span<PreprocessingToken const> const argument,
+    bool const                                has_leading_space
+  )
+  {
+    std::string text{ "\"" };
+    for (auto const &token: argument) {
+      if (token.has_leading_space && text.size() > 1) text += ' ';
+      if (token.kind == PreprocessingTokenKind::StringLiteral
+          || token.kind == PreprocessingTokenKind::CharacterConstant)
+        for (char const character: token.spelling) {
+          if (character == '"' || character == '\\') text += '\\';
+          text += character;
+        }
+      else
+        text += token.spelling;
+    }
+    text += '"';
+    return { .spelling          = buffers.emplace_back(std::move(text)),
+             .kind              = PreprocessingTokenKind::StringLiteral,
+             .has_leading_space = has_leading_space };
+  }
+} // namespace SC2
@@ -0,0 +1,355 @@
+#include <sc2/assembly_ast.hpp>
+#include <sc2/register_allocator.hpp>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SC2 {
+  namespace {
+    // A set of graph nodes with constant-time insertion, removal and
+    // membership tests, reused across the instructions of a basic block.
+    class SparseSet
+    {
+      std::vector<std::uint32_t> dense{};
+      std::vector<std::uint32_t> sparse{};
+
+      public:
+      explicit SparseSet(std::uint32_t universe): sparse(universe) {}
+
+      [[nodiscard]] bool contains(std::uint32_t node) const
+      {
+        return sparse[node] < dense.size() && dense[sparse[node]] == node;
+      }
+
+      void insert(std::uint32_t node)
+      {
+        if (contains(node)) return;
+        sparse[node] = static_cast<std::uint32_t>(dense.size());
+        dense.push_back(node);
+      }
+
+      void erase(std::uint32_t node)
+      {
+        if (!contains(node)) return;
+        std::uint32_t const last{ dense.back() };
+        dense[sparse[node]] = last;
+        sparse[last]        = sparse[node];
+        dense.pop_back();
+      }
+
+      void clear() noexcept { dense.clear(); }
+
+      [[nodiscard]] std::span<std::uint32_t const> getNodes() const noexcept
+      {
+        return dense;
+      }
+    };
+
+    void sortUnique(std::vector<std::uint32_t> &nodes)
+    {
+      std::ranges::sort(nodes);
+      auto const duplicates{ std::ranges::unique(nodes) };
+      nodes.erase(duplicates.begin(), duplicates.end());
+    }
+  } // namespace
+
+  RegisterAllocator::RegisterAllocator(
+    std::span<std::shared_ptr<InstructionAssemblyASTNode> const> instructions
+  )
+    : node_count{ hard_register_count }
+  {
+    data_flows.reserve(instructions.size());
+    for (auto const &instruction: instructions) {
+      auto &data_flow{ data_flows.emplace_back() };
+      instruction->describeDataFlow(data_flow);
+      for (auto const node: data_flow.uses)
+        node_count = std::max(node_count, node + 1);
+      for (auto const node: data_flow.definitions)
+        node_count = std::max(node_count, node + 1);
+    }
+    interferences.resize(node_count);
+    occurrences.resize(node_count);
+    aliases.resize(node_count);
+    for (std::uint32_t node{}; node < node_count; ++node) aliases[node] = node;
+  }
+
+  [[nodiscard]] std::uint32_t RegisterAllocator::getAlias(std::uint32_t node)
+  {
+    while (aliases[node] != node) {
+      aliases[node] = aliases[aliases[node]];
+      node          = aliases[node];
+    }
+    return node;
+  }
+
+  void RegisterAllocator::buildBasicBlocks()
+  {
+    std::unordered_map<std::string_view, std::size_t> label_to_block{};
+    for (std::size_t index{}; index < data_flows.size(); ++index) {
+      auto const &data_flow{ data_flows[index] };
+      bool const  starts_block{
+        basic_blocks.empty() || data_flow.label
+        || !data_flows[index - 1].falls_through
+        || data_flows[index - 1].jump_target
+      };
+      if (starts_block) basic_blocks.push_back({ index, index });
+      basic_blocks.back().last_instruction = index;
+      if (data_flow.label)
+        label_to_block.emplace(*data_flow.label, basic_blocks.size() - 1);
+    }
+    for (std::size_t block{}; block < basic_blocks.size(); ++block) {
+      auto &basic_block{ basic_blocks[block] };
+      auto const &last_data_flow{ data_flows[basic_block.last_instruction] };
+      if (last_data_flow.jump_target) {
+        if (auto const target{ label_to_block.find(*last_data_flow.jump_target
+            ) };
+            target != label_to_block.end())
+          basic_block.successors.push_back(target->second);
+      }
+      if (last_data_flow.falls_through && block + 1 < basic_blocks.size())
+        basic_block.successors.push_back(block + 1);
+      for (std::size_t index{ basic_block.last_instruction + 1 };
+           index-- > basic_block.first_instruction;) {
+        auto const &data_flow{ data_flows[index] };
+        for (auto const node: data_flow.definitions) {
+          std::erase(basic_block.uses, node);
+          basic_block.definitions.push_back(node);
+        }
+        basic_block.uses.insert(
+          basic_block.uses.end(),
+          data_flow.uses.begin(),
+          data_flow.uses.end()
+        );
+      }
+      sortUnique(basic_block.uses);
+      sortUnique(basic_block.definitions);
+    }
+  }
+
+  void RegisterAllocator::computeLiveness()
+  {
+    std::vector<std::uint32_t> live_out{};
+    std::vector<std::uint32_t> live_through{};
+    std::vector<std::uint32_t> live_in{};
+    for (bool changed{ true }; changed;) {
+      changed = false;
+      for (std::size_t block{ basic_blocks.size() }; block-- > 0;) {
+        auto &basic_block{ basic_blocks[block] };
+        live_out.clear();
+        for (auto const successor: basic_block.successors) {
+          auto const &successor_live_in{ basic_blocks[successor].live_in };
+          live_in.clear();
+          std::ranges::set_union(
+            live_out,
+            successor_live_in,
+            std::back_inserter(live_in)
+          );
+          std::swap(live_out, live_in);
+        }
+        live_through.clear();
+        std::ranges::set_difference(
+          live_out,
+          basic_block.definitions,
+          std::back_inserter(live_through)
+        );
+        live_in.clear();
+        std::ranges::set_union(
+          basic_block.uses,
+          live_through,
+          std::back_inserter(live_in)
+        );
+        if (live_in != basic_block.live_in) {
+          basic_block.live_in = live_in;
+          changed             = true;
+        }
+        basic_block.live_out = live_out;
+      }
+    }
+  }
+
+  void
+  RegisterAllocator::addInterference(std::uint32_t first, std::uint32_t second)
+  {
+    if (first == second || (isHardRegister(first) && isHardRegister(second)))
+      return;
+    interferences[first].insert(second);
+    interferences[second].insert(first);
+  }
+
+  // A definition interferes with everything live after it and with the other
+  // operands of its instruction, except with the source of a move, which may
+  // share its register.
+  void RegisterAllocator::buildInterferenceGraph()
+  {
+    SparseSet live{ node_count };
+    for (auto const &basic_block: basic_blocks) {
+      live.clear();
+      for (auto const node: basic_block.live_out) live.insert(node);
+      for (std::size_t index{ basic_block.last_instruction + 1 };
+           index-- > basic_block.first_instruction;) {
+        auto const &data_flow{ data_flows[index] };
+        for (auto const definition: data_flow.definitions) {
+          ++occurrences[definition];
+          for (auto const node: live.getNodes())
+            if (node != data_flow.move_source) addInterference(definition, node);
+          for (auto const node: data_flow.uses)
+            if (node != data_flow.move_source) addInterference(definition, node);
+        }
+        if (data_flow.move_source && data_flow.definitions.size() == 1)
+          moves.push_back({ *data_flow.move_source,
+                            data_flow.definitions.front() });
+        for (auto const definition: data_flow.definitions)
+          live.erase(definition);
+        for (auto const node: data_flow.uses) {
+          ++occurrences[node];
+          live.insert(node);
+        }
+      }
+    }
+  }
+
+  // Briggs's test when both nodes are pseudo-registers, and George's test
+  // when the kept node is a hard register: a precoloured node's degree is
+  // effectively unbounded, so Briggs's test could never pass for it.
+  [[nodiscard]] bool
+  RegisterAllocator::canCoalesce(std::uint32_t kept, std::uint32_t merged) const
+  {
+    auto const is_significant{ [this](std::uint32_t node) {
+      return isHardRegister(node)
+          || interferences[node].size() >= hard_register_count;
+    } };
+    if (isHardRegister(kept))
+      return std::ranges::all_of(
+        interferences[merged],
+        [this, kept, &is_significant](std::uint32_t neighbour) {
+          return !is_significant(neighbour) || isHardRegister(neighbour)
+              || interferences[neighbour].contains(kept);
+        }
+      );
+    std::unordered_set<std::uint32_t> neighbours{
+      interferences[kept].begin(),
+      interferences[kept].end()
+    };
+    neighbours.insert(
+      interferences[merged].begin(),
+      interferences[merged].end()
+    );
+    return std::ranges::count_if(neighbours, is_significant)
+         < hard_register_count;
+  }
+
+  void RegisterAllocator::coalesce()
+  {
+    for (bool changed{ true }; changed;) {
+      changed = false;
+      for (auto const &[source, destination]: moves) {
+        std::uint32_t kept{ getAlias(source) };
+        std::uint32_t merged{ getAlias(destination) };
+        if (isHardRegister(merged)) std::swap(kept, merged);
+        if (kept == merged || isHardRegister(merged)
+            || interferences[kept].contains(merged)
+            || !canCoalesce(kept, merged))
+          continue;
+        for (auto const neighbour: interferences[merged]) {
+          interferences[neighbour].erase(merged);
+          addInterference(kept, neighbour);
+        }
+        interferences[merged].clear();
+        occurrences[kept] += occurrences[merged];
+        aliases[merged]    = kept;
+        changed            = true;
+      }
+    }
+  }
+
+  [[nodiscard]] RegisterAssignment RegisterAllocator::colour()
+  {
+    std::vector<std::uint32_t> degrees(node_count);
+    std::vector<bool>          removed(node_count, true);
+    std::vector<std::uint32_t> low_degree{};
+    std::vector<std::uint32_t> remaining{};
+    for (std::uint32_t node{ hard_register_count }; node < node_count; ++node) {
+      if (getAlias(node) != node || occurrences[node] == 0) continue;
+      degrees[node] = static_cast<std::uint32_t>(interferences[node].size());
+      removed[node] = false;
+      remaining.push_back(node);
+      if (degrees[node] < hard_register_count) low_degree.push_back(node);
+    }
+
+    std::vector<std::uint32_t> stack{};
+    auto const                 remove{ [&](std::uint32_t node) {
+      removed[node] = true;
+      stack.push_back(node);
+      for (auto const neighbour: interferences[node])
+        if (!isHardRegister(neighbour) && !removed[neighbour]
+            && degrees[neighbour]-- == hard_register_count)
+          low_degree.push_back(neighbour);
+    } };
+    while (stack.size() < remaining.size()) {
+      if (!low_degree.empty()) {
+        std::uint32_t const node{ low_degree.back() };
+        low_degree.pop_back();
+        if (!removed[node]) remove(node);
+        continue;
+      }
+      // Optimistically push the cheapest node to spill; it may still find a
+      // colour when it is popped.
+      std::optional<std::uint32_t> spill_candidate{};
+      double spill_cost{ std::numeric_limits<double>::infinity() };
+      for (auto const node: remaining) {
+        if (removed[node]) continue;
+        double const cost{ static_cast<double>(occurrences[node])
+                           / std::max(degrees[node], std::uint32_t{ 1 }) };
+        if (cost < spill_cost) {
+          spill_candidate = node;
+          spill_cost      = cost;
+        }
+      }
+      remove(*spill_candidate);
+    }
+
+    std::vector<std::optional<HardRegister>> colours(node_count);
+    for (std::uint32_t node{}; node < hard_register_count; ++node)
+      colours[node] = static_cast<HardRegister>(node);
+    while (!stack.empty()) {
+      std::uint32_t const node{ stack.back() };
+      stack.pop_back();
+      std::vector<bool> taken(hard_register_count);
+      for (auto const neighbour: interferences[node])
+        if (colours[neighbour])
+          taken[std::to_underlying(*colours[neighbour])] = true;
+      for (std::uint32_t colour{}; colour < hard_register_count; ++colour)
+        if (!taken[colour]) {
+          colours[node] = static_cast<HardRegister>(colour);
+          break;
+        }
+    }
+
+    RegisterAssignment assignment(node_count - hard_register_count);
+    for (std::uint32_t node{ hard_register_count }; node < node_count; ++node)
+      assignment[node - hard_register_count] = colours[getAlias(node)];
+    return assignment;
+  }
+
+  [[nodiscard]] RegisterAssignment RegisterAllocator::allocate()
+  {
+    if (data_flows.empty()) return {};
+    buildBasicBlocks();
+    computeLiveness();
+    buildInterferenceGraph();
+    coalesce();
+    return colour();
+  }
+} // namespace SC2
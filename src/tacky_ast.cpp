@@ -10,24 +10,24 @@ namespace SC2 {
   [[nodiscard]] std::shared_ptr<OperandAssemblyASTNode>
   LiteralConstantTACKYASTNode::emitAssembly() const
   {
-    return std::make_shared<ImmediateValueAssemblyASTNode>(getValue());
+    return makeNode<ImmediateValueAssemblyASTNode>(getValue());
   }
 
   [[nodiscard]] std::shared_ptr<OperandAssemblyASTNode>
   VariableTACKYASTNode::emitAssembly() const
   {
-    return std::make_shared<PseudoRegisterAssemblyASTNode>(getIdentifier());
+    return makeNode<PseudoRegisterAssemblyASTNode>(getVirtualRegister());
   }
 
   [[nodiscard]] std::vector<std::shared_ptr<InstructionAssemblyASTNode>>
   ReturnTACKYASTNode::emitAssembly() const
   {
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<MovlAssemblyASTNode>(
+      makeNode<MovlAssemblyASTNode>(
         getValue()->emitAssembly(),
-        std::make_shared<EAXRegisterAssemblyASTNode>()
+        makeNode<EAXRegisterAssemblyASTNode>()
       ),
-      std::make_shared<ReturnAssemblyASTNode>()
+      makeNode<ReturnAssemblyASTNode>()
     };
   }
 
@@ -40,14 +40,11 @@ namespace SC2 {
     auto const &[source, destination]{ std::move(input) };
     auto const &destination_assembly{ destination->emitAssembly() };
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<MovlAssemblyASTNode>(
+      makeNode<MovlAssemblyASTNode>(
         source->emitAssembly(),
         destination_assembly
       ),
-      std::make_shared<UnaryAssemblyASTNode>(
-        unary_operator,
-        destination_assembly
-      )
+      makeNode<UnaryAssemblyASTNode>(unary_operator, destination_assembly)
     };
   }
 
@@ -57,7 +54,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForUnaryOperatorTACKYASTNode(
-      std::make_shared<ComplementAssemblyASTNode>(),
+      makeNode<ComplementAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -68,7 +65,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForUnaryOperatorTACKYASTNode(
-      std::make_shared<NegateAssemblyASTNode>(),
+      makeNode<NegateAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -81,16 +78,16 @@ namespace SC2 {
     auto const &[source, destination]{ std::move(input) };
     auto const &destination_assembly{ destination->emitAssembly() };
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<CmpAssemblyASTNode>(
-        std::make_shared<ImmediateValueAssemblyASTNode>(0),
+      makeNode<CmpAssemblyASTNode>(
+        makeNode<ImmediateValueAssemblyASTNode>(0),
         source->emitAssembly()
       ),
-      std::make_shared<MovlAssemblyASTNode>(
-        std::make_shared<ImmediateValueAssemblyASTNode>(0),
+      makeNode<MovlAssemblyASTNode>(
+        makeNode<ImmediateValueAssemblyASTNode>(0),
         destination_assembly
       ),
-      std::make_shared<SetCCAssemblyASTNode>(
-        std::make_shared<ECondCodeAssemblyASTNode>(),
+      makeNode<SetCCAssemblyASTNode>(
+        makeNode<ECondCodeAssemblyASTNode>(),
         destination_assembly
       )
     };
@@ -113,11 +110,11 @@ namespace SC2 {
       destination->emitAssembly()
     };
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<MovlAssemblyASTNode>(
+      makeNode<MovlAssemblyASTNode>(
         left_operand->emitAssembly(),
         destination_assembly
       ),
-      std::make_shared<BinaryAssemblyASTNode>(
+      makeNode<BinaryAssemblyASTNode>(
         binary_operator,
         right_operand->emitAssembly(),
         destination_assembly
@@ -131,7 +128,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForBinaryOperatorTACKYASTNode(
-      std::make_shared<AddAssemblyASTNode>(),
+      makeNode<AddAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -142,7 +139,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForBinaryOperatorTACKYASTNode(
-      std::make_shared<SubtractAssemblyASTNode>(),
+      makeNode<SubtractAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -153,7 +150,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForBinaryOperatorTACKYASTNode(
-      std::make_shared<MultiplyAssemblyASTNode>(),
+      makeNode<MultiplyAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -165,14 +162,14 @@ namespace SC2 {
   {
     auto const &[left_operand, right_operand, destination]{ std::move(input) };
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<MovlAssemblyASTNode>(
+      makeNode<MovlAssemblyASTNode>(
         left_operand->emitAssembly(),
-        std::make_shared<EAXRegisterAssemblyASTNode>()
+        makeNode<EAXRegisterAssemblyASTNode>()
       ),
-      std::make_shared<CdqAssemblyASTNode>(),
-      std::make_shared<IdivAssemblyASTNode>(right_operand->emitAssembly()),
-      std::make_shared<MovlAssemblyASTNode>(
-        std::make_shared<EAXRegisterAssemblyASTNode>(),
+      makeNode<CdqAssemblyASTNode>(),
+      makeNode<IdivAssemblyASTNode>(right_operand->emitAssembly()),
+      makeNode<MovlAssemblyASTNode>(
+        makeNode<EAXRegisterAssemblyASTNode>(),
         destination->emitAssembly()
       )
     };
@@ -185,14 +182,14 @@ namespace SC2 {
   {
     auto const &[left_operand, right_operand, destination]{ std::move(input) };
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<MovlAssemblyASTNode>(
+      makeNode<MovlAssemblyASTNode>(
         left_operand->emitAssembly(),
-        std::make_shared<EAXRegisterAssemblyASTNode>()
+        makeNode<EAXRegisterAssemblyASTNode>()
       ),
-      std::make_shared<CdqAssemblyASTNode>(),
-      std::make_shared<IdivAssemblyASTNode>(right_operand->emitAssembly()),
-      std::make_shared<MovlAssemblyASTNode>(
-        std::make_shared<EDXRegisterAssemblyASTNode>(),
+      makeNode<CdqAssemblyASTNode>(),
+      makeNode<IdivAssemblyASTNode>(right_operand->emitAssembly()),
+      makeNode<MovlAssemblyASTNode>(
+        makeNode<EDXRegisterAssemblyASTNode>(),
         destination->emitAssembly()
       )
     };
@@ -204,7 +201,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForBinaryOperatorTACKYASTNode(
-      std::make_shared<BitwiseAndAssemblyASTNode>(),
+      makeNode<BitwiseAndAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -215,7 +212,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForBinaryOperatorTACKYASTNode(
-      std::make_shared<BitwiseOrAssemblyASTNode>(),
+      makeNode<BitwiseOrAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -226,7 +223,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForBinaryOperatorTACKYASTNode(
-      std::make_shared<BitwiseXorAssemblyASTNode>(),
+      makeNode<BitwiseXorAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -237,7 +234,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForBinaryOperatorTACKYASTNode(
-      std::make_shared<LeftShiftAssemblyASTNode>(),
+      makeNode<LeftShiftAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -248,7 +245,7 @@ namespace SC2 {
   ) const
   {
     return emitDefaultAssemblyForBinaryOperatorTACKYASTNode(
-      std::make_shared<RightShiftAssemblyASTNode>(),
+      makeNode<RightShiftAssemblyASTNode>(),
       std::move(input)
     );
   }
@@ -261,55 +258,52 @@ namespace SC2 {
     auto const &[left_operand, right_operand, destination]{ std::move(input) };
     auto const &destination_assembly{ destination->emitAssembly() };
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<CmpAssemblyASTNode>(
+      makeNode<CmpAssemblyASTNode>(
         right_operand->emitAssembly(),
         left_operand->emitAssembly()
       ),
-      std::make_shared<MovlAssemblyASTNode>(
-        std::make_shared<ImmediateValueAssemblyASTNode>(0),
+      makeNode<MovlAssemblyASTNode>(
+        makeNode<ImmediateValueAssemblyASTNode>(0),
         destination_assembly
       ),
-      std::make_shared<SetCCAssemblyASTNode>(
-        emitConditionCode(),
-        destination_assembly
-      )
+      makeNode<SetCCAssemblyASTNode>(emitConditionCode(), destination_assembly)
     };
   }
 
   [[nodiscard]] std::shared_ptr<CondCodeAssemblyASTNode>
   EqualsTACKYASTNode::emitConditionCode() const
   {
-    return std::make_shared<ECondCodeAssemblyASTNode>();
+    return makeNode<ECondCodeAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<CondCodeAssemblyASTNode>
   NotEqualsTACKYASTNode::emitConditionCode() const
   {
-    return std::make_shared<NECondCodeAssemblyASTNode>();
+    return makeNode<NECondCodeAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<CondCodeAssemblyASTNode>
   LessThanTACKYASTNode::emitConditionCode() const
   {
-    return std::make_shared<LCondCodeAssemblyASTNode>();
+    return makeNode<LCondCodeAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<CondCodeAssemblyASTNode>
   GreaterThanTACKYASTNode::emitConditionCode() const
   {
-    return std::make_shared<GCondCodeAssemblyASTNode>();
+    return makeNode<GCondCodeAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<CondCodeAssemblyASTNode>
   LessThanOrEqualToTACKYASTNode::emitConditionCode() const
   {
-    return std::make_shared<LECondCodeAssemblyASTNode>();
+    return makeNode<LECondCodeAssemblyASTNode>();
   }
 
   [[nodiscard]] std::shared_ptr<CondCodeAssemblyASTNode>
   GreaterThanOrEqualToTACKYASTNode::emitConditionCode() const
   {
-    return std::make_shared<GECondCodeAssemblyASTNode>();
+    return makeNode<GECondCodeAssemblyASTNode>();
   }
 
   [[nodiscard]] std::vector<std::shared_ptr<InstructionAssemblyASTNode>>
@@ -324,7 +318,7 @@ namespace SC2 {
   CopyTACKYASTNode::emitAssembly() const
   {
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<MovlAssemblyASTNode>(
+      makeNode<MovlAssemblyASTNode>(
         getSource()->emitAssembly(),
         getDestination()->emitAssembly()
       )
@@ -335,7 +329,7 @@ namespace SC2 {
   JumpTACKYASTNode::emitAssembly() const
   {
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<JmpAssemblyASTNode>(getIdentifier())
+      makeNode<JmpAssemblyASTNode>(getIdentifier())
     };
   }
 
@@ -343,12 +337,12 @@ namespace SC2 {
   JumpIfZeroTACKYASTNode::emitAssembly() const
   {
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<CmpAssemblyASTNode>(
-        std::make_shared<ImmediateValueAssemblyASTNode>(0),
+      makeNode<CmpAssemblyASTNode>(
+        makeNode<ImmediateValueAssemblyASTNode>(0),
         getCondition()->emitAssembly()
       ),
-      std::make_shared<JmpCCAssemblyASTNode>(
-        std::make_shared<ECondCodeAssemblyASTNode>(),
+      makeNode<JmpCCAssemblyASTNode>(
+        makeNode<ECondCodeAssemblyASTNode>(),
         getIdentifier()
       )
     };
@@ -358,12 +352,12 @@ namespace SC2 {
   JumpIfNotZeroTACKYASTNode::emitAssembly() const
   {
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<CmpAssemblyASTNode>(
-        std::make_shared<ImmediateValueAssemblyASTNode>(0),
+      makeNode<CmpAssemblyASTNode>(
+        makeNode<ImmediateValueAssemblyASTNode>(0),
         getCondition()->emitAssembly()
       ),
-      std::make_shared<JmpCCAssemblyASTNode>(
-        std::make_shared<NECondCodeAssemblyASTNode>(),
+      makeNode<JmpCCAssemblyASTNode>(
+        makeNode<NECondCodeAssemblyASTNode>(),
         getIdentifier()
       )
     };
@@ -373,14 +367,14 @@ namespace SC2 {
   LabelTACKYASTNode::emitAssembly() const
   {
     return std::vector<std::shared_ptr<InstructionAssemblyASTNode>>{
-      std::make_shared<LabelAssemblyASTNode>(getIdentifier())
+      makeNode<LabelAssemblyASTNode>(getIdentifier())
     };
   }
 
   [[nodiscard]] std::shared_ptr<FunctionAssemblyASTNode>
   FunctionTACKYASTNode::emitAssembly() const
   {
-    return std::make_shared<FunctionAssemblyASTNode>(
+    return makeNode<FunctionAssemblyASTNode>(
       getIdentifier(),
       getInstructions() | std::views::transform([](auto const instruction) {
       return instruction->emitAssembly();
@@ -392,7 +386,9 @@ namespace SC2 {
   [[nodiscard]] std::shared_ptr<ProgramAssemblyASTNode>
   ProgramTACKYASTNode::emitAssembly() const
   {
-    return std::make_shared<ProgramAssemblyASTNode>(getFunction()->emitAssembly(
-    ));
+    return makeNode<ProgramAssemblyASTNode>(
+      getFunction()->emitAssembly(),
+      string_interner
+    );
   }
 } // namespace SC2
@@ -0,0 +1,79 @@
+#include <sc2/thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace SC2 {
+  namespace {
+    class TaskQueue
+    {
+      std::mutex              mutex{};
+      std::deque<std::size_t> tasks{};
+
+      public:
+      void push(std::size_t const task)
+      {
+        std::scoped_lock const lock{ mutex };
+        tasks.push_back(task);
+      }
+
+      [[nodiscard]] std::optional<std::size_t> popFront()
+      {
+        std::scoped_lock const lock{ mutex };
+        if (tasks.empty()) return std::nullopt;
+        std::size_t const task{ tasks.front() };
+        tasks.pop_front();
+        return task;
+      }
+
+      [[nodiscard]] std::optional<std::size_t> popBack()
+      {
+        std::scoped_lock const lock{ mutex };
+        if (tasks.empty()) return std::nullopt;
+        std::size_t const task{ tasks.back() };
+        tasks.pop_back();
+        return task;
+      }
+    };
+  } // namespace
+
+  void runOnThreadPool(
+    std::size_t const                       task_count,
+    std::function<void(std::size_t)> const &task,
+    std::size_t                             thread_count
+  )
+  {
+    thread_count = std::min(thread_count, task_count);
+    if (thread_count <= 1) {
+      for (std::size_t index{}; index < task_count; ++index) task(index);
+      return;
+    }
+    // No task is ever added once the threads start, so a thread whose own
+    // queue and every other queue are empty can finish.
+    std::vector<std::unique_ptr<TaskQueue>> queues(thread_count);
+    for (auto &queue: queues) queue = std::make_unique<TaskQueue>();
+    for (std::size_t index{}; index < task_count; ++index)
+      queues[index % thread_count]->push(index);
+    auto const work{ [&queues, &task, thread_count](std::size_t const thread) {
+      while (true) {
+        std::optional<std::size_t> next{ queues[thread]->popFront() };
+        for (std::size_t offset{ 1 }; !next && offset < thread_count; ++offset)
+          next = queues[(thread + offset) % thread_count]->popBack();
+        if (!next) return;
+        task(*next);
+      }
+    } };
+    std::vector<std::jthread> threads{};
+    threads.reserve(thread_count - 1);
+    for (std::size_t thread{ 1 }; thread < thread_count; ++thread)
+      threads.emplace_back(work, thread);
+    work(0);
+  }
+} // namespace SC2
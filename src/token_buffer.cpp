@@ -0,0 +1,27 @@
+#include <sc2/lexer.hpp>
+#include <sc2/token_buffer.hpp>
+#include <string_view>
+
+#include <memory>
+#include <utility>
+
+namespace SC2 {
+  TokenBuffer::TokenBuffer(
+    std::string_view const          program_text,
+    std::shared_ptr<StringInterner> string_interner
+  )
+    : string_interner{ std::move(string_interner) }
+  {
+    if (auto const lexed{
+          Lexer::tokenize(program_text, *this->string_interner, tokens) };
+        !lexed)
+      invalid_token_error.emplace(lexed.error());
+  }
+
+  TokenBuffer::TokenBuffer(Lexer &lexer)
+    : string_interner{ lexer.getStringInterner() }
+  {
+    if (auto const lexed{ lexer.tokenizeRemaining(tokens) }; !lexed)
+      invalid_token_error.emplace(lexed.error());
+  }
+} // namespace SC2
@@ -1,10 +1,13 @@
 #include <catch2/catch_test_macros.hpp>
 #include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
 #include <sc2/ast.hpp>
 #include <sc2/lexer.hpp>
 #include <sc2/parser.hpp>
 #include <sc2/tacky_ast.hpp>
+#include <sc2/utility.hpp>
 
+#include <format>
 #include <memory>
 
 TEST_CASE("assembly generator works correctly")
@@ -31,10 +34,11 @@ TEST_CASE("assembly generator works correctly")
       "    Unary (Negate (PseudoRegister: main.1))\n"
       "    Movl (PseudoRegister: main.1), (Register: %eax)\n"
       "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
     );
-    auto [last_offset, _, cleaned_assembly]{ assembly->replacePseudoRegisters(
-    ) };
-    REQUIRE(cleaned_assembly->prettyPrint() ==
+    auto const last_offset{ assembly->replacePseudoRegisters() };
+    REQUIRE(assembly->prettyPrint() ==
       "Program:\n"
       "  Function: main\n"
       "    Movl (ImmediateValue: 2), (StackOffset: -4)\n"
@@ -43,9 +47,11 @@ TEST_CASE("assembly generator works correctly")
       "    Unary (Negate (StackOffset: -8))\n"
       "    Movl (StackOffset: -8), (Register: %eax)\n"
       "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
     );
-    auto fixed_assembly{ cleaned_assembly->fixUp(-last_offset) };
-    REQUIRE(fixed_assembly->prettyPrint() ==
+    assembly->fixUp(-last_offset);
+    REQUIRE(assembly->prettyPrint() ==
       "Program:\n"
       "  Function: main\n"
       "    AllocateStack(8)\n"
@@ -56,6 +62,8 @@ TEST_CASE("assembly generator works correctly")
       "    Unary (Negate (StackOffset: -8))\n"
       "    Movl (StackOffset: -8), (Register: %eax)\n"
       "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
     );
   }
   SECTION("Chapter 3: a program with binary operators is assembled correctly")
@@ -74,26 +82,27 @@ TEST_CASE("assembly generator works correctly")
     REQUIRE(assembly->prettyPrint() ==
       "Program:\n"
       "  Function: main\n"
-      "    Movl (ImmediateValue: 2), (PseudoRegister: main.2)\n"
-      "    Binary (Multiply (ImmediateValue: 10), (PseudoRegister: main.2))\n"
-      "    Movl (PseudoRegister: main.2), (Register: %eax)\n"
+      "    Movl (ImmediateValue: 2), (PseudoRegister: main.0)\n"
+      "    Binary (Multiply (ImmediateValue: 10), (PseudoRegister: main.0))\n"
+      "    Movl (PseudoRegister: main.0), (Register: %eax)\n"
       "    Cdq\n"
       "    Idiv (ImmediateValue: 7)\n"
-      "    Movl (Register: %edx), (PseudoRegister: main.3)\n"
+      "    Movl (Register: %edx), (PseudoRegister: main.1)\n"
       "    Movl (ImmediateValue: 5), (Register: %eax)\n"
       "    Cdq\n"
       "    Idiv (ImmediateValue: 2)\n"
-      "    Movl (Register: %eax), (PseudoRegister: main.4)\n"
-      "    Movl (PseudoRegister: main.4), (PseudoRegister: main.5)\n"
-      "    Binary (RightShift (ImmediateValue: 3), (PseudoRegister: main.5))\n"
-      "    Movl (PseudoRegister: main.3), (PseudoRegister: main.6)\n"
-      "    Binary (BitwiseAnd (PseudoRegister: main.5), (PseudoRegister: main.6))\n"
-      "    Movl (PseudoRegister: main.6), (Register: %eax)\n"
+      "    Movl (Register: %eax), (PseudoRegister: main.2)\n"
+      "    Movl (PseudoRegister: main.2), (PseudoRegister: main.3)\n"
+      "    Binary (RightShift (ImmediateValue: 3), (PseudoRegister: main.3))\n"
+      "    Movl (PseudoRegister: main.1), (PseudoRegister: main.4)\n"
+      "    Binary (BitwiseAnd (PseudoRegister: main.3), (PseudoRegister: main.4))\n"
+      "    Movl (PseudoRegister: main.4), (Register: %eax)\n"
+      "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
       "    Ret\n"
     );
-    auto [last_offset, _, cleaned_assembly]{ assembly->replacePseudoRegisters(
-    ) };
-    REQUIRE(cleaned_assembly->prettyPrint() ==
+    auto const last_offset{ assembly->replacePseudoRegisters() };
+    REQUIRE(assembly->prettyPrint() ==
       "Program:\n"
       "  Function: main\n"
       "    Movl (ImmediateValue: 2), (StackOffset: -4)\n"
@@ -112,9 +121,11 @@ TEST_CASE("assembly generator works correctly")
       "    Binary (BitwiseAnd (StackOffset: -16), (StackOffset: -20))\n"
       "    Movl (StackOffset: -20), (Register: %eax)\n"
       "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
     );
-    auto fixed_assembly{ cleaned_assembly->fixUp(-last_offset) };
-    REQUIRE(fixed_assembly->prettyPrint() ==
+    assembly->fixUp(-last_offset);
+    REQUIRE(assembly->prettyPrint() ==
       "Program:\n"
       "  Function: main\n"
       "    AllocateStack(20)\n"
@@ -143,6 +154,8 @@ TEST_CASE("assembly generator works correctly")
       "    Binary (BitwiseAnd (Register: %r10d), (StackOffset: -20))\n"
       "    Movl (StackOffset: -20), (Register: %eax)\n"
       "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
     );
   }
   SECTION(
@@ -165,50 +178,51 @@ TEST_CASE("assembly generator works correctly")
       "Program:\n"
       "  Function: main\n"
       "    Cmp (ImmediateValue: 2), (ImmediateValue: 1)\n"
-      "    Movl (ImmediateValue: 0), (PseudoRegister: main.7)\n"
-      "    SetCC L, (PseudoRegister: main.7)\n"
+      "    Movl (ImmediateValue: 0), (PseudoRegister: main.0)\n"
+      "    SetCC L, (PseudoRegister: main.0)\n"
       "    Cmp (ImmediateValue: 4), (ImmediateValue: 3)\n"
-      "    Movl (ImmediateValue: 0), (PseudoRegister: main.8)\n"
-      "    SetCC G, (PseudoRegister: main.8)\n"
-      "    Cmp (PseudoRegister: main.8), (PseudoRegister: main.7)\n"
-      "    Movl (ImmediateValue: 0), (PseudoRegister: main.9)\n"
-      "    SetCC NE, (PseudoRegister: main.9)\n"
-      "    Cmp (ImmediateValue: 0), (PseudoRegister: main.9)\n"
-      "    JmpCC E, main.10_false_label\n"
+      "    Movl (ImmediateValue: 0), (PseudoRegister: main.1)\n"
+      "    SetCC G, (PseudoRegister: main.1)\n"
+      "    Cmp (PseudoRegister: main.1), (PseudoRegister: main.0)\n"
+      "    Movl (ImmediateValue: 0), (PseudoRegister: main.2)\n"
+      "    SetCC NE, (PseudoRegister: main.2)\n"
+      "    Cmp (ImmediateValue: 0), (PseudoRegister: main.2)\n"
+      "    JmpCC E, main.0_false_label\n"
       "    Cmp (ImmediateValue: 6), (ImmediateValue: 5)\n"
-      "    Movl (ImmediateValue: 0), (PseudoRegister: main.11)\n"
-      "    SetCC LE, (PseudoRegister: main.11)\n"
+      "    Movl (ImmediateValue: 0), (PseudoRegister: main.3)\n"
+      "    SetCC LE, (PseudoRegister: main.3)\n"
       "    Cmp (ImmediateValue: 8), (ImmediateValue: 7)\n"
-      "    Movl (ImmediateValue: 0), (PseudoRegister: main.12)\n"
-      "    SetCC GE, (PseudoRegister: main.12)\n"
-      "    Cmp (PseudoRegister: main.12), (PseudoRegister: main.11)\n"
-      "    Movl (ImmediateValue: 0), (PseudoRegister: main.13)\n"
-      "    SetCC E, (PseudoRegister: main.13)\n"
-      "    Cmp (ImmediateValue: 0), (PseudoRegister: main.13)\n"
-      "    JmpCC E, main.10_false_label\n"
-      "    Movl (ImmediateValue: 1), (PseudoRegister: main.14)\n"
-      "    Jmp main.15\n"
-      "    Label main.10_false_label\n"
-      "    Movl (ImmediateValue: 0), (PseudoRegister: main.14)\n"
-      "    Label main.15\n"
-      "    Cmp (ImmediateValue: 0), (PseudoRegister: main.14)\n"
-      "    JmpCC NE, main.16_false_label\n"
+      "    Movl (ImmediateValue: 0), (PseudoRegister: main.4)\n"
+      "    SetCC GE, (PseudoRegister: main.4)\n"
+      "    Cmp (PseudoRegister: main.4), (PseudoRegister: main.3)\n"
+      "    Movl (ImmediateValue: 0), (PseudoRegister: main.5)\n"
+      "    SetCC E, (PseudoRegister: main.5)\n"
+      "    Cmp (ImmediateValue: 0), (PseudoRegister: main.5)\n"
+      "    JmpCC E, main.0_false_label\n"
+      "    Movl (ImmediateValue: 1), (PseudoRegister: main.6)\n"
+      "    Jmp main.1\n"
+      "    Label main.0_false_label\n"
+      "    Movl (ImmediateValue: 0), (PseudoRegister: main.6)\n"
+      "    Label main.1\n"
+      "    Cmp (ImmediateValue: 0), (PseudoRegister: main.6)\n"
+      "    JmpCC NE, main.2_false_label\n"
       "    Cmp (ImmediateValue: 0), (ImmediateValue: 2)\n"
-      "    Movl (ImmediateValue: 0), (PseudoRegister: main.17)\n"
-      "    SetCC E, (PseudoRegister: main.17)\n"
-      "    Cmp (ImmediateValue: 0), (PseudoRegister: main.17)\n"
-      "    JmpCC NE, main.16_false_label\n"
-      "    Movl (ImmediateValue: 0), (PseudoRegister: main.18)\n"
-      "    Jmp main.19\n"
-      "    Label main.16_false_label\n"
-      "    Movl (ImmediateValue: 1), (PseudoRegister: main.18)\n"
-      "    Label main.19\n"
-      "    Movl (PseudoRegister: main.18), (Register: %eax)\n"
+      "    Movl (ImmediateValue: 0), (PseudoRegister: main.7)\n"
+      "    SetCC E, (PseudoRegister: main.7)\n"
+      "    Cmp (ImmediateValue: 0), (PseudoRegister: main.7)\n"
+      "    JmpCC NE, main.2_false_label\n"
+      "    Movl (ImmediateValue: 0), (PseudoRegister: main.8)\n"
+      "    Jmp main.3\n"
+      "    Label main.2_false_label\n"
+      "    Movl (ImmediateValue: 1), (PseudoRegister: main.8)\n"
+      "    Label main.3\n"
+      "    Movl (PseudoRegister: main.8), (Register: %eax)\n"
+      "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
       "    Ret\n"
     );
-    auto [last_offset, _, cleaned_assembly]{ assembly->replacePseudoRegisters(
-    ) };
-    REQUIRE(cleaned_assembly->prettyPrint() ==
+    auto const last_offset{ assembly->replacePseudoRegisters() };
+    REQUIRE(assembly->prettyPrint() ==
       "Program:\n"
       "  Function: main\n"
       "    Cmp (ImmediateValue: 2), (ImmediateValue: 1)\n"
@@ -221,7 +235,7 @@ TEST_CASE("assembly generator works correctly")
       "    Movl (ImmediateValue: 0), (StackOffset: -12)\n"
       "    SetCC NE, (StackOffset: -12)\n"
       "    Cmp (ImmediateValue: 0), (StackOffset: -12)\n"
-      "    JmpCC E, main.10_false_label\n"
+      "    JmpCC E, main.0_false_label\n"
       "    Cmp (ImmediateValue: 6), (ImmediateValue: 5)\n"
       "    Movl (ImmediateValue: 0), (StackOffset: -16)\n"
       "    SetCC LE, (StackOffset: -16)\n"
@@ -232,29 +246,31 @@ TEST_CASE("assembly generator works correctly")
       "    Movl (ImmediateValue: 0), (StackOffset: -24)\n"
       "    SetCC E, (StackOffset: -24)\n"
       "    Cmp (ImmediateValue: 0), (StackOffset: -24)\n"
-      "    JmpCC E, main.10_false_label\n"
+      "    JmpCC E, main.0_false_label\n"
       "    Movl (ImmediateValue: 1), (StackOffset: -28)\n"
-      "    Jmp main.15\n"
-      "    Label main.10_false_label\n"
+      "    Jmp main.1\n"
+      "    Label main.0_false_label\n"
       "    Movl (ImmediateValue: 0), (StackOffset: -28)\n"
-      "    Label main.15\n"
+      "    Label main.1\n"
       "    Cmp (ImmediateValue: 0), (StackOffset: -28)\n"
-      "    JmpCC NE, main.16_false_label\n"
+      "    JmpCC NE, main.2_false_label\n"
       "    Cmp (ImmediateValue: 0), (ImmediateValue: 2)\n"
       "    Movl (ImmediateValue: 0), (StackOffset: -32)\n"
       "    SetCC E, (StackOffset: -32)\n"
       "    Cmp (ImmediateValue: 0), (StackOffset: -32)\n"
-      "    JmpCC NE, main.16_false_label\n"
+      "    JmpCC NE, main.2_false_label\n"
       "    Movl (ImmediateValue: 0), (StackOffset: -36)\n"
-      "    Jmp main.19\n"
-      "    Label main.16_false_label\n"
+      "    Jmp main.3\n"
+      "    Label main.2_false_label\n"
       "    Movl (ImmediateValue: 1), (StackOffset: -36)\n"
-      "    Label main.19\n"
+      "    Label main.3\n"
       "    Movl (StackOffset: -36), (Register: %eax)\n"
       "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
     );
-    auto fixed_assembly{ cleaned_assembly->fixUp(-last_offset) };
-    REQUIRE(fixed_assembly->prettyPrint() ==
+    assembly->fixUp(-last_offset);
+    REQUIRE(assembly->prettyPrint() ==
       "Program:\n"
       "  Function: main\n"
       "    AllocateStack(36)\n"
@@ -271,7 +287,7 @@ TEST_CASE("assembly generator works correctly")
       "    Movl (ImmediateValue: 0), (StackOffset: -12)\n"
       "    SetCC NE, (StackOffset: -12)\n"
       "    Cmp (ImmediateValue: 0), (StackOffset: -12)\n"
-      "    JmpCC E, main.10_false_label\n"
+      "    JmpCC E, main.0_false_label\n"
       "    Movl (ImmediateValue: 5), (Register: %r11d)\n"
       "    Cmp (ImmediateValue: 6), (Register: %r11d)\n"
       "    Movl (ImmediateValue: 0), (StackOffset: -16)\n"
@@ -285,27 +301,206 @@ TEST_CASE("assembly generator works correctly")
       "    Movl (ImmediateValue: 0), (StackOffset: -24)\n"
       "    SetCC E, (StackOffset: -24)\n"
       "    Cmp (ImmediateValue: 0), (StackOffset: -24)\n"
-      "    JmpCC E, main.10_false_label\n"
+      "    JmpCC E, main.0_false_label\n"
       "    Movl (ImmediateValue: 1), (StackOffset: -28)\n"
-      "    Jmp main.15\n"
-      "    Label main.10_false_label\n"
+      "    Jmp main.1\n"
+      "    Label main.0_false_label\n"
       "    Movl (ImmediateValue: 0), (StackOffset: -28)\n"
-      "    Label main.15\n"
+      "    Label main.1\n"
       "    Cmp (ImmediateValue: 0), (StackOffset: -28)\n"
-      "    JmpCC NE, main.16_false_label\n"
+      "    JmpCC NE, main.2_false_label\n"
       "    Movl (ImmediateValue: 2), (Register: %r11d)\n"
       "    Cmp (ImmediateValue: 0), (Register: %r11d)\n"
       "    Movl (ImmediateValue: 0), (StackOffset: -32)\n"
       "    SetCC E, (StackOffset: -32)\n"
       "    Cmp (ImmediateValue: 0), (StackOffset: -32)\n"
-      "    JmpCC NE, main.16_false_label\n"
+      "    JmpCC NE, main.2_false_label\n"
       "    Movl (ImmediateValue: 0), (StackOffset: -36)\n"
-      "    Jmp main.19\n"
-      "    Label main.16_false_label\n"
+      "    Jmp main.3\n"
+      "    Label main.2_false_label\n"
       "    Movl (ImmediateValue: 1), (StackOffset: -36)\n"
-      "    Label main.19\n"
+      "    Label main.3\n"
       "    Movl (StackOffset: -36), (Register: %eax)\n"
       "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
+    );
+  }
+  SECTION("every use of a variable shares its function's stack slot")
+  {
+    constexpr char const * const program_text{
+      "int main(void) {\n"
+      "  int a = 2;\n"
+      "  int b = -a;\n"
+      "  return a + b;\n"
+      "}\n"
+    };
+    SC2::Lexer                                   lexer{ program_text };
+    SC2::Parser                                  parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode>         ast{ parser.parseProgram() };
+    std::shared_ptr<SC2::ProgramTACKYASTNode>    tacky{ ast->emitTACKY() };
+    std::shared_ptr<SC2::ProgramAssemblyASTNode> assembly{ tacky->emitAssembly(
+    ) };
+    auto const last_offset{ assembly->replacePseudoRegisters() };
+    REQUIRE(last_offset == -16);
+    REQUIRE(assembly->prettyPrint() ==
+      "Program:\n"
+      "  Function: main\n"
+      "    Movl (ImmediateValue: 2), (StackOffset: -4)\n"
+      "    Movl (StackOffset: -4), (StackOffset: -8)\n"
+      "    Unary (Negate (StackOffset: -8))\n"
+      "    Movl (StackOffset: -8), (StackOffset: -12)\n"
+      "    Movl (StackOffset: -4), (StackOffset: -16)\n"
+      "    Binary (Add (StackOffset: -12), (StackOffset: -16))\n"
+      "    Movl (StackOffset: -16), (Register: %eax)\n"
+      "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
+    );
+  }
+}
+
+TEST_CASE("register allocator works correctly")
+{
+  SECTION("coalesced moves are removed")
+  {
+    constexpr char const * const program_text{
+      "int main(void) {\n"
+      "  return -(~2);\n"
+      "}\n"
+    };
+    SC2::Lexer                                   lexer{ program_text };
+    SC2::Parser                                  parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode>         ast{ parser.parseProgram() };
+    std::shared_ptr<SC2::ProgramTACKYASTNode>    tacky{ ast->emitTACKY() };
+    std::shared_ptr<SC2::ProgramAssemblyASTNode> assembly{ tacky->emitAssembly(
+    ) };
+    REQUIRE(assembly->allocateRegisters()->prettyPrint() ==
+      "Program:\n"
+      "  Function: main\n"
+      "    Movl (ImmediateValue: 2), (Register: %eax)\n"
+      "    Unary (Complement (Register: %eax))\n"
+      "    Unary (Negate (Register: %eax))\n"
+      "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
+    );
+  }
+  SECTION("interfering variables get different registers")
+  {
+    constexpr char const * const program_text{
+      "int main(void) {\n"
+      "  int a = 2;\n"
+      "  int b = -a;\n"
+      "  return a + b;\n"
+      "}\n"
+    };
+    SC2::Lexer                                   lexer{ program_text };
+    SC2::Parser                                  parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode>         ast{ parser.parseProgram() };
+    std::shared_ptr<SC2::ProgramTACKYASTNode>    tacky{ ast->emitTACKY() };
+    std::shared_ptr<SC2::ProgramAssemblyASTNode> assembly{ tacky->emitAssembly(
+    ) };
+    REQUIRE(assembly->allocateRegisters()->prettyPrint() ==
+      "Program:\n"
+      "  Function: main\n"
+      "    Movl (ImmediateValue: 2), (Register: %eax)\n"
+      "    Movl (Register: %eax), (Register: %ecx)\n"
+      "    Unary (Negate (Register: %ecx))\n"
+      "    Binary (Add (Register: %ecx), (Register: %eax))\n"
+      "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
+    );
+  }
+  SECTION("variables that cannot be coloured are spilled to the stack")
+  {
+    constexpr char const * const program_text{
+      "int main(void) {\n"
+      "  int a = 1;\n"
+      "  int b = 2;\n"
+      "  int c = 3;\n"
+      "  int d = 4;\n"
+      "  int e = 5;\n"
+      "  int f = 6;\n"
+      "  int g = 7;\n"
+      "  int h = 8;\n"
+      "  return a + b + c + d + e + f + g + h;\n"
+      "}\n"
+    };
+    SC2::Lexer                                   lexer{ program_text };
+    SC2::Parser                                  parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode>         ast{ parser.parseProgram() };
+    std::shared_ptr<SC2::ProgramTACKYASTNode>    tacky{ ast->emitTACKY() };
+    std::shared_ptr<SC2::ProgramAssemblyASTNode> assembly{ tacky->emitAssembly(
+    ) };
+    auto const allocated_assembly{ assembly->allocateRegisters() };
+    auto const last_offset{ allocated_assembly->replacePseudoRegisters() };
+    REQUIRE(last_offset == -4);
+    REQUIRE(allocated_assembly->prettyPrint() ==
+      "Program:\n"
+      "  Function: main\n"
+      "    Movl (ImmediateValue: 1), (Register: %eax)\n"
+      "    Movl (ImmediateValue: 2), (StackOffset: -4)\n"
+      "    Movl (ImmediateValue: 3), (Register: %ecx)\n"
+      "    Movl (ImmediateValue: 4), (Register: %edx)\n"
+      "    Movl (ImmediateValue: 5), (Register: %esi)\n"
+      "    Movl (ImmediateValue: 6), (Register: %edi)\n"
+      "    Movl (ImmediateValue: 7), (Register: %r8d)\n"
+      "    Movl (ImmediateValue: 8), (Register: %r9d)\n"
+      "    Binary (Add (StackOffset: -4), (Register: %eax))\n"
+      "    Binary (Add (Register: %ecx), (Register: %eax))\n"
+      "    Binary (Add (Register: %edx), (Register: %eax))\n"
+      "    Binary (Add (Register: %esi), (Register: %eax))\n"
+      "    Binary (Add (Register: %edi), (Register: %eax))\n"
+      "    Binary (Add (Register: %r8d), (Register: %eax))\n"
+      "    Binary (Add (Register: %r9d), (Register: %eax))\n"
+      "    Ret\n"
+      "    Movl (ImmediateValue: 0), (Register: %eax)\n"
+      "    Ret\n"
     );
   }
 }
+
+TEST_CASE("assembly emitter works correctly")
+{
+  SECTION("a program is emitted into the assembly buffer")
+  {
+    constexpr char const * const program_text{
+      "int main(void) {\n"
+      "  return -(~2);\n"
+      "}\n"
+    };
+    SC2::Lexer                                   lexer{ program_text };
+    SC2::Parser                                  parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode>         ast{ parser.parseProgram() };
+    std::shared_ptr<SC2::ProgramTACKYASTNode>    tacky{ ast->emitTACKY() };
+    std::shared_ptr<SC2::ProgramAssemblyASTNode> assembly{ tacky->emitAssembly(
+    ) };
+    auto const last_offset{ assembly->replacePseudoRegisters() };
+    assembly->fixUp(-last_offset);
+    SC2::AssemblyBuffer assembly_buffer{};
+    assembly->emitCode(assembly_buffer);
+    REQUIRE(assembly_buffer.getText().starts_with(std::format(
+      "  .globl {0}\n"
+      "{0}:\n"
+      "  pushq %rbp\n"
+      "  movq %rsp, %rbp\n"
+      "subq $8, %rsp\n"
+      "  movl $2, -4(%rbp)\n"
+      "notl -4(%rbp)\n"
+      "  movl -4(%rbp), %r10d\n"
+      "  movl %r10d, -8(%rbp)\n"
+      "negl -8(%rbp)\n"
+      "  movl -8(%rbp), %eax\n"
+      "movq %rbp, %rsp\n"
+      "popq %rbp\n"
+      "ret\n"
+      "  movl $0, %eax\n"
+      "movq %rbp, %rsp\n"
+      "popq %rbp\n"
+      "ret\n",
+      SC2::Utility::specialiseFunctionNameForOS("main")
+    )));
+  }
+}
@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/batch.hpp>
+#include <sc2/test_fixtures.hpp>
+#include <sc2/thread_pool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("thread pool runs every task once")
+{
+  for (std::size_t const thread_count: { 1, 4, 64 }) {
+    std::vector<std::atomic<int>> run_counts(1000);
+    SC2::runOnThreadPool(
+      run_counts.size(),
+      [&run_counts](std::size_t const index) { ++run_counts[index]; },
+      thread_count
+    );
+    for (auto const &run_count: run_counts) REQUIRE(run_count == 1);
+  }
+}
+
+TEST_CASE("batch mode compiles many files in one process")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_batch_tests" };
+  std::filesystem::create_directories(directory);
+  std::vector<std::string> source_paths{};
+  for (std::size_t file{}; file < 16; ++file) {
+    auto const source_path{ directory / std::format("program{}.c", file) };
+    std::ofstream out{ source_path };
+    out << basic_program_text;
+    source_paths.push_back(source_path.string());
+  }
+
+  SECTION("each .s file is written next to its source")
+  {
+    REQUIRE(SC2::compileBatch(source_paths, 4).empty());
+    for (std::size_t file{}; file < 16; ++file)
+      REQUIRE(std::filesystem::exists(
+        directory / std::format("program{}.s", file)
+      ));
+  }
+
+  SECTION("output does not depend on what was compiled before")
+  {
+    auto const read{ [](std::filesystem::path const &path) {
+      std::ifstream      in{ path };
+      std::ostringstream text{};
+      text << in.rdbuf();
+      return text.str();
+    } };
+    REQUIRE(SC2::compileBatch(source_paths, 4).empty());
+    REQUIRE(
+      read(directory / "program0.s") == read(directory / "program15.s")
+    );
+  }
+
+  SECTION("failures are reported per file")
+  {
+    auto const bad_path{ directory / "bad.c" };
+    {
+      std::ofstream out{ bad_path };
+      out << "int main(void) { return; }\n";
+    }
+    source_paths.push_back(bad_path.string());
+    auto const failures{ SC2::compileBatch(source_paths, 4) };
+    REQUIRE(failures.size() == 1);
+    REQUIRE(failures.front().source_path == bad_path.string());
+  }
+
+  SECTION("response files list source paths")
+  {
+    auto const response_path{ directory / "sources.txt" };
+    {
+      std::ofstream out{ response_path };
+      out << source_paths[0] << '\n' << source_paths[1] << '\n';
+    }
+    REQUIRE(
+      SC2::expandResponseFiles(std::vector<std::string>{
+        "@" + response_path.string(),
+        source_paths[2] })
+      == std::vector<std::string>{ source_paths[0],
+                                   source_paths[1],
+                                   source_paths[2] }
+    );
+  }
+
+  std::filesystem::remove_all(directory);
+}
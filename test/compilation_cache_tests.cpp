@@ -0,0 +1,175 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/batch.hpp>
+#include <sc2/compilation_cache.hpp>
+#include <sc2/test_fixtures.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+  // Moves the entry's last use back in time.
+  void makeOlder(
+    std::filesystem::path const &directory,
+    std::string const           &key,
+    std::chrono::minutes const   age
+  )
+  {
+    auto const path{ directory / (key + ".s") };
+    std::filesystem::last_write_time(
+      path,
+      std::filesystem::last_write_time(path) - age
+    );
+  }
+} // namespace
+
+TEST_CASE("XXH64 matches the reference implementation")
+{
+  REQUIRE(SC2::hashXXH64("") == 0xEF46'DB37'51D8'E999ULL);
+  REQUIRE(SC2::hashXXH64("", 1) == 0xD5AF'BA13'36A3'BE4BULL);
+  REQUIRE(SC2::hashXXH64("a") == 0xD24E'C4F1'A98C'6E5BULL);
+  REQUIRE(SC2::hashXXH64("abc") == 0x44BC'2CF5'AD77'0999ULL);
+  REQUIRE(
+    SC2::hashXXH64("int main(void) { return 2; }") == 0x4E67'8D1C'003D'5EB6ULL
+  );
+  REQUIRE(
+    SC2::hashXXH64(
+      "The quick brown fox jumps over the lazy dog, forty-two times over",
+      1
+    )
+    == 0x391C'9953'8EF0'A5EBULL
+  );
+}
+
+TEST_CASE("compilation cache behaves correctly")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_compilation_cache_tests" };
+  std::filesystem::remove_all(directory);
+
+  SECTION("keys depend on the text, the compiler and the options")
+  {
+    SC2::CompilationCache cache{ directory, 1024, "sc2 1" };
+    SC2::CompilationCache other_compiler_cache{ directory, 1024, "sc2 2" };
+    auto const key{ cache.getKey(basic_program_text) };
+    REQUIRE(key.size() == 32);
+    REQUIRE(cache.getKey(basic_program_text) == key);
+    REQUIRE(cache.getKey("int main(void) { return 3; }") != key);
+    REQUIRE(cache.getKey(basic_program_text, "-O1") != key);
+    REQUIRE(other_compiler_cache.getKey(basic_program_text) != key);
+  }
+
+  SECTION("stored assembly is found again")
+  {
+    SC2::CompilationCache cache{ directory, 1024, "sc2" };
+    auto const            key{ cache.getKey(basic_program_text) };
+    REQUIRE(!cache.lookUp(key));
+    cache.store(key, "  ret\n");
+    REQUIRE(cache.lookUp(key) == "  ret\n");
+    REQUIRE(cache.getStatistics().hits == 1);
+    REQUIRE(cache.getStatistics().misses == 1);
+  }
+
+  SECTION("the least recently used entries are evicted")
+  {
+    SC2::CompilationCache cache{ directory, 250, "sc2" };
+    std::string const     assembly(100, 'x');
+    auto const            first_key{ cache.getKey("first") };
+    auto const            second_key{ cache.getKey("second") };
+    cache.store(first_key, assembly);
+    makeOlder(directory, first_key, std::chrono::minutes{ 60 });
+    cache.store(second_key, assembly);
+    makeOlder(directory, second_key, std::chrono::minutes{ 30 });
+    REQUIRE(cache.lookUp(first_key));
+    cache.store(cache.getKey("third"), assembly);
+    REQUIRE(cache.lookUp(first_key));
+    REQUIRE(!cache.lookUp(second_key));
+    REQUIRE(cache.getStatistics().evictions == 1);
+  }
+
+  SECTION("the directory is only scanned once the recorded size is exceeded")
+  {
+    SC2::CompilationCache cache{ directory, 250, "sc2" };
+    std::string const     assembly(100, 'x');
+    cache.store(cache.getKey("first"), assembly);
+    // An entry the recorded size does not know about stays until a store
+    // takes the recorded size past the maximum.
+    auto const unrecorded_path{ directory / "unrecorded.s" };
+    {
+      std::ofstream out{ unrecorded_path };
+      out << std::string(1000, 'x');
+    }
+    std::filesystem::last_write_time(
+      unrecorded_path,
+      std::filesystem::last_write_time(unrecorded_path)
+        - std::chrono::minutes{ 60 }
+    );
+    cache.store(cache.getKey("second"), assembly);
+    REQUIRE(std::filesystem::exists(unrecorded_path));
+    auto const third_key{ cache.getKey("third") };
+    cache.store(third_key, assembly);
+    // Both the unrecorded entry and the first one go to fit in 90% of the
+    // maximum size.
+    REQUIRE(!std::filesystem::exists(unrecorded_path));
+    REQUIRE(cache.getStatistics().evictions == 2);
+    REQUIRE(cache.lookUp(third_key));
+  }
+
+  SECTION("temporary files left by crashed writers are reaped")
+  {
+    std::filesystem::create_directories(directory);
+    auto const stale_path{ directory / "stale.s.1.2.tmp" };
+    auto const fresh_path{ directory / "fresh.s.1.2.tmp" };
+    for (auto const &path: { stale_path, fresh_path })
+      std::ofstream{ path } << "  ret\n";
+    std::filesystem::last_write_time(
+      stale_path,
+      std::filesystem::last_write_time(stale_path) - std::chrono::hours{ 2 }
+    );
+    SC2::CompilationCache cache{ directory, 1024, "sc2" };
+    cache.store(cache.getKey(basic_program_text), "  ret\n");
+    REQUIRE(!std::filesystem::exists(stale_path));
+    REQUIRE(std::filesystem::exists(fresh_path));
+  }
+
+  SECTION("statistics are kept across processes")
+  {
+    {
+      SC2::CompilationCache cache{ directory, 1024, "sc2" };
+      static_cast<void>(cache.lookUp(cache.getKey(basic_program_text)));
+      cache.saveStatistics();
+      REQUIRE(cache.getStatistics().misses == 0);
+    }
+    SC2::CompilationCache cache{ directory, 1024, "sc2" };
+    cache.store(cache.getKey(basic_program_text), "  ret\n");
+    static_cast<void>(cache.lookUp(cache.getKey(basic_program_text)));
+    cache.saveStatistics();
+    auto const statistics{ SC2::CompilationCache::loadStatistics(directory) };
+    REQUIRE(statistics.hits == 1);
+    REQUIRE(statistics.misses == 1);
+  }
+
+  SECTION("batch mode reuses cached assembly")
+  {
+    auto const sources_directory{ directory / "sources" };
+    std::filesystem::create_directories(sources_directory);
+    std::vector<std::string> source_paths{};
+    for (auto const *const name: { "first.c", "second.c" }) {
+      std::ofstream out{ sources_directory / name };
+      out << basic_program_text;
+      source_paths.push_back((sources_directory / name).string());
+    }
+    SC2::CompilationCache cache{ directory / "cache" };
+    REQUIRE(SC2::compileBatch(source_paths, 1, &cache).empty());
+    REQUIRE(cache.getStatistics().misses == 1);
+    REQUIRE(cache.getStatistics().hits == 1);
+    std::ifstream     in{ sources_directory / "second.s" };
+    std::string const assembly{ std::istreambuf_iterator<char>{ in }, {} };
+    REQUIRE(assembly.contains("main"));
+  }
+
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
+#include <sc2/compilation_context.hpp>
+#include <sc2/compiler_error.hpp>
+#include <sc2/test_fixtures.hpp>
+
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace {
+  [[nodiscard]] std::string compile(char const * const program_text)
+  {
+    SC2::CompilationContext context{};
+    SC2::AssemblyBuffer     assembly_buffer{};
+    context.compile(program_text)->emitCode(assembly_buffer);
+    return std::string{ assembly_buffer.getText() };
+  }
+} // namespace
+
+TEST_CASE("compilation contexts are independent")
+{
+  constexpr char const * const program_text{
+    "int main(void) {\n"
+    "  int a = 1;\n"
+    "  int b = a + 2;\n"
+    "  return a * b;\n"
+    "}\n"
+  };
+  std::string const expected_assembly{ compile(program_text) };
+
+  SECTION("a second compilation produces the same output")
+  {
+    REQUIRE(compile(program_text) == expected_assembly);
+  }
+
+  SECTION("compilations on other threads produce the same output")
+  {
+    std::string first_assembly{};
+    std::string second_assembly{};
+    {
+      std::jthread first{ [&first_assembly] {
+        first_assembly = compile(program_text);
+      } };
+      std::jthread second{ [&second_assembly] {
+        second_assembly = compile(program_text);
+      } };
+    }
+    REQUIRE(first_assembly == expected_assembly);
+    REQUIRE(second_assembly == expected_assembly);
+  }
+
+  SECTION("contexts alive together on one thread can die in any order")
+  {
+    std::optional<SC2::CompilationContext> first{ std::in_place };
+    std::optional<SC2::CompilationContext> second{ std::in_place };
+    {
+      auto const first_assembly{ first->compile(program_text) };
+      static_cast<void>(second->compile(program_text));
+      REQUIRE(SC2::NodeArena::getCurrentArena() == nullptr);
+      REQUIRE(first->getArena().getAllocationCount() > 0);
+      REQUIRE(
+        first->getArena().getAllocationCount()
+        == second->getArena().getAllocationCount()
+      );
+      // Destroying the second context leaves the first one's nodes alone.
+      second.reset();
+      SC2::AssemblyBuffer assembly_buffer{};
+      first_assembly->emitCode(assembly_buffer);
+      REQUIRE(assembly_buffer.getText() == expected_assembly);
+    }
+    // Nor does a compilation after the first context is gone use its arena.
+    first.reset();
+    REQUIRE(compile(program_text) == expected_assembly);
+  }
+}
+
+TEST_CASE("compilation context owns the compilation's state")
+{
+  SC2::CompilationContext context{};
+
+  SECTION("declarations are numbered across parses")
+  {
+    REQUIRE(context.getDeclarationCount() == 0);
+    static_cast<void>(context.parse("int main(void) { int a = 1; return a; }"));
+    REQUIRE(context.getDeclarationCount() == 1);
+    static_cast<void>(context.parse(basic_program_text));
+    REQUIRE(context.getDeclarationCount() == 1);
+  }
+
+  SECTION("diagnostics are kept in the order they are reported")
+  {
+    REQUIRE(context.getDiagnostics().empty());
+    REQUIRE_THROWS_AS(
+      context.compile("int main(void) { return; }"),
+      SC2::CompilerError
+    );
+    context.report("first");
+    context.report("second");
+    REQUIRE(context.getDiagnostics().size() == 2);
+    REQUIRE(context.getDiagnostics().front() == "first");
+    REQUIRE(context.getDiagnostics().back() == "second");
+  }
+}
@@ -0,0 +1,204 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/compile_server.hpp>
+#include <sc2/test_fixtures.hpp>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  // Serves on another thread, and stops even if a requirement fails.
+  class RunningServer
+  {
+    SC2::CompileServer server;
+    std::jthread       thread{ [this] { server.run(4); } };
+
+    public:
+    explicit RunningServer(std::filesystem::path const &socket_path)
+      : server{ socket_path }
+    {}
+
+    ~RunningServer() { server.stop(); }
+  };
+
+  // A client connection that sends nothing unless told to.
+  class IdleConnection
+  {
+    int descriptor{ ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0) };
+
+    public:
+    explicit IdleConnection(std::filesystem::path const &socket_path)
+    {
+      ::sockaddr_un address{};
+      address.sun_family = AF_UNIX;
+      std::strcpy(address.sun_path, socket_path.c_str());
+      REQUIRE(
+        ::connect(
+          descriptor,
+          reinterpret_cast<::sockaddr const *>(&address),
+          sizeof address
+        )
+        == 0
+      );
+    }
+
+    IdleConnection(IdleConnection const &)            = delete;
+    IdleConnection &operator=(IdleConnection const &) = delete;
+
+    // Sends the length of a request's options but not the options, leaving
+    // the server part way through reading the request.
+    void sendPartOfRequest() const
+    {
+      std::uint64_t const size{ 16 };
+      REQUIRE(::send(descriptor, &size, sizeof size, 0) == sizeof size);
+    }
+
+    ~IdleConnection() { ::close(descriptor); }
+  };
+} // namespace
+
+TEST_CASE("compile server answers requests")
+{
+  auto const socket_path{ std::filesystem::temp_directory_path()
+                          / "sc2_compile_server_tests.sock" };
+  RunningServer const server{ socket_path };
+  auto const          expected{
+    SC2::compileRequest("-S", "program.c", basic_program_text)
+  };
+  REQUIRE(expected.succeeded);
+
+  SECTION("assembly matches compiling in process")
+  {
+    auto const result{ SC2::requestCompilation(
+      socket_path,
+      "-S",
+      "program.c",
+      basic_program_text
+    ) };
+    REQUIRE(result.succeeded);
+    REQUIRE(result.output == expected.output);
+  }
+
+  SECTION("diagnostics are returned")
+  {
+    auto const result{ SC2::requestCompilation(
+      socket_path,
+      "",
+      "program.c",
+      "int main(void) { return; }"
+    ) };
+    REQUIRE(!result.succeeded);
+    REQUIRE(!result.output.empty());
+  }
+
+  SECTION("invalid options are rejected")
+  {
+    auto const result{ SC2::requestCompilation(
+      socket_path,
+      "--bogus",
+      "program.c",
+      basic_program_text
+    ) };
+    REQUIRE(!result.succeeded);
+  }
+
+  SECTION("options that stop early return no output")
+  {
+    auto const result{ SC2::requestCompilation(
+      socket_path,
+      "--tacky",
+      "program.c",
+      basic_program_text
+    ) };
+    REQUIRE(result.succeeded);
+    REQUIRE(result.output.empty());
+  }
+
+  SECTION("requests are served concurrently")
+  {
+    std::vector<SC2::CompileResult> results(16);
+    {
+      std::vector<std::jthread> clients{};
+      for (std::size_t client{}; client < results.size(); ++client)
+        clients.emplace_back([&results, &socket_path, client] {
+          results[client] = SC2::requestCompilation(
+            socket_path,
+            "-S",
+            "program.c",
+            basic_program_text
+          );
+        });
+    }
+    for (auto const &result: results)
+      REQUIRE(result.output == expected.output);
+  }
+}
+
+TEST_CASE("compile server is not held up by idle clients")
+{
+  auto const socket_path{ std::filesystem::temp_directory_path()
+                          / "sc2_compile_server_idle_tests.sock" };
+
+  SECTION("idle connections do not hold the workers")
+  {
+    // Twice as many connections as the server has workers.
+    RunningServer const        server{ socket_path };
+    std::deque<IdleConnection> connections{};
+    for (std::size_t connection{}; connection < 8; ++connection)
+      connections.emplace_back(socket_path);
+    auto const result{ SC2::requestCompilation(
+      socket_path,
+      "-S",
+      "program.c",
+      basic_program_text
+    ) };
+    REQUIRE(result.succeeded);
+  }
+
+  SECTION("requests left part way through do not hold the workers")
+  {
+    // Twice as many clients stalled part way through a request as the server
+    // has workers.
+    RunningServer const        server{ socket_path };
+    std::deque<IdleConnection> connections{};
+    for (std::size_t connection{}; connection < 8; ++connection)
+      connections.emplace_back(socket_path).sendPartOfRequest();
+    auto const result{ SC2::requestCompilation(
+      socket_path,
+      "-S",
+      "program.c",
+      basic_program_text
+    ) };
+    REQUIRE(result.succeeded);
+  }
+
+  SECTION("stopping does not wait for clients to close their connections")
+  {
+    SC2::CompileServer server{ socket_path };
+    {
+      // The connections are closed only after the server thread is joined.
+      IdleConnection const idle_connection{ socket_path };
+      IdleConnection const partial_connection{ socket_path };
+      std::jthread         thread{ [&server] { server.run(2); } };
+      partial_connection.sendPartOfRequest();
+      // Lets the server take up both connections before it is stopped.
+      auto const result{ SC2::requestCompilation(
+        socket_path,
+        "--lex",
+        "program.c",
+        basic_program_text
+      ) };
+      REQUIRE(result.succeeded);
+      server.stop();
+    }
+  }
+}
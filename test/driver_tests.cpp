@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/driver.hpp>
+
+#include <signal.h>
+#include <sys/wait.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+TEST_CASE("driver runs the system compiler through pipes")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_driver_tests" };
+  std::filesystem::create_directories(directory);
+
+  SECTION("the preprocessor output is read from a pipe")
+  {
+    auto const source_path{ directory / "program.c" };
+    {
+      std::ofstream out{ source_path };
+      out << "#define ANSWER 42\n"
+             "int main(void) {\n"
+             "  return ANSWER;\n"
+             "}\n";
+    }
+    REQUIRE(
+      SC2::preprocess(source_path.string())
+      == "int main(void) {\n"
+         "  return 42;\n"
+         "}\n"
+    );
+  }
+
+  SECTION("preprocessor errors are reported")
+  {
+    REQUIRE_THROWS_AS(
+      SC2::preprocess((directory / "missing.c").string()),
+      SC2::ProcessError
+    );
+  }
+
+  SECTION("assembly written to a pipe is assembled and linked")
+  {
+    auto const executable_path{ directory / "program" };
+    SC2::assembleAndLink(
+      "  .globl main\n"
+      "main:\n"
+      "  movl $7, %eax\n"
+      "  ret\n"
+      "  .section .note.GNU-stack,\"\",@progbits\n",
+      executable_path.string()
+    );
+    int const status{ std::system(executable_path.c_str()) };
+    REQUIRE(WEXITSTATUS(status) == 7);
+  }
+
+  SECTION("assembler errors are reported")
+  {
+    REQUIRE_THROWS_AS(
+      SC2::assembleAndLink(
+        "  notaninstruction\n",
+        (directory / "bad").string()
+      ),
+      SC2::ProcessError
+    );
+  }
+
+  SECTION("the host's SIGPIPE disposition and signal mask are left alone")
+  {
+    struct ::sigaction default_action{};
+    struct ::sigaction host_action{};
+    default_action.sa_handler = SIG_DFL;
+    ::sigaction(SIGPIPE, &default_action, &host_action);
+    ::sigset_t mask_before{};
+    ::pthread_sigmask(SIG_BLOCK, nullptr, &mask_before);
+    REQUIRE_THROWS_AS(
+      SC2::assembleAndLink(
+        "  notaninstruction\n",
+        (directory / "bad").string()
+      ),
+      SC2::ProcessError
+    );
+    struct ::sigaction action_after{};
+    ::sigset_t         mask_after{};
+    ::sigaction(SIGPIPE, &host_action, &action_after);
+    ::pthread_sigmask(SIG_BLOCK, nullptr, &mask_after);
+    REQUIRE(action_after.sa_handler == SIG_DFL);
+    REQUIRE(
+      ::sigismember(&mask_after, SIGPIPE)
+      == ::sigismember(&mask_before, SIGPIPE)
+    );
+  }
+
+  std::filesystem::remove_all(directory);
+}
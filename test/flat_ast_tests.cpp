@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/ast.hpp>
+#include <sc2/flat_ast.hpp>
+#include <sc2/lexer.hpp>
+#include <sc2/parser.hpp>
+#include <sc2/tacky_ast.hpp>
+#include <sc2/test_fixtures.hpp>
+
+#include <memory>
+
+namespace {
+  constexpr char const * const flat_ast_program_text{
+    "int main(void) {\n"
+    "  int a = 1;\n"
+    "  int b;\n"
+    "  b = -(~a) + !a * 3 / 2 % 5;\n"
+    "  a += b++ - --a;\n"
+    "  b -= a-- << 2 >> ++b;\n"
+    "  a *= (a & b) | (a ^ b);\n"
+    "  b /= a == b != (a < b) > 1;\n"
+    "  a %= a <= b >= 0;\n"
+    "  a &= a && b || !b;\n"
+    "  a |= 1;\n"
+    "  a ^= 2;\n"
+    "  a <<= 1;\n"
+    "  a >>= 1;\n"
+    "  ;\n"
+    "  return a + b;\n"
+    "}\n"
+  };
+} // namespace
+
+TEST_CASE("flat AST behaves correctly")
+{
+  SECTION("a basic program is flattened into one node per AST node")
+  {
+    SC2::Lexer                           lexer{ basic_program_text };
+    SC2::Parser                          parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode> program_ast{ parser.parseProgram() };
+    SC2::FlatAST                         flat_ast{ program_ast->flatten() };
+    REQUIRE(flat_ast.getNodeCount() == 2);
+    REQUIRE(flat_ast.prettyPrint() == basic_program_text);
+  }
+  SECTION("the flat AST pretty-prints exactly like the tree")
+  {
+    SC2::Lexer                           lexer{ flat_ast_program_text };
+    SC2::Parser                          parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode> program_ast{ parser.parseProgram() };
+    SC2::FlatAST                         flat_ast{ program_ast->flatten() };
+    REQUIRE(flat_ast.prettyPrint() == program_ast->prettyPrint());
+  }
+  SECTION("the flat AST lowers to the same TACKY as the tree")
+  {
+    SC2::Lexer                           lexer{ flat_ast_program_text };
+    SC2::Parser                          parser{ lexer };
+    std::shared_ptr<SC2::ProgramASTNode> program_ast{ parser.parseProgram() };
+    SC2::FlatAST                         flat_ast{ program_ast->flatten() };
+    REQUIRE(
+      flat_ast.emitTACKY()->prettyPrint()
+      == program_ast->emitTACKY()->prettyPrint()
+    );
+  }
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers.hpp>
+#include <catch2/matchers/catch_matchers_exception.hpp>
+#include <sc2/input_file.hpp>
+#include <string_view>
+
+#include <unistd.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <thread>
+
+TEST_CASE("input files are read")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_input_file_tests" };
+  std::filesystem::create_directories(directory);
+  // Bigger than both a pipe and the initial buffer of an input that cannot
+  // be mapped, so that reading one grows the buffer.
+  std::string program_text{};
+  while (program_text.size() <= 256 * 1024)
+    program_text += "int main(void) { return 2; }\n";
+
+  SECTION("a regular file is mapped")
+  {
+    std::string const path{ (directory / "program.i").string() };
+    {
+      std::ofstream out{ path };
+      out << program_text;
+    }
+    SC2::InputFile const input_file{ path };
+    REQUIRE(input_file.isMapped());
+    REQUIRE(input_file.getText() == program_text);
+  }
+  SECTION("an empty file is empty")
+  {
+    std::string const path{ (directory / "empty.i").string() };
+    std::ofstream{ path }.close();
+    SC2::InputFile const input_file{ path };
+    REQUIRE(input_file.getText().empty());
+  }
+  SECTION("a pipe is read into a buffer")
+  {
+    int descriptors[2]{};
+    REQUIRE(::pipe(descriptors) == 0);
+    std::jthread writer{ [&program_text, descriptor = descriptors[1]] {
+      std::string_view remaining{ program_text };
+      while (!remaining.empty()) {
+        ::ssize_t const written{
+          ::write(descriptor, remaining.data(), remaining.size())
+        };
+        if (written < 0) break;
+        remaining.remove_prefix(static_cast<std::size_t>(written));
+      }
+      ::close(descriptor);
+    } };
+    SC2::InputFile const input_file{ std::format(
+      "/dev/fd/{}",
+      descriptors[0]
+    ) };
+    writer.join();
+    ::close(descriptors[0]);
+    REQUIRE(!input_file.isMapped());
+    REQUIRE(input_file.getText() == program_text);
+  }
+  SECTION("a missing file is an error")
+  {
+    std::string const path{ (directory / "missing.i").string() };
+    REQUIRE_THROWS_MATCHES(
+      SC2::InputFile{ path },
+      SC2::InputFileError,
+      Catch::Matchers::Message(
+        std::format("Cannot read {}: No such file or directory", path)
+      )
+    );
+  }
+  std::filesystem::remove_all(directory);
+}
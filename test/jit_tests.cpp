@@ -0,0 +1,44 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/assembly_ast.hpp>
+#include <sc2/compile_fixtures.hpp>
+#include <sc2/jit.hpp>
+
+#include <csignal>
+
+TEST_CASE("programs run in memory")
+{
+  SECTION("the result of main is returned")
+  {
+    auto const assembly{ compileProgram(
+      "int main(void) {\n"
+      "  int a = 6;\n"
+      "  int b = a * 7 - (a << 2) / 3;\n"
+      "  return (b > 30 && b % 5 == 4) * b;\n"
+      "}\n"
+    ) };
+    REQUIRE(SC2::runProgram(*assembly) == 34);
+  }
+
+  SECTION("negative results are returned in full in process")
+  {
+    auto const assembly{ compileProgram(
+      "int main(void) {\n"
+      "  int a = 1000;\n"
+      "  return -a * 3;\n"
+      "}\n"
+    ) };
+    REQUIRE(SC2::runProgram(*assembly) == -3000);
+    REQUIRE(SC2::runProgramInChildProcess(*assembly) == (-3000 & 255));
+  }
+
+  SECTION("a crash in a child process is reported as its signal")
+  {
+    auto const assembly{ compileProgram(
+      "int main(void) {\n"
+      "  int zero = 0;\n"
+      "  return 1 / zero;\n"
+      "}\n"
+    ) };
+    REQUIRE(SC2::runProgramInChildProcess(*assembly) == 128 + SIGFPE);
+  }
+}
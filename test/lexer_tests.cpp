@@ -5,6 +5,7 @@
 #include <sc2/lexer.hpp>
 #include <sc2/parser.hpp>
 #include <sc2/test_fixtures.hpp>
+#include <sc2/token_buffer.hpp>
 #include <string_view>
 
 #include <array>
@@ -12,6 +13,7 @@
 #include <iterator>
 #include <memory>
 #include <ranges>
+#include <string>
 #include <variant>
 #include <vector>
 
@@ -61,9 +63,9 @@ TEST_CASE("lexer behaves correctly")
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
       REQUIRE(tokens.size() == 3);
-      REQUIRE(*tokens[0].getIntKeyword() == SC2::IntKeywordToken{});
-      REQUIRE(*tokens[1].getReturnKeyword() == SC2::ReturnKeywordToken{});
-      REQUIRE(*tokens[2].getVoidKeyword() == SC2::VoidKeywordToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::IntKeyword);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::ReturnKeyword);
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::VoidKeyword);
     }
     SECTION(
       "identifiers are correctly lexed and not confused with keyword prefixes"
@@ -72,24 +74,18 @@ TEST_CASE("lexer behaves correctly")
       SC2::Lexer              lexer{ "int9_ER return9_ER void9_ER" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(tokens[0].getIdentifier()->getName() == "int9_ER");
-      REQUIRE(tokens[1].getIdentifier()->getName() == "return9_ER");
-      REQUIRE(tokens[2].getIdentifier()->getName() == "void9_ER");
+      REQUIRE(tokens[0].getIdentifier() == "int9_ER");
+      REQUIRE(tokens[1].getIdentifier() == "return9_ER");
+      REQUIRE(tokens[2].getIdentifier() == "void9_ER");
     }
     SECTION("literal constants are correctly lexed")
     {
       SC2::Lexer              lexer{ "123456789 123 12341" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(
-        *tokens[0].getLiteralConstant() == SC2::LiteralConstantToken(123456789)
-      );
-      REQUIRE(
-        *tokens[1].getLiteralConstant() == SC2::LiteralConstantToken(123)
-      );
-      REQUIRE(
-        *tokens[2].getLiteralConstant() == SC2::LiteralConstantToken(12341)
-      );
+      REQUIRE(tokens[0].getLiteralConstant() == 123456789);
+      REQUIRE(tokens[1].getLiteralConstant() == 123);
+      REQUIRE(tokens[2].getLiteralConstant() == 12341);
     }
     SECTION("literal constants are only lexed when followed by EOF or spaces")
     {
@@ -114,41 +110,41 @@ TEST_CASE("lexer behaves correctly")
       SC2::Lexer              lexer{ "( )" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getLeftParenthesis() == SC2::LeftParenthesisToken{});
-      REQUIRE(*tokens[1].getRightParenthesis() == SC2::RightParenthesisToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::LeftParenthesis);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::RightParenthesis);
     }
     SECTION("braces are correctly lexed")
     {
       SC2::Lexer              lexer{ "{ }" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getLeftCurlyBrace() == SC2::LeftCurlyBraceToken{});
-      REQUIRE(*tokens[1].getRightCurlyBrace() == SC2::RightCurlyBraceToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::LeftCurlyBrace);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::RightCurlyBrace);
     }
     SECTION("semicolons are correctly lexed")
     {
       SC2::Lexer              lexer{ ";;;" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getSemicolon() == SC2::SemicolonToken{});
-      REQUIRE(*tokens[1].getSemicolon() == SC2::SemicolonToken{});
-      REQUIRE(*tokens[2].getSemicolon() == SC2::SemicolonToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::Semicolon);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::Semicolon);
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::Semicolon);
     }
     SECTION("a basic program is correctly lexed")
     {
       SC2::Lexer              lexer{ basic_program_text };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getIntKeyword() == SC2::IntKeywordToken{});
-      REQUIRE(tokens[1].getIdentifier()->getName() == "main");
-      REQUIRE(*tokens[2].getLeftParenthesis() == SC2::LeftParenthesisToken{});
-      REQUIRE(*tokens[3].getVoidKeyword() == SC2::VoidKeywordToken{});
-      REQUIRE(*tokens[4].getRightParenthesis() == SC2::RightParenthesisToken{});
-      REQUIRE(*tokens[5].getLeftCurlyBrace() == SC2::LeftCurlyBraceToken{});
-      REQUIRE(*tokens[6].getReturnKeyword() == SC2::ReturnKeywordToken{});
-      REQUIRE(*tokens[7].getLiteralConstant() == SC2::LiteralConstantToken(2));
-      REQUIRE(*tokens[8].getSemicolon() == SC2::SemicolonToken{});
-      REQUIRE(*tokens[9].getRightCurlyBrace() == SC2::RightCurlyBraceToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::IntKeyword);
+      REQUIRE(tokens[1].getIdentifier() == "main");
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::LeftParenthesis);
+      REQUIRE(tokens[3].getKind() == SC2::TokenKind::VoidKeyword);
+      REQUIRE(tokens[4].getKind() == SC2::TokenKind::RightParenthesis);
+      REQUIRE(tokens[5].getKind() == SC2::TokenKind::LeftCurlyBrace);
+      REQUIRE(tokens[6].getKind() == SC2::TokenKind::ReturnKeyword);
+      REQUIRE(tokens[7].getLiteralConstant() == 2);
+      REQUIRE(tokens[8].getKind() == SC2::TokenKind::Semicolon);
+      REQUIRE(tokens[9].getKind() == SC2::TokenKind::RightCurlyBrace);
     }
   }
   SECTION("Chapter 2")
@@ -158,30 +154,30 @@ TEST_CASE("lexer behaves correctly")
       SC2::Lexer              lexer{ "~~~" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getTilde() == SC2::TildeToken{});
-      REQUIRE(*tokens[1].getTilde() == SC2::TildeToken{});
-      REQUIRE(*tokens[2].getTilde() == SC2::TildeToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::Tilde);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::Tilde);
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::Tilde);
     }
     SECTION("hyphens are correctly lexed")
     {
       SC2::Lexer              lexer{ "-abc123-hello" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getHyphen() == SC2::HyphenToken{});
-      REQUIRE(*tokens[1].getIdentifier() == SC2::IdentifierToken("abc123"));
-      REQUIRE(*tokens[2].getHyphen() == SC2::HyphenToken{});
-      REQUIRE(*tokens[3].getIdentifier() == SC2::IdentifierToken("hello"));
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::Hyphen);
+      REQUIRE(tokens[1].getIdentifier() == "abc123");
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::Hyphen);
+      REQUIRE(tokens[3].getIdentifier() == "hello");
     }
     SECTION("decrements are correctly lexed")
     {
       SC2::Lexer              lexer{ "---abc123--hello" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getDecrement() == SC2::DecrementToken{});
-      REQUIRE(*tokens[1].getHyphen() == SC2::HyphenToken{});
-      REQUIRE(*tokens[2].getIdentifier() == SC2::IdentifierToken("abc123"));
-      REQUIRE(*tokens[3].getDecrement() == SC2::DecrementToken{});
-      REQUIRE(*tokens[4].getIdentifier() == SC2::IdentifierToken("hello"));
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::Decrement);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::Hyphen);
+      REQUIRE(tokens[2].getIdentifier() == "abc123");
+      REQUIRE(tokens[3].getKind() == SC2::TokenKind::Decrement);
+      REQUIRE(tokens[4].getIdentifier() == "hello");
     }
   }
   SECTION("Chapter 3")
@@ -191,27 +187,27 @@ TEST_CASE("lexer behaves correctly")
       SC2::Lexer              lexer{ "+*/%" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getPlusSign() == SC2::PlusSignToken{});
-      REQUIRE(*tokens[1].getAsterisk() == SC2::AsteriskToken{});
-      REQUIRE(*tokens[2].getForwardSlash() == SC2::ForwardSlashToken{});
-      REQUIRE(*tokens[3].getPercentSign() == SC2::PercentSignToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::PlusSign);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::Asterisk);
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::ForwardSlash);
+      REQUIRE(tokens[3].getKind() == SC2::TokenKind::PercentSign);
     }
     SECTION("bitwise operator tokens are correctly lexed")
     {
       SC2::Lexer              lexer{ "&|^" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getBitwiseAnd() == SC2::BitwiseAndToken{});
-      REQUIRE(*tokens[1].getBitwiseOr() == SC2::BitwiseOrToken{});
-      REQUIRE(*tokens[2].getBitwiseXor() == SC2::BitwiseXorToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::BitwiseAnd);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::BitwiseOr);
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::BitwiseXor);
     }
     SECTION("arithmetic shift operator tokens are correctly lexed")
     {
       SC2::Lexer              lexer{ "<<>>" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getLeftShift() == SC2::LeftShiftToken{});
-      REQUIRE(*tokens[1].getRightShift() == SC2::RightShiftToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::LeftShift);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::RightShift);
     }
   }
   SECTION("Chapter 4")
@@ -221,31 +217,27 @@ TEST_CASE("lexer behaves correctly")
       SC2::Lexer              lexer{ "!&&||" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getExclamationPoint() == SC2::ExclamationPointToken{});
-      REQUIRE(*tokens[1].getDoubleAmpersand() == SC2::DoubleAmpersandToken{});
-      REQUIRE(*tokens[2].getDoublePipe() == SC2::DoublePipeToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::ExclamationPoint);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::DoubleAmpersand);
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::DoublePipe);
     }
     SECTION("Comparison operator tokens are correctly lexed")
     {
       SC2::Lexer              lexer{ "!===" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getNotEqualTo() == SC2::NotEqualToToken{});
-      REQUIRE(*tokens[1].getEqualTo() == SC2::EqualToToken{});
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::NotEqualTo);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::EqualTo);
     }
     SECTION("Relational operator tokens are correctly lexed")
     {
       SC2::Lexer              lexer{ "< <= > >=" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getLessThan() == SC2::LessThanToken{});
-      REQUIRE(
-        *tokens[1].getLessThanOrEqualTo() == SC2::LessThanOrEqualToToken{}
-      );
-      REQUIRE(*tokens[2].getGreaterThan() == SC2::GreaterThanToken{});
-      REQUIRE(
-        *tokens[3].getGreaterThanOrEqualTo() == SC2::GreaterThanOrEqualToToken{}
-      );
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::LessThan);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::LessThanOrEqualTo);
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::GreaterThan);
+      REQUIRE(tokens[3].getKind() == SC2::TokenKind::GreaterThanOrEqualTo);
     }
   }
   SECTION("Chapter 5")
@@ -255,47 +247,195 @@ TEST_CASE("lexer behaves correctly")
       SC2::Lexer              lexer{ "= += -= *= /= %= &= |= ^= <<= >>=" };
       std::vector<SC2::Token> tokens{};
       for (auto const &token: lexer) { tokens.push_back(token); }
-      REQUIRE(*tokens[0].getAssignment() == SC2::AssignmentToken{});
-      REQUIRE(*tokens[1].getAddAssignment() == SC2::AddAssignmentToken{});
-      REQUIRE(
-        *tokens[2].getSubtractAssignment() == SC2::SubtractAssignmentToken{}
-      );
-      REQUIRE(
-        *tokens[3].getMultiplyAssignment() == SC2::MultiplyAssignmentToken{}
-      );
-      REQUIRE(*tokens[4].getDivideAssignment() == SC2::DivideAssignmentToken{});
-      REQUIRE(*tokens[5].getModuloAssignment() == SC2::ModuloAssignmentToken{});
-      REQUIRE(
-        *tokens[6].getBitwiseAndAssignment() == SC2::BitwiseAndAssignmentToken{}
-      );
-      REQUIRE(
-        *tokens[7].getBitwiseOrAssignment() == SC2::BitwiseOrAssignmentToken{}
-      );
-      REQUIRE(
-        *tokens[8].getBitwiseXorAssignment() == SC2::BitwiseXorAssignmentToken{}
-      );
-      REQUIRE(
-        *tokens[9].getLeftShiftAssignment() == SC2::LeftShiftAssignmentToken{}
-      );
-      REQUIRE(
-        *tokens[10].getRightShiftAssignment()
-        == SC2::RightShiftAssignmentToken{}
-      );
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::Assignment);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::AddAssignment);
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::SubtractAssignment);
+      REQUIRE(tokens[3].getKind() == SC2::TokenKind::MultiplyAssignment);
+      REQUIRE(tokens[4].getKind() == SC2::TokenKind::DivideAssignment);
+      REQUIRE(tokens[5].getKind() == SC2::TokenKind::ModuloAssignment);
+      REQUIRE(tokens[6].getKind() == SC2::TokenKind::BitwiseAndAssignment);
+      REQUIRE(tokens[7].getKind() == SC2::TokenKind::BitwiseOrAssignment);
+      REQUIRE(tokens[8].getKind() == SC2::TokenKind::BitwiseXorAssignment);
+      REQUIRE(tokens[9].getKind() == SC2::TokenKind::LeftShiftAssignment);
+      REQUIRE(tokens[10].getKind() == SC2::TokenKind::RightShiftAssignment);
     }
     SECTION("Increment is correctly lexed")
     {
       SC2::Lexer lexer{ "++" };
-      REQUIRE(*(*lexer).getIncrement() == SC2::IncrementToken{});
+      REQUIRE((*lexer).getKind() == SC2::TokenKind::Increment);
     }
     SECTION("typedef keyword is correctly lexed")
     {
       SC2::Lexer lexer{ "typedef" };
-      REQUIRE(*(*lexer).getTypedefKeyword() == SC2::TypedefKeywordToken{});
+      REQUIRE((*lexer).getKind() == SC2::TokenKind::TypedefKeyword);
     }
     SECTION("comma is correctly lexed")
     {
       SC2::Lexer lexer{ "," };
-      REQUIRE(*(*lexer).getComma() == SC2::CommaToken{});
+      REQUIRE((*lexer).getKind() == SC2::TokenKind::Comma);
+    }
+    SECTION("adjacent operators are lexed using the longest match")
+    {
+      SC2::Lexer              lexer{ "<<=<<<=>>>=+++&&&" };
+      std::vector<SC2::Token> tokens{};
+      for (auto const &token: lexer) { tokens.push_back(token); }
+      REQUIRE(tokens.size() == 9);
+      REQUIRE(tokens[0].getKind() == SC2::TokenKind::LeftShiftAssignment);
+      REQUIRE(tokens[1].getKind() == SC2::TokenKind::LeftShift);
+      REQUIRE(tokens[2].getKind() == SC2::TokenKind::LessThanOrEqualTo);
+      REQUIRE(tokens[3].getKind() == SC2::TokenKind::RightShift);
+      REQUIRE(tokens[4].getKind() == SC2::TokenKind::GreaterThanOrEqualTo);
+      REQUIRE(tokens[5].getKind() == SC2::TokenKind::Increment);
+      REQUIRE(tokens[6].getKind() == SC2::TokenKind::PlusSign);
+      REQUIRE(tokens[7].getKind() == SC2::TokenKind::DoubleAmpersand);
+      REQUIRE(tokens[8].getKind() == SC2::TokenKind::BitwiseAnd);
     }
+    SECTION("token predicates and precedences come from the kind table")
+    {
+      SC2::Lexer              lexer{ "-- - *= && x" };
+      std::vector<SC2::Token> tokens{};
+      for (auto const &token: lexer) { tokens.push_back(token); }
+      REQUIRE(tokens[0].isPrefixUnaryOperatorToken());
+      REQUIRE(tokens[0].isPostfixUnaryOperatorToken());
+      REQUIRE(!tokens[0].isBinaryOperatorToken());
+      REQUIRE(tokens[1].isPrefixUnaryOperatorToken());
+      REQUIRE(tokens[1].getPrecedence() == 12);
+      REQUIRE(tokens[2].isBinaryOperatorToken());
+      REQUIRE(tokens[2].isBasicAssignment());
+      REQUIRE(tokens[2].getPrecedence() == 2);
+      REQUIRE(tokens[3].getPrecedence() == 5);
+      REQUIRE(!tokens[4].isBinaryOperatorToken());
+      REQUIRE_THROWS_MATCHES(
+        tokens[4].getLiteralConstant(),
+        SC2::TokenConversionError,
+        Catch::Matchers::Message(
+          "Cannot convert Identifier: x token into a(n) literal constant token"
+        )
+      );
+    }
+    SECTION("identifiers with the same spelling share a symbol")
+    {
+      auto const string_interner{ std::make_shared<SC2::StringInterner>() };
+
+      SC2::Lexer              lexer{ "a b a int b", string_interner };
+      std::vector<SC2::Token> tokens{};
+      for (auto const &token: lexer) { tokens.push_back(token); }
+      REQUIRE(tokens[0].getSymbol() == tokens[2].getSymbol());
+      REQUIRE(tokens[1].getSymbol() == tokens[4].getSymbol());
+      REQUIRE(tokens[0].getSymbol() != tokens[1].getSymbol());
+      REQUIRE(string_interner->getSymbolCount() == 2);
+      REQUIRE(string_interner->getString(tokens[4].getSymbol()) == "b");
+      REQUIRE_THROWS_AS(tokens[3].getSymbol(), SC2::TokenConversionError);
+    }
+    SECTION("unknown characters are rejected")
+    {
+      REQUIRE_THROWS_MATCHES(
+        SC2::Lexer{ "@b = 2;" },
+        SC2::LexerInvalidTokenError,
+        Catch::Matchers::Message("Lexer error: invalid token: @b = 2;")
+      );
+    }
+  }
+}
+
+TEST_CASE("token buffer behaves correctly")
+{
+  SECTION("holds the tokens the lexer produces")
+  {
+    SC2::TokenBuffer const  tokens{ basic_program_text };
+    std::vector<SC2::Token> lexed_tokens{};
+    for (auto const &token: SC2::Lexer{ basic_program_text })
+      lexed_tokens.push_back(token);
+    REQUIRE(
+      std::vector(tokens.getTokens().begin(), tokens.getTokens().end())
+      == lexed_tokens
+    );
+    REQUIRE(tokens.getInvalidTokenError() == nullptr);
+    REQUIRE_NOTHROW(tokens.throwIfInvalid());
+  }
+  SECTION("tokenizing stops at an invalid token without throwing")
+  {
+    SC2::StringInterner     string_interner{};
+    std::vector<SC2::Token> tokens{};
+    auto const              lexed{
+      SC2::Lexer::tokenize("int a = 2 @b;", string_interner, tokens)
+    };
+    REQUIRE(!lexed);
+    REQUIRE(
+      std::string_view{ lexed.error().what() }
+      == "Lexer error: invalid token: @b;"
+    );
+    REQUIRE(tokens.size() == 4);
+    REQUIRE(tokens[0].getKind() == SC2::TokenKind::IntKeyword);
+    REQUIRE(tokens[3].getLiteralConstant() == 2);
+  }
+  SECTION("tokenizing stops at a literal constant too big for an int")
+  {
+    SC2::StringInterner     string_interner{};
+    std::vector<SC2::Token> tokens{};
+    auto const              lexed{
+      SC2::Lexer::tokenize("return 2147483648;", string_interner, tokens)
+    };
+    REQUIRE(!lexed);
+    REQUIRE(
+      std::string_view{ lexed.error().what() }
+      == "Lexer error: literal constant does not fit into domain of int: "
+         "2147483648"
+    );
+    REQUIRE(tokens.size() == 1);
+  }
+  SECTION("literal constants too long for a token are invalid")
+  {
+    SC2::StringInterner     string_interner{};
+    std::vector<SC2::Token> tokens{};
+    std::string const       program_text{
+      std::string(SC2::Token::max_lexeme_size, '0') + "2;"
+    };
+    REQUIRE(!SC2::Lexer::tokenize(program_text, string_interner, tokens));
+    REQUIRE(tokens.empty());
+  }
+  SECTION("keeps the tokens before an invalid one")
+  {
+    SC2::TokenBuffer const tokens{ "a = 2 @b;" };
+    REQUIRE(tokens.getTokens().size() == 3);
+    REQUIRE(tokens.getInvalidTokenError() != nullptr);
+    REQUIRE_THROWS_MATCHES(
+      tokens.throwIfInvalid(),
+      SC2::LexerInvalidTokenError,
+      Catch::Matchers::Message("Lexer error: invalid token: @b;")
+    );
+  }
+  SECTION("takes the rest of a lexer's tokens without throwing")
+  {
+    SC2::Lexer lexer{ "int a = 2 @b;" };
+    ++lexer;
+    SC2::TokenBuffer const tokens{ lexer };
+    REQUIRE(tokens.getTokens().size() == 3);
+    REQUIRE(tokens.getInvalidTokenError() != nullptr);
+    REQUIRE(lexer == lexer.end());
+  }
+  SECTION("parses like a parser reading the lexer")
+  {
+    SC2::TokenBuffer const tokens{ basic_program_text };
+    SC2::Parser            parser{ tokens };
+    REQUIRE(parser.parseProgram()->prettyPrint() == basic_program_text);
+  }
+  SECTION("reports an invalid token where the parser reaches it")
+  {
+    SC2::TokenBuffer const tokens{ "int main(void) { return @; }" };
+    SC2::Parser            parser{ tokens };
+    REQUIRE_THROWS_MATCHES(
+      parser.parseProgram(),
+      SC2::ParserNonTerminalError,
+      Catch::Matchers::Message(
+        "Parser error: invalid non-terminal <program>:\n"
+        "Parser error: invalid non-terminal <function>:\n"
+        "Parser error: invalid non-terminal <block item>:\n"
+        "Parser error: invalid non-terminal <return statement>:\n"
+        "Parser error: invalid non-terminal <expression>:\n"
+        "Parser error: invalid non-terminal <factor>:\n"
+        "Lexer error: invalid token: @; }"
+      )
+    );
   }
 }
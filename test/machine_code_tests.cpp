@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/assembly_ast.hpp>
+#include <sc2/assembly_buffer.hpp>
+#include <sc2/benchmark_fixtures.hpp>
+#include <sc2/compile_fixtures.hpp>
+#include <sc2/elf_object_writer.hpp>
+#include <string_view>
+
+#include <sys/wait.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+  [[nodiscard]] std::vector<std::uint8_t>
+  readFile(std::filesystem::path const &path)
+  {
+    std::ifstream in{ path, std::ios::binary };
+    return { std::istreambuf_iterator<char>{ in },
+             std::istreambuf_iterator<char>{} };
+  }
+
+  [[nodiscard]] int runCommand(std::string const &command)
+  {
+    int const status{ std::system(command.c_str()) };
+    REQUIRE(status != -1);
+    return WEXITSTATUS(status);
+  }
+
+  // Assembles the text of the program with the GNU assembler and checks that
+  // the built-in encoder produces the same .text, and that the object it
+  // writes links and runs like the assembled one.
+  void checkAgainstAssembler(
+    std::filesystem::path const &directory,
+    std::string_view const       program_text,
+    bool const                   allocate_registers
+  )
+  {
+    auto const assembly_path{ directory / "program.s" };
+    auto const as_object_path{ directory / "as.o" };
+    auto const as_text_path{ directory / "as.bin" };
+    auto const sc2_object_path{ directory / "sc2.o" };
+    auto const as_executable_path{ directory / "as" };
+    auto const sc2_executable_path{ directory / "sc2" };
+    auto const assembly{ compileProgram(program_text, allocate_registers) };
+
+    SC2::AssemblyBuffer assembly_buffer{};
+    assembly->emitCode(assembly_buffer);
+    assembly_buffer.writeToFile(assembly_path.string());
+    REQUIRE(
+      runCommand(std::format(
+        "as -o {} {} && objcopy -O binary --only-section=.text {} {}",
+        as_object_path.string(),
+        assembly_path.string(),
+        as_object_path.string(),
+        as_text_path.string()
+      ))
+      == 0
+    );
+
+    SC2::ElfObjectWriter object_writer{};
+    assembly->encode(object_writer);
+    auto const text{ object_writer.getText() };
+    REQUIRE(
+      std::vector<std::uint8_t>{ text.begin(), text.end() }
+      == readFile(as_text_path)
+    );
+    object_writer.writeToFile(sc2_object_path.string());
+
+    REQUIRE(
+      runCommand(std::format(
+        "gcc -o {} {} && gcc -o {} {}",
+        as_executable_path.string(),
+        as_object_path.string(),
+        sc2_executable_path.string(),
+        sc2_object_path.string()
+      ))
+      == 0
+    );
+    REQUIRE(
+      runCommand(sc2_executable_path.string())
+      == runCommand(as_executable_path.string())
+    );
+  }
+} // namespace
+
+TEST_CASE("machine code encoder matches the GNU assembler")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_machine_code_tests" };
+  std::filesystem::create_directories(directory);
+
+  std::string long_operand{ "v1" };
+  for (int term{}; term < 40; ++term)
+    long_operand = std::format("({} * 3 + {})", long_operand, term * 1000);
+  std::vector<std::string> const program_texts{
+    "int main(void) {\n"
+    "  return -(~2);\n"
+    "}\n",
+    "int main(void) {\n"
+    "  int a = 100000;\n"
+    "  int b = a * 7 - 1000 + 3 | 4096;\n"
+    "  b = b ^ -129 & 127;\n"
+    "  return (b / 13 + b % 5) & 255;\n"
+    "}\n",
+    "int main(void) {\n"
+    "  int a = 5;\n"
+    "  int b = a << 3;\n"
+    "  int c = b >> (a - 3);\n"
+    "  c <<= 1;\n"
+    "  return c + (b >> 1);\n"
+    "}\n",
+    "int main(void) {\n"
+    "  int a = 3;\n"
+    "  int b = a < 4 && a >= 2 || a == 7;\n"
+    "  int c = !(a != 3) + (a > 1) + (a <= 0);\n"
+    "  return b * 10 + c;\n"
+    "}\n",
+    // A right operand too long for the short forms of the jumps around it.
+    std::format(
+      "int main(void) {{\n"
+      "  int v1 = 2;\n"
+      "  int v2 = v1 && {0} || v1;\n"
+      "  return (v2 + ({0} || 0)) & 255;\n"
+      "}}\n",
+      long_operand
+    ),
+    generateBenchmarkProgramText(30),
+  };
+
+  for (std::size_t program{}; program < program_texts.size(); ++program) {
+    for (bool const allocate_registers: { false, true }) {
+      INFO(std::format(
+        "program {}, allocate registers: {}",
+        program,
+        allocate_registers
+      ));
+      checkAgainstAssembler(
+        directory,
+        program_texts[program],
+        allocate_registers
+      );
+    }
+  }
+
+  std::filesystem::remove_all(directory);
+}
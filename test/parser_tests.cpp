@@ -6,6 +6,7 @@
 #include <sc2/test_fixtures.hpp>
 
 #include <memory>
+#include <utility>
 
 TEST_CASE("parser behaves correctly")
 {
@@ -261,7 +262,7 @@ TEST_CASE("parser behaves correctly")
       };
       constexpr char const * const prettified_program_text{
         "int main(void) {\n"
-        "  int main.2.a;\n"
+        "  int main.0.a;\n"
         "  ;\n"
         "  ;\n"
         "  ;\n"
@@ -306,15 +307,15 @@ TEST_CASE("parser behaves correctly")
       };
       constexpr char const * const prettified_program_text{
         "int main(void) {\n"
-        "  int main.3.a = 2;\n"
-        "  ++main.3.a;\n"
-        "  --main.3.a;\n"
-        "  main.3.a++;\n"
-        "  main.3.a--;\n"
-        "  ++main.3.a;\n"
-        "  --main.3.a;\n"
-        "  main.3.a++;\n"
-        "  main.3.a--;\n"
+        "  int main.0.a = 2;\n"
+        "  ++main.0.a;\n"
+        "  --main.0.a;\n"
+        "  main.0.a++;\n"
+        "  main.0.a--;\n"
+        "  ++main.0.a;\n"
+        "  --main.0.a;\n"
+        "  main.0.a++;\n"
+        "  main.0.a--;\n"
         "}\n"
       };
       SC2::Lexer                           lexer{ program_text };
@@ -341,18 +342,18 @@ TEST_CASE("parser behaves correctly")
       };
       constexpr char const * const prettified_program_text{
         "int main(void) {\n"
-        "  int main.4.a = 5;\n"
-        "  int main.5.b = 5;\n"
-        "  int main.6.c = 5;\n"
-        "  int main.7.d = 5;\n"
-        "  int main.8.e = 5;\n"
-        "  int main.9.f = 5;\n"
-        "  int main.10.g = 5;\n"
-        "  int main.11.h = 5;\n"
-        "  int main.12.i = 5;\n"
-        "  int main.13.j = 5;\n"
-        "  (main.4.a += (main.5.b -= (main.6.c *= (main.7.d /= (main.8.e %= "
-        "(main.9.f &= (main.10.g |= (main.11.h ^= (main.12.i <<= (main.13.j "
+        "  int main.0.a = 5;\n"
+        "  int main.1.b = 5;\n"
+        "  int main.2.c = 5;\n"
+        "  int main.3.d = 5;\n"
+        "  int main.4.e = 5;\n"
+        "  int main.5.f = 5;\n"
+        "  int main.6.g = 5;\n"
+        "  int main.7.h = 5;\n"
+        "  int main.8.i = 5;\n"
+        "  int main.9.j = 5;\n"
+        "  (main.0.a += (main.1.b -= (main.2.c *= (main.3.d /= (main.4.e %= "
+        "(main.5.f &= (main.6.g |= (main.7.h ^= (main.8.i <<= (main.9.j "
         ">>= "
         "2))))))))));\n"
         "}\n"
@@ -377,9 +378,9 @@ TEST_CASE("parser behaves correctly")
       };
       constexpr char const * const prettified_program_text{
         "int main(void) {\n"
-        "  int main.14.d = 5;\n"
-        "  int main.15.e = 5;\n"
-        "  int main.16.f = 5;\n"
+        "  int main.0.d = 5;\n"
+        "  int main.1.e = 5;\n"
+        "  int main.2.f = 5;\n"
         "}\n"
       };
       SC2::Lexer                           lexer{ program_text };
@@ -408,7 +409,7 @@ TEST_CASE("parser behaves correctly")
           "Parser error: invalid non-terminal <block item>:\n"
           "Parser error: invalid non-terminal <expression statement>:\n"
           "Parser error: invalid non-terminal <expression>:\n"
-          "Semantic analysis error: invalid lvalue: ((main.17.a += main.18.b))"
+          "Semantic analysis error: invalid lvalue: ((main.0.a += main.1.b))"
           // TODO show original name of variable
         )
       );
@@ -431,7 +432,7 @@ TEST_CASE("parser behaves correctly")
           "Parser error: invalid non-terminal <expression statement>:\n"
           "Parser error: invalid non-terminal <expression>:\n"
           "Parser error: invalid non-terminal <factor>:\n"
-          "Semantic analysis error: invalid lvalue: ((main.20.a += main.21.b))"
+          "Semantic analysis error: invalid lvalue: ((main.0.a += main.1.b))"
           // TODO show original name of variable
         )
       );
@@ -454,7 +455,7 @@ TEST_CASE("parser behaves correctly")
           "Parser error: invalid non-terminal <expression statement>:\n"
           "Parser error: invalid non-terminal <expression>:\n"
           "Parser error: invalid non-terminal <factor>:\n"
-          "Semantic analysis error: invalid lvalue: ((main.22.a += main.23.b))"
+          "Semantic analysis error: invalid lvalue: ((main.0.a += main.1.b))"
           // TODO show original name of variable
         )
       );
@@ -618,5 +619,93 @@ TEST_CASE("parser behaves correctly")
         )
       );
     }
+    SECTION("typedef lists must be separated by commas")
+    {
+      constexpr char const * const program_text{
+        "int main(void) {\n"
+        "  typedef int a b;\n"
+        "}\n"
+      };
+      SC2::Lexer  lexer{ program_text };
+      SC2::Parser parser{ lexer };
+      REQUIRE_THROWS_MATCHES(
+        parser.parseProgram(),
+        SC2::ParserNonTerminalError,
+        Catch::Matchers::Message(
+          "Parser error: invalid non-terminal <program>:\n"
+          "Parser error: invalid non-terminal <function>:\n"
+          "Parser error: invalid non-terminal <block item>:\n"
+          "Parser error: invalid non-terminal <typedef>:\n"
+          "Parser error: expected (comma) but got (Identifier: b)"
+        )
+      );
+    }
+    SECTION("expected keywords are named in expectation errors")
+    {
+      SC2::Lexer  lexer{ "int main(int) {}" };
+      SC2::Parser parser{ lexer };
+      REQUIRE_THROWS_MATCHES(
+        parser.parseProgram(),
+        SC2::ParserNonTerminalError,
+        Catch::Matchers::Message(
+          "Parser error: invalid non-terminal <program>:\n"
+          "Parser error: invalid non-terminal <function>:\n"
+          "Parser error: expected (Keyword: void) but got (Keyword: int)"
+        )
+      );
+    }
+  }
+}
+
+TEST_CASE("parse failures are returned without throwing")
+{
+  SECTION("a valid program parses")
+  {
+    SC2::Lexer  lexer{ basic_program_text };
+    SC2::Parser parser{ lexer };
+    auto const  program{ parser.tryParseProgram() };
+    REQUIRE(program);
+    REQUIRE((*program)->prettyPrint() == basic_program_text);
+  }
+  SECTION("an invalid program returns what parseProgram() would throw")
+  {
+    constexpr char const * const invalid_program_text{
+      "int main(void) {\n"
+      "  return (1 + 2;\n"
+      "}"
+    };
+    SC2::Lexer  lexer{ invalid_program_text };
+    SC2::Parser parser{ lexer };
+    auto const  program{ parser.tryParseProgram() };
+    REQUIRE(!program);
+    REQUIRE(
+      program.error().getMessage()
+      == "Parser error: invalid non-terminal <program>:\n"
+         "Parser error: invalid non-terminal <function>:\n"
+         "Parser error: invalid non-terminal <block item>:\n"
+         "Parser error: invalid non-terminal <return statement>:\n"
+         "Parser error: invalid non-terminal <expression>:\n"
+         "Parser error: invalid non-terminal <factor>:\n"
+         "Parser error: unmatched parentheses"
+    );
+    SC2::Lexer  lexer_again{ invalid_program_text };
+    SC2::Parser parser_again{ lexer_again };
+    REQUIRE_THROWS_MATCHES(
+      parser_again.parseProgram(),
+      SC2::ParserNonTerminalError,
+      Catch::Matchers::Message(program.error().getMessage())
+    );
+  }
+  SECTION("a moved-from failure can still be copied and assigned")
+  {
+    SC2::Lexer  lexer{ "int main(void) { return; }" };
+    SC2::Parser parser{ lexer };
+    auto        program{ parser.tryParseProgram() };
+    REQUIRE(!program);
+    SC2::ParseFailure moved_to{ std::move(program.error()) };
+    SC2::ParseFailure copy{ program.error() };
+    copy = program.error();
+    copy = moved_to;
+    REQUIRE(copy.getMessage() == moved_to.getMessage());
   }
 }
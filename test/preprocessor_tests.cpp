@@ -0,0 +1,213 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sc2/lexer.hpp>
+#include <sc2/preprocessor.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+  [[nodiscard]] std::string preprocess(std::string const &text)
+  {
+    return SC2::Preprocessor{}.preprocess(text, "program.c");
+  }
+} // namespace
+
+TEST_CASE("preprocessor behaves correctly")
+{
+  SECTION("comments and line splices are removed")
+  {
+    REQUIRE(
+      preprocess(
+        "int /* inline */ main(void) { // trailing\n"
+        "  return 4\\\n"
+        "2; /* spans\n"
+        "  lines */\n"
+        "}\n"
+      )
+      == "int main(void) {\n"
+         "return 42;\n"
+         "}\n"
+    );
+  }
+
+  SECTION("object-like macros are expanded and undefined")
+  {
+    REQUIRE(
+      preprocess(
+        "#define ANSWER 40 + TWO\n"
+        "#define TWO 2\n"
+        "return ANSWER;\n"
+        "#undef ANSWER\n"
+        "return ANSWER;\n"
+      )
+      == "return 40 + 2;\n"
+         "return ANSWER;\n"
+    );
+  }
+
+  SECTION("function-like macros substitute, stringize and paste arguments")
+  {
+    REQUIRE(
+      preprocess(
+        "#define TWICE(x) ((x) * 2)\n"
+        "#define CAT(a, b) a ## b\n"
+        "#define STRING(x) #x\n"
+        "#define CALL(f, ...) f(__VA_ARGS__)\n"
+        "TWICE(TWICE(1)) CAT(v, 12) CAT(, 3) STRING(a \"b\")\n"
+        "CALL(g, 1, (2, 3)) TWICE\n"
+      )
+      == "((((1) * 2)) * 2) v12 3 \"a \\\"b\\\"\"\n"
+         "g(1, (2, 3)) TWICE\n"
+    );
+  }
+
+  SECTION("macros are not expanded inside their own expansion")
+  {
+    REQUIRE(
+      preprocess(
+        "#define x x + 1\n"
+        "#define f(a) a * f\n"
+        "x f(2)(3)\n"
+      )
+      == "x + 1 2 * f(3)\n"
+    );
+  }
+
+  SECTION("conditional directives select one group")
+  {
+    REQUIRE(
+      preprocess(
+        "#define LEVEL 2\n"
+        "#if LEVEL < 2 && 1 / 0\n"
+        "three\n"
+        "#elif defined(LEVEL) && LEVEL == 2\n"
+        "two\n"
+        "#if 0\n"
+        "' unmatched quote in a skipped group\n"
+        "#else\n"
+        "nested\n"
+        "#endif\n"
+        "#else\n"
+        "other\n"
+        "#endif\n"
+        "#ifndef LEVEL\n"
+        "undefined\n"
+        "#endif\n"
+      )
+      == "two\n"
+         "nested\n"
+    );
+  }
+
+  SECTION("the output is accepted by the lexer")
+  {
+    std::string const program_text{ preprocess(
+      "#define NEGATE(x) -x\n"
+      "int main(void) { return -NEGATE(-1); }\n"
+    ) };
+    std::size_t token_count{};
+    for (SC2::Lexer lexer{ program_text }; lexer != lexer.end(); ++lexer)
+      ++token_count;
+    REQUIRE(token_count == 13);
+  }
+
+  SECTION("errors are reported")
+  {
+    REQUIRE_THROWS_AS(preprocess("#if 1\n"), SC2::PreprocessorError);
+    REQUIRE_THROWS_AS(preprocess("#endif\n"), SC2::PreprocessorError);
+    REQUIRE_THROWS_AS(preprocess("#error stop\n"), SC2::PreprocessorError);
+    REQUIRE_THROWS_AS(preprocess("/* open\n"), SC2::PreprocessorError);
+    REQUIRE_THROWS_AS(
+      preprocess("#define F(a, b) a\nF(1)\n"),
+      SC2::PreprocessorError
+    );
+    REQUIRE_THROWS_AS(
+      preprocess("#include \"missing.h\"\n"),
+      SC2::PreprocessorError
+    );
+  }
+
+  SECTION("division overflow is an error rather than a trap")
+  {
+    REQUIRE_THROWS_AS(
+      preprocess("#if (-9223372036854775807 - 1) / -1\n#endif\n"),
+      SC2::PreprocessorError
+    );
+    REQUIRE_THROWS_AS(
+      preprocess("#if (-9223372036854775807 - 1) % -1\n#endif\n"),
+      SC2::PreprocessorError
+    );
+    REQUIRE(
+      preprocess("#if 0 && (-9223372036854775807 - 1) / -1\nno\n#endif\n")
+      == ""
+    );
+  }
+
+  SECTION("unsigned operands make arithmetic unsigned")
+  {
+    REQUIRE(preprocess("#if -1 < 0u\nno\n#endif\n") == "");
+    REQUIRE(preprocess("#if 0x8000000000000000 > 0\nyes\n#endif\n") == "yes\n");
+    REQUIRE(preprocess("#if -1 < 0\nyes\n#endif\n") == "yes\n");
+    REQUIRE(
+      preprocess("#if -1 / 2u == 0x7FFFFFFFFFFFFFFF\nyes\n#endif\n")
+      == "yes\n"
+    );
+    REQUIRE(
+      preprocess("#if (-1 >> 1) < 0 && -1u >> 63 == 1\nyes\n#endif\n")
+      == "yes\n"
+    );
+    REQUIRE(preprocess("#if (1 ? -1 : 0u) > 0\nyes\n#endif\n") == "yes\n");
+  }
+}
+
+TEST_CASE("preprocessor includes files")
+{
+  auto const directory{ std::filesystem::temp_directory_path()
+                        / "sc2_preprocessor_tests" };
+  std::filesystem::create_directories(directory / "include");
+  {
+    std::ofstream out{ directory / "guarded.h" };
+    out << "/* leading comment */\n"
+           "#ifndef GUARDED_H\n"
+           "#define GUARDED_H\n"
+           "int guarded;\n"
+           "#endif\n";
+  }
+  {
+    std::ofstream out{ directory / "include" / "once.h" };
+    out << "#pragma once\n"
+           "int once;\n";
+  }
+  {
+    std::ofstream out{ directory / "program.c" };
+    out << "#include \"guarded.h\"\n"
+           "#include \"guarded.h\"\n"
+           "#include <once.h>\n"
+           "#include <once.h>\n"
+           "int main(void) { return 0; }\n";
+  }
+  SC2::Preprocessor preprocessor{ { directory / "include" } };
+  REQUIRE(
+    preprocessor.preprocessFile(directory / "program.c")
+    == "int guarded;\n"
+       "int once;\n"
+       "int main(void) { return 0; }\n"
+  );
+
+  SECTION("a file with an include guard is read once")
+  {
+    REQUIRE(preprocessor.getReadFileCount() == 3);
+  }
+
+  SECTION("macros defined as if by -D are visible to the source")
+  {
+    preprocessor.defineMacro("SCALE(x)", "((x) * 3)");
+    REQUIRE(
+      preprocessor.preprocess("int a = SCALE(2);\n", directory / "other.c")
+      == "int a = ((2) * 3);\n"
+    );
+  }
+
+  std::filesystem::remove_all(directory);
+}
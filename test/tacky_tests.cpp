@@ -8,6 +8,8 @@
 
 #include <memory>
 
+// Lowering ends every function with the implicit return 0 of C, so every
+// expected dump ends with Return(LiteralConstant(0)).
 TEST_CASE("tacky emitter behaves correctly")
 {
   SECTION("Chapter 2: a basic program is correctly translated")
@@ -30,6 +32,7 @@ TEST_CASE("tacky emitter behaves correctly")
       "  Unary(Complement, LiteralConstant(2), Variable(\"main.0\"))\n"
       "  Unary(Negate, Variable(\"main.0\"), Variable(\"main.1\"))\n"
       "  Return(Variable(\"main.1\"))\n"
+      "  Return(LiteralConstant(0))\n"
     );
     constexpr char const * const program_text_one{
       "int main(void) {\n"
@@ -46,8 +49,9 @@ TEST_CASE("tacky emitter behaves correctly")
     };
     REQUIRE(tacky_ast_one->prettyPrint() ==
       "Function: main\n"
-      "  Unary(Complement, LiteralConstant(12), Variable(\"main.2\"))\n"
-      "  Return(Variable(\"main.2\"))\n"
+      "  Unary(Complement, LiteralConstant(12), Variable(\"main.0\"))\n"
+      "  Return(Variable(\"main.0\"))\n"
+      "  Return(LiteralConstant(0))\n"
     );
   }
   SECTION("Chapter 3: a program with binary expressions is correctly translated"
@@ -68,9 +72,10 @@ TEST_CASE("tacky emitter behaves correctly")
     };
     REQUIRE(tacky_ast_zero->prettyPrint() ==
       "Function: main\n"
-      "  Unary(Complement, LiteralConstant(12), Variable(\"main.3\"))\n"
-      "  Binary(Multiply, Variable(\"main.3\"), LiteralConstant(4), Variable(\"main.4\"))\n"
-      "  Return(Variable(\"main.4\"))\n"
+      "  Unary(Complement, LiteralConstant(12), Variable(\"main.0\"))\n"
+      "  Binary(Multiply, Variable(\"main.0\"), LiteralConstant(4), Variable(\"main.1\"))\n"
+      "  Return(Variable(\"main.1\"))\n"
+      "  Return(LiteralConstant(0))\n"
     );
   }
   SECTION(
@@ -93,28 +98,29 @@ TEST_CASE("tacky emitter behaves correctly")
     };
     REQUIRE(tacky_ast_zero->prettyPrint() ==
       "Function: main\n"
-      "  Binary(LessThan, LiteralConstant(1), LiteralConstant(2), Variable(\"main.5\"))\n"
-      "  Binary(GreaterThan, LiteralConstant(3), LiteralConstant(4), Variable(\"main.6\"))\n"
-      "  Binary(NotEquals, Variable(\"main.5\"), Variable(\"main.6\"), Variable(\"main.7\"))\n"
-      "  JumpIfZero(Variable(\"main.7\"), main.8_false_label)\n"
-      "  Binary(LessThanOrEqualTo, LiteralConstant(5), LiteralConstant(6), Variable(\"main.9\"))\n"
-      "  Binary(GreaterThanOrEqualTo, LiteralConstant(7), LiteralConstant(8), Variable(\"main.10\"))\n"
-      "  Binary(Equals, Variable(\"main.9\"), Variable(\"main.10\"), Variable(\"main.11\"))\n"
-      "  JumpIfZero(Variable(\"main.11\"), main.8_false_label)\n"
-      "  Copy(LiteralConstant(1), Variable(\"main.12\"))\n"
-      "  Jump(main.13)\n"
-      "  Label(main.8_false_label)\n"
-      "  Copy(LiteralConstant(0), Variable(\"main.12\"))\n"
-      "  Label(main.13)\n"
-      "  JumpIfNotZero(Variable(\"main.12\"), main.14_false_label)\n"
-      "  Unary(Not, LiteralConstant(2), Variable(\"main.15\"))\n"
-      "  JumpIfNotZero(Variable(\"main.15\"), main.14_false_label)\n"
-      "  Copy(LiteralConstant(0), Variable(\"main.16\"))\n"
-      "  Jump(main.17)\n"
-      "  Label(main.14_false_label)\n"
-      "  Copy(LiteralConstant(1), Variable(\"main.16\"))\n"
-      "  Label(main.17)\n"
-      "  Return(Variable(\"main.16\"))\n"
+      "  Binary(LessThan, LiteralConstant(1), LiteralConstant(2), Variable(\"main.0\"))\n"
+      "  Binary(GreaterThan, LiteralConstant(3), LiteralConstant(4), Variable(\"main.1\"))\n"
+      "  Binary(NotEquals, Variable(\"main.0\"), Variable(\"main.1\"), Variable(\"main.2\"))\n"
+      "  JumpIfZero(Variable(\"main.2\"), main.0_false_label)\n"
+      "  Binary(LessThanOrEqualTo, LiteralConstant(5), LiteralConstant(6), Variable(\"main.3\"))\n"
+      "  Binary(GreaterThanOrEqualTo, LiteralConstant(7), LiteralConstant(8), Variable(\"main.4\"))\n"
+      "  Binary(Equals, Variable(\"main.3\"), Variable(\"main.4\"), Variable(\"main.5\"))\n"
+      "  JumpIfZero(Variable(\"main.5\"), main.0_false_label)\n"
+      "  Copy(LiteralConstant(1), Variable(\"main.6\"))\n"
+      "  Jump(main.1)\n"
+      "  Label(main.0_false_label)\n"
+      "  Copy(LiteralConstant(0), Variable(\"main.6\"))\n"
+      "  Label(main.1)\n"
+      "  JumpIfNotZero(Variable(\"main.6\"), main.2_false_label)\n"
+      "  Unary(Not, LiteralConstant(2), Variable(\"main.7\"))\n"
+      "  JumpIfNotZero(Variable(\"main.7\"), main.2_false_label)\n"
+      "  Copy(LiteralConstant(0), Variable(\"main.8\"))\n"
+      "  Jump(main.3)\n"
+      "  Label(main.2_false_label)\n"
+      "  Copy(LiteralConstant(1), Variable(\"main.8\"))\n"
+      "  Label(main.3)\n"
+      "  Return(Variable(\"main.8\"))\n"
+      "  Return(LiteralConstant(0))\n"
     );
   }
 }